@@ -31,6 +31,7 @@
 #include "cangjie/AST/Comment.h"
 #include "cangjie/AST/Identifier.h"
 #include "cangjie/AST/IntLiteral.h"
+#include "cangjie/AST/NodeAllocator.h"
 #include "cangjie/AST/Types.h"
 #include "cangjie/Basic/Linkage.h"
 #include "cangjie/Basic/Position.h"
@@ -181,6 +182,14 @@ struct Node {
     {
     }
     virtual ~Node();
+    static void* operator new(size_t size)
+    {
+        return NodeAllocator::Allocate(size);
+    }
+    static void operator delete(void* ptr, size_t size) noexcept
+    {
+        NodeAllocator::Deallocate(ptr, size);
+    }
     virtual std::string ToString() const
     {
         return "";
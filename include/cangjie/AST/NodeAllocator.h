@@ -0,0 +1,58 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+// The Cangjie API is in Beta. For details on its capabilities and limitations, please refer to the README file.
+
+/**
+ * @file
+ *
+ * This file declares the allocator of AST nodes.
+ */
+
+#ifndef CANGJIE_AST_NODEALLOCATOR_H
+#define CANGJIE_AST_NODEALLOCATOR_H
+
+#include <cstddef>
+
+// Under AddressSanitizer nodes come from the global operator new, so that uses of freed nodes are still reported.
+#if defined(__SANITIZE_ADDRESS__)
+#define CANGJIE_AST_NODE_POOL_DISABLED
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define CANGJIE_AST_NODE_POOL_DISABLED
+#endif
+#endif
+
+namespace Cangjie::AST {
+/**
+ * Allocates the memory of AST nodes, which are created and destroyed by the million while parsing, cloning generic
+ * declarations, expanding macros and loading imported packages.
+ *
+ * Nodes are carved from slabs shared by all nodes of the same size class, so that creating a node is a pop from a
+ * free list and nodes created together are close in memory. Freed nodes are pushed back to the free list of the
+ * freeing thread and reused by the next node of the same size class. Surplus free nodes of a thread move to a shared
+ * depot, from which other threads refill.
+ *
+ * The free nodes of a thread move to the depot when the thread exits. Slabs are only returned to the system by
+ * @ref Trim, which the compiler instance calls once its AST is freed; otherwise the memory of a freed AST is reused by
+ * the next AST, e.g. when the LSP parses a file again. Nodes larger than the largest size class are allocated by the
+ * global operator new.
+ */
+class NodeAllocator {
+public:
+    static void* Allocate(size_t size);
+    static void Deallocate(void* ptr, size_t size) noexcept;
+    /**
+     * Moves the free nodes of the calling thread to the depot and returns the slabs whose nodes are all in the depot
+     * to the system. Free nodes cached by other threads keep their slabs alive.
+     *
+     * @return the number of bytes returned to the system.
+     */
+    static size_t Trim();
+};
+} // namespace Cangjie::AST
+
+#endif
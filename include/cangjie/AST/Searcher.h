@@ -220,38 +220,48 @@ public:
     }
 
 private:
+    /**
+     * Symbol ids of a partial search result, sorted by address and without duplicates, so that the set operations
+     * of a query are linear merges of contiguous arrays.
+     */
+    using SymbolIDs = std::vector<AST::Symbol*>;
+
     unsigned long StrToUint(const ASTContext& ctx, const std::string& queryVal) const;
     // Get the IDS of symbols in symbol tables whose position equal to the given @p pos.
-    std::set<AST::Symbol*> GetIDsByPosEQ(
+    SymbolIDs GetIDsByPosEQ(
         const ASTContext& ctx, const Position& pos, bool isLeftClose = true, bool isRightClose = true) const;
     // Get the IDS of symbols in symbol tables whose position is less than the given @p pos. If @contain is true, also
     // return the symbols contain the @p pos.
-    std::set<AST::Symbol*> GetIDsByPosLT(const ASTContext& ctx, const Position& pos, bool contain = false) const;
+    SymbolIDs GetIDsByPosLT(const ASTContext& ctx, const Position& pos, bool contain = false) const;
     // Get the IDS of symbols in symbol tables whose position is greater than the given @p pos. If @contain is true,
     // also return the symbols contain the @p pos.
-    std::set<AST::Symbol*> GetIDsByPosGT(const ASTContext& ctx, const Position& pos, bool contain = false) const;
-    std::set<AST::Symbol*> GetIDsByName(const ASTContext& ctx, const std::string& name) const;
-    std::set<AST::Symbol*> GetIDsByNamePrefix(const ASTContext& ctx, const std::string& prefix) const;
-    std::set<AST::Symbol*> GetIDsByNameSuffix(const ASTContext& ctx, const std::string& suffix) const;
-    std::set<AST::Symbol*> GetIDsByScopeName(const ASTContext& ctx, const std::string& scopeName) const;
-    std::set<AST::Symbol*> GetIDsByScopeLevel(const ASTContext& ctx, uint32_t scopeLevel) const;
-    std::set<AST::Symbol*> GetIDsByASTKind(const ASTContext& ctx, const std::string& astKind) const;
+    SymbolIDs GetIDsByPosGT(const ASTContext& ctx, const Position& pos, bool contain = false) const;
+    SymbolIDs GetIDsByName(const ASTContext& ctx, const std::string& name) const;
+    SymbolIDs GetIDsByNames(const ASTContext& ctx, const std::vector<std::string>& names) const;
+    SymbolIDs GetIDsByScopeName(const ASTContext& ctx, const std::string& scopeName) const;
+    SymbolIDs GetIDsByScopeLevel(const ASTContext& ctx, uint32_t scopeLevel) const;
+    SymbolIDs GetIDsByASTKind(const ASTContext& ctx, const std::string& astKind) const;
     std::vector<std::string> GetAstKindsBySuffix(const ASTContext& ctx, const std::string& suffix) const;
-    std::set<AST::Symbol*> PerformSearch(const ASTContext& ctx, const Query& query);
-    std::set<AST::Symbol*> GetIDs(const ASTContext& ctx, const Query& query) const;
-    std::set<AST::Symbol*> GetIDsByPos(const ASTContext& ctx, const Query& query) const;
-    std::set<AST::Symbol*> GetIDsByName(const ASTContext& ctx, const Query& query) const;
-    std::set<AST::Symbol*> GetIDsByScopeLevel(const ASTContext& ctx, const Query& query) const;
-    std::set<AST::Symbol*> GetIDsByScopeName(const ASTContext& ctx, const Query& query) const;
-    std::set<AST::Symbol*> GetIDsByASTKind(const ASTContext& ctx, const Query& query) const;
-    static std::set<AST::Symbol*> Intersection(const std::set<AST::Symbol*>& set1, const std::set<AST::Symbol*>& set2);
-    static std::set<AST::Symbol*> Union(const std::set<AST::Symbol*>& set1, const std::set<AST::Symbol*>& set2);
-    std::set<AST::Symbol*> Difference(const std::set<AST::Symbol*>& set1, const std::set<AST::Symbol*>& set2) const;
+    SymbolIDs PerformSearch(const ASTContext& ctx, const Query& query);
+    SymbolIDs GetIDs(const ASTContext& ctx, const Query& query) const;
+    SymbolIDs GetIDsByPos(const ASTContext& ctx, const Query& query) const;
+    SymbolIDs GetIDsByName(const ASTContext& ctx, const Query& query) const;
+    SymbolIDs GetIDsByScopeLevel(const ASTContext& ctx, const Query& query) const;
+    SymbolIDs GetIDsByScopeName(const ASTContext& ctx, const Query& query) const;
+    SymbolIDs GetIDsByASTKind(const ASTContext& ctx, const Query& query) const;
+    static SymbolIDs Intersection(const SymbolIDs& set1, const SymbolIDs& set2);
+    static SymbolIDs Union(const SymbolIDs& set1, const SymbolIDs& set2);
+    static SymbolIDs Difference(const SymbolIDs& set1, const SymbolIDs& set2);
+    /**
+     * Union of many postings at once: appending all ids and sorting them once is O(n log n) in the total size,
+     * while a union per posting copies the growing result again and again.
+     */
+    static SymbolIDs UnionAll(const std::vector<const std::set<AST::Symbol*>*>& postings);
     bool InFiles(const std::unordered_set<uint64_t>& files, const AST::Symbol& id) const;
     std::pair<std::vector<AST::Symbol*>, bool> FindInSearchCache(
         const Query& query, const std::string& normalizedQuery);
     std::vector<AST::Symbol*> FilterAndSortSearchResult(
-        const std::set<AST::Symbol*>& ids, const Query& query, const Order& order) const;
+        const SymbolIDs& ids, const Query& query, const Order& order) const;
     std::unordered_map<std::string, std::vector<AST::Symbol*>> cache;
     friend class PosSearchApi;
 };
@@ -144,6 +144,18 @@ public:
      */
     unsigned int AddSource(const std::string& path, const std::string& buffer,
         std::optional<std::string> packageName = std::nullopt);
+    /**
+     * Register a source whose content is not available yet, so that file ids can be assigned in a stable order
+     * before the files are read. The content is provided later by \ref SetSourceBuffer.
+     * @param path File path.
+     * @return The file id of the source, the existing one if the path has already been added.
+     */
+    unsigned int ReserveSource(const std::string& path, std::optional<std::string> packageName = std::nullopt);
+    /**
+     * Set the content of a source registered by \ref ReserveSource, the buffer is taken over without a copy.
+     * Calls for different file ids may run concurrently, as long as no source is added at the same time.
+     */
+    void SetSourceBuffer(unsigned int fileID, std::string&& buffer);
     /**
      * Add source to SourceManager. Package name default to null.
      */
@@ -0,0 +1,76 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+// The Cangjie API is in Beta. For details on its capabilities and limitations, please refer to the README file.
+
+#ifndef CANGJIE_CHIR_ANALYSIS_ANALYSISMANAGER_H
+#define CANGJIE_CHIR_ANALYSIS_ANALYSISMANAGER_H
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "cangjie/CHIR/Value.h"
+
+namespace Cangjie::CHIR {
+/**
+ * @brief interface of the per-function results kept by an analysis, see AnalysisWrapper.
+ */
+class AnalysisResultCache {
+public:
+    virtual ~AnalysisResultCache() = default;
+
+    /**
+     * @brief clear analysis result
+     */
+    virtual void InvalidateAllAnalysisResults() = 0;
+
+    /**
+     * @brief clear analysis result of certain function
+     * @param func function to clear analysis result
+     * @return whether clear is happened
+     */
+    virtual bool InvalidateAnalysisResult(const Func* func) = 0;
+};
+
+/**
+ * @brief Records the functions changed by transformations, so that cached analysis results of all other functions
+ * can be reused when an analysis runs again.
+ *
+ * Transformations mark the functions they changed. Before an analysis reuses its cached results, it is synchronized
+ * with the manager, which invalidates the results of the functions changed since its last synchronization.
+ * Transformations which do not know which functions they changed must mark all functions as changed, unless they
+ * preserve all analysis results, e.g. removing unreachable blocks does not change the states of reachable ones.
+ */
+class AnalysisManager {
+public:
+    /**
+     * @brief mark a function as changed, may be called concurrently.
+     * @param func the changed function.
+     */
+    void MarkChanged(const Func& func);
+
+    /**
+     * @brief mark all functions as changed.
+     */
+    void MarkAllChanged();
+
+    /**
+     * @brief invalidate the results of @p cache for the functions changed since its last synchronization.
+     * @param cache the results of an analysis.
+     */
+    void Synchronize(AnalysisResultCache& cache);
+
+private:
+    std::mutex mtx;
+    // Changed functions in the order they are marked, nullptr marks all functions.
+    std::vector<const Func*> changeLog;
+    // The length of changeLog at the last synchronization of each cache.
+    std::unordered_map<const AnalysisResultCache*, size_t> syncedLength;
+};
+} // namespace Cangjie::CHIR
+
+#endif
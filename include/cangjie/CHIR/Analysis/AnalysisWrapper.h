@@ -9,8 +9,10 @@
 #ifndef CANGJIE_CHIR_ANALYSIS_ANALYSISWRAPPER_H
 #define CANGJIE_CHIR_ANALYSIS_ANALYSISWRAPPER_H
 
+#include "cangjie/CHIR/Analysis/AnalysisManager.h"
 #include "cangjie/CHIR/Analysis/Engine.h"
 #include "cangjie/CHIR/Package.h"
+#include "cangjie/Utils/ProfileRecorder.h"
 #include "cangjie/Utils/TaskQueue.h"
 
 #include <future>
@@ -25,14 +27,22 @@ template <typename T> struct IsValueAnalysis<T, std::void_t<typename T::isValueA
 
 /**
  * @brief wrapper class of analysis pass, using to do parallel or check works.
+ * The result of a function is kept until it is invalidated, e.g. by AnalysisManager::Synchronize, and running the
+ * analysis on a package again only analyses the functions without a result.
  * @tparam TAnalysis analysis to wrapper.
  * @tparam TDomain domain of analysis.
  */
 template <typename TAnalysis, typename TDomain,
     typename = std::enable_if_t<std::is_base_of_v<AbstractDomain<TDomain>, TDomain>>,
     typename = std::enable_if_t<std::is_base_of_v<Analysis<TDomain>, TAnalysis>>>
-class AnalysisWrapper {
+class AnalysisWrapper : public AnalysisResultCache {
 public:
+    /// Number of functions whose cached result was reused or which had to be analysed.
+    struct CacheStats {
+        size_t hits{0};
+        size_t misses{0};
+    };
+
     /**
      * @brief abstract class for CHIR analysis wrapper.
      * @param builder CHIR builder for generating IR.
@@ -92,7 +102,7 @@ public:
     /**
      * @brief clear analysis result
      */
-    void InvalidateAllAnalysisResults()
+    void InvalidateAllAnalysisResults() override
     {
         resultsMap.clear();
     }
@@ -102,7 +112,7 @@ public:
      * @param func function to clear analysis result
      * @return whether clear is happened
      */
-    bool InvalidateAnalysisResult(const Func* func)
+    bool InvalidateAnalysisResult(const Func* func) override
     {
         if (auto it = resultsMap.find(func); it != resultsMap.end()) {
             resultsMap.erase(it);
@@ -112,6 +122,25 @@ public:
         }
     }
 
+    /**
+     * @brief return the number of cache hits and misses of all runs on packages
+     */
+    const CacheStats& GetCacheStats() const
+    {
+        return cacheStats;
+    }
+
+    /**
+     * @brief record the cache statistics in the profile
+     * @param name name of the analysis
+     */
+    void RecordCacheStats(const std::string& name) const
+    {
+        Utils::ProfileRecorder::RecordCodeInfo(name + " analysis cache hits", static_cast<int64_t>(cacheStats.hits));
+        Utils::ProfileRecorder::RecordCodeInfo(
+            name + " analysis cache misses", static_cast<int64_t>(cacheStats.misses));
+    }
+
 private:
     template <typename... Args>
     void RunOnPackageInSerial(const Package* package, bool isDebug, Args&&... args)
@@ -157,12 +186,15 @@ private:
 
     bool ShouldBeAnalysed(const Func& func)
     {
-        if constexpr (IsValueAnalysis<TAnalysis>::value) {
-            if (resultsMap.find(&func) != resultsMap.end()) {
-                return false;
-            }
+        if (!TAnalysis::Filter(func)) {
+            return false;
+        }
+        if (resultsMap.find(&func) != resultsMap.end()) {
+            ++cacheStats.hits;
+            return false;
         }
-        return TAnalysis::Filter(func);
+        ++cacheStats.misses;
+        return true;
     }
 
     template <typename... Args> void SetUpGlobalVarState(const Package& package, bool isDebug, Args&&... args)
@@ -180,6 +212,7 @@ private:
 
     std::unordered_map<const Func*, std::unique_ptr<Results<TDomain>>> resultsMap;
     CHIRBuilder& builder;
+    CacheStats cacheStats;
 };
 
 } // namespace Cangjie::CHIR
@@ -72,9 +72,15 @@ public:
 
         explicit Edge(Node* n, Kind k);
 
-        inline Node* GetNode() const;
+        Node* GetNode() const
+        {
+            return edgeValue.first;
+        }
 
-        inline Kind GetKind() const;
+        Kind GetKind() const
+        {
+            return edgeValue.second;
+        }
 
         bool operator==(const Edge& other) const;
 
@@ -142,6 +148,12 @@ public:
     /// This list is formed the first time we walk the graph.
     std::vector<Func*> postOrderSCCFunctionlist;
 
+    /// The same SCCs as postOrderSCCFunctionlist, one vector of functions per SCC, without the null nodes.
+    std::vector<std::vector<Func*>> postOrderSCCs;
+
+    /// The functions called directly by each function in postOrderSCCs, in the order of the calls.
+    std::unordered_map<const Func*, std::vector<Func*>> directCallees;
+
 private:
     const Package* package;
     DevirtualizationInfo& devirtFuncInfo;
@@ -149,6 +161,9 @@ private:
     /// Build the SCCs for Call Graph.
     void BuildSCC(const CallGraph& callGraph);
 
+    /// Record the direct callees of the function of @p node in directCallees.
+    void CollectDirectCallees(const CallGraph::Node& node);
+
     /// Print the Call Graph for debug.
     void PrintCallGraph(const CallGraph& callGraph) const;
 
@@ -0,0 +1,70 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+// The Cangjie API is in Beta. For details on its capabilities and limitations, please refer to the README file.
+
+#ifndef CANGJIE_CHIR_ANALYSIS_ESCAPE_ANALYSIS_H
+#define CANGJIE_CHIR_ANALYSIS_ESCAPE_ANALYSIS_H
+
+#include <unordered_map>
+#include <vector>
+
+#include "cangjie/CHIR/Analysis/CallGraphAnalysis.h"
+#include "cangjie/CHIR/Package.h"
+#include "cangjie/CHIR/Value.h"
+
+namespace Cangjie::CHIR {
+/**
+ * Interprocedural escape analysis of references.
+ *
+ * A reference escapes its function if the memory it points to may still be reachable after the function returns,
+ * i.e. the reference is stored into memory, returned, converted, boxed, used in a lambda, or passed to a callee
+ * which lets the corresponding parameter escape. A reference derived from it by GetElementRef escapes with it.
+ *
+ * Whether each parameter of a function escapes is summarized once for all call sites. Callees are summarized before
+ * their callers, in the post order of the SCCs of the call graph; the functions of a recursive SCC start from the
+ * assumption that no parameter escapes and are summarized again until the summaries no longer change.
+ */
+class EscapeAnalysis {
+public:
+    /**
+     * @brief Summarize the parameters of all functions of @p package.
+     * @param package package to analyse.
+     * @param callGraph the call graph of @p package, only used during the analysis.
+     */
+    void RunOnPackage(const Package& package, const CallGraphAnalysis& callGraph);
+
+    /**
+     * @brief Whether the parameter @p index of @p func may escape, true for functions without summary.
+     */
+    bool IsParamEscaping(const Func& func, size_t index) const;
+
+    /**
+     * @brief Whether the reference @p ref, a local variable or parameter, may escape its function.
+     */
+    bool IsEscaping(const Value& ref) const;
+
+    /**
+     * @brief Whether the reference @p ref may escape through the Apply or ApplyWithException @p call, i.e. it is the
+     * callee, the callee is not a function, or it is passed to an escaping parameter.
+     */
+    bool IsEscapingThroughCall(const Expression& call, const Value& ref) const;
+
+    /**
+     * @brief The number of summarized parameters which do not escape, for debugging.
+     */
+    size_t GetNonEscapingParamNum() const;
+
+private:
+    /** Summarizes the parameters of @p func, returns whether the summary changed. */
+    bool Summarize(const Func& func);
+
+    // Whether each parameter of a function escapes, in the order of the parameters.
+    std::unordered_map<const Func*, std::vector<bool>> paramEscapes;
+};
+} // namespace Cangjie::CHIR
+
+#endif
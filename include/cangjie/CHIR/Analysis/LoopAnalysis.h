@@ -0,0 +1,105 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+// The Cangjie API is in Beta. For details on its capabilities and limitations, please refer to the README file.
+
+#ifndef CANGJIE_CHIR_ANALYSIS_LOOP_ANALYSIS_H
+#define CANGJIE_CHIR_ANALYSIS_LOOP_ANALYSIS_H
+
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "cangjie/CHIR/Value.h"
+
+namespace Cangjie::CHIR {
+/**
+ * The dominator tree of the blocks of a BlockGroup, which are reachable from its entry block.
+ * Nested BlockGroups, e.g. the bodies of lambdas, are not part of the tree.
+ */
+class DominatorTree {
+public:
+    explicit DominatorTree(const BlockGroup& blockGroup);
+
+    /**
+     * @brief The reachable blocks in reverse post order, every block comes after its dominators.
+     */
+    const std::vector<Block*>& GetReversePostOrder() const
+    {
+        return rpo;
+    }
+
+    bool IsReachable(const Block& block) const;
+
+    /**
+     * @brief The immediate dominator of @p block, nullptr for the entry block and unreachable blocks.
+     */
+    Block* GetIDom(const Block& block) const;
+
+    /**
+     * @brief Whether @p a dominates @p b, every block dominates itself.
+     */
+    bool Dominates(const Block& a, const Block& b) const;
+
+private:
+    std::vector<Block*> rpo;
+    std::unordered_map<const Block*, size_t> rpoIndex;
+    // The immediate dominator of each block, by index in rpo; the entry block is its own immediate dominator.
+    std::vector<size_t> idoms;
+};
+
+/**
+ * A natural loop: the header and the blocks which reach a back edge to the header without passing the header.
+ */
+struct NaturalLoop {
+    Block* header{nullptr};
+    /** The blocks of the loop, including the blocks of nested loops. */
+    std::unordered_set<const Block*> blocks;
+    /** The sources of the back edges to the header. */
+    std::vector<Block*> latches;
+    NaturalLoop* parent{nullptr};
+    std::vector<NaturalLoop*> subLoops;
+
+    bool Contains(const Block& block) const
+    {
+        return blocks.count(&block) != 0;
+    }
+
+    /**
+     * @brief The unique predecessor of the header outside the loop, if its only successor is the header.
+     */
+    Block* GetPreheader() const;
+};
+
+/**
+ * The natural loops of a BlockGroup, computed from the back edges of its DominatorTree. Loops with the same header
+ * are merged, and loops are nested by inclusion.
+ */
+class LoopForest {
+public:
+    explicit LoopForest(const DominatorTree& domTree);
+
+    /**
+     * @brief All loops, every loop comes before the loops containing it.
+     */
+    const std::vector<std::unique_ptr<NaturalLoop>>& GetLoops() const
+    {
+        return loops;
+    }
+
+    /**
+     * @brief The innermost loop containing @p block, nullptr if the block is in no loop.
+     */
+    NaturalLoop* GetLoopFor(const Block& block) const;
+
+private:
+    std::vector<std::unique_ptr<NaturalLoop>> loops;
+    std::unordered_map<const Block*, NaturalLoop*> innermostLoops;
+};
+} // namespace Cangjie::CHIR
+
+#endif
@@ -0,0 +1,78 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+// The Cangjie API is in Beta. For details on its capabilities and limitations, please refer to the README file.
+
+/**
+ * @file
+ *
+ * This file declares the instrumentation profile consumed by CHIR optimizations.
+ */
+
+#ifndef CANGJIE_CHIR_ANALYSIS_PGO_PROFILE_H
+#define CANGJIE_CHIR_ANALYSIS_PGO_PROFILE_H
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <unordered_map>
+
+#include "cangjie/CHIR/Value.h"
+
+namespace Cangjie::CHIR {
+/**
+ * The instrumentation profile of `--pgo-instr-use`, keyed by the names of the functions in the generated code.
+ *
+ * The counters of the profile belong to the instrumented LLVM IR, so they cannot be mapped back to single CHIR
+ * expressions. CHIR uses the hotness of whole functions, and the targets of the indirect calls of each function.
+ */
+class PGOProfile {
+public:
+    struct FuncProfile {
+        /** The count of the hottest instrumented block of the function. */
+        uint64_t maxCount{0};
+        /** The call counts of the targets of all indirect calls in the function, by target name. */
+        std::unordered_map<std::string, uint64_t> callTargets;
+    };
+
+    /**
+     * @brief Add the profile of a function, the profiles of functions with the same name are merged.
+     * @param name the profile name of the function, local functions are prefixed by their file name and ';'.
+     */
+    void AddFuncProfile(const std::string& name, const FuncProfile& profile);
+
+    /**
+     * @brief Functions whose hottest block reaches @p threshold are hot, see llvm::ProfileSummaryBuilder.
+     */
+    void SetHotCountThreshold(uint64_t threshold)
+    {
+        hotCountThreshold = threshold;
+    }
+
+    const FuncProfile* GetFuncProfile(const FuncBase& func) const;
+
+    /**
+     * @brief Whether @p func is hot in the profile.
+     */
+    bool IsHot(const FuncBase& func) const;
+
+    /**
+     * @brief Whether @p func is in the profile but has never been executed.
+     */
+    bool IsCold(const FuncBase& func) const;
+
+    size_t GetFuncNum() const
+    {
+        return funcProfiles.size();
+    }
+
+private:
+    std::unordered_map<std::string, FuncProfile> funcProfiles;
+    uint64_t hotCountThreshold{std::numeric_limits<uint64_t>::max()};
+};
+} // namespace Cangjie::CHIR
+
+#endif
@@ -16,6 +16,9 @@
 #define CANGJIE_CHIR_CHIR_H
 
 #include "cangjie/CHIR/AST2CHIR/AST2CHIR.h"
+#include "cangjie/CHIR/Analysis/AnalysisManager.h"
+#include "cangjie/CHIR/Analysis/EscapeAnalysis.h"
+#include "cangjie/CHIR/Analysis/PGOProfile.h"
 #include "cangjie/CHIR/Analysis/ValueRangeAnalysis.h"
 #include "cangjie/CHIR/CHIRBuilder.h"
 #include "cangjie/CHIR/DiagAdapter.h"
@@ -144,6 +147,10 @@ private:
     void UselessFuncElimination();
     void RedundantLoadElimination();
     void UselessAllocateElimination();
+    EscapeAnalysis RunEscapeAnalysis(DevirtualizationInfo& devirtInfo);
+    void RunNonEscapingAllocateElimination(const EscapeAnalysis& escapeAnalysis);
+    void RunScalarReplacementOfAggregates();
+    void RunLoopInvariantCodeMotion(const EscapeAnalysis& escapeAnalysis);
     void RunGetRefToArrayElemOpt();
     void RedundantGetOrThrowElimination();
     void FlatForInExpr();
@@ -157,6 +164,7 @@ private:
     bool RunNativeFFIChecks();
     void RunArrayListConstStartOpt();
     void RunFunctionInline(DevirtualizationInfo& devirtInfo);
+    const PGOProfile* GetPGOProfile() const;
     void RunArrayLambdaOpt();
     void RunRedundantFutureOpt();
     void RunNoSideEffectMarkerOpt();
@@ -171,8 +179,10 @@ private:
     void RecordCodeInfoAtTheBegin();
     void RecordCodeInfoAtTheEnd();
     void RecordCHIRExprNum(const std::string& suffix);
+    void RecordAnalysisCacheStats();
     bool RunAnalysisForCJLint();
     void RunConstantAnalysis();
+    void MarkChanged(const std::vector<const Func*>& funcs);
     // run semantic checks that have to be performed on CHIR
     bool RunAnnotationChecks();
     void EraseDebugExpr();
@@ -209,6 +219,9 @@ private:
     CHIRBuilder& builder;
     uint64_t debugFileIndex{0};
     AnalysisWrapper<ConstAnalysis, ConstDomain>& constAnalysisWrapper;
+    // Functions changed by transformations, whose analysis results must not be reused. Transformations which run
+    // before an analysis is run again must mark the functions they change.
+    AnalysisManager analysisManager;
     OptEffectCHIRMap effectMap;
     OptEffectStrMap strEffectMap;
     VirtualWrapperDepMap curVirtFuncWrapDep;
@@ -209,6 +209,11 @@ public:
         // Transitive closure of superclasses, required for instanceof
         std::set<ByteCodeContent> superClasses;
         VTable vtable;
+        // The dispatch layout of superClasses and vtable, see LayoutDispatchTables.
+        // Bit i is set iff class i is a superclass.
+        std::vector<uint64_t> superClassBits;
+        // (method id, func body index) sorted by method id
+        std::vector<std::pair<ByteCodeContent, ByteCodeIndex>> flatVTable;
         ByteCodeIndex finalizerIdx = 0; // func body index
         // Required to go from `ClassId` to CHIR `Class*` during constant evaluation.
         std::string mangledName;
@@ -296,6 +301,16 @@ public:
     void SetClassFinalizer(ByteCodeContent classId, ByteCodeIndex idx);
     ByteCodeIndex GetClassFinalizer(ByteCodeContent classId);
     const ClassTable& GetClassTable() const;
+    /** @brief Lay out the superclasses and the vtable of every class in flat arrays for the interpreter */
+    void LayoutDispatchTables();
+
+    /**
+     * @brief Add an INVOKE site calling method @p methodId, and return its index. In linked bytecode INVOKE refers to
+     * its site rather than directly to the method, so that the interpreter can attach an inline cache to every site.
+     */
+    ByteCodeContent AddInvokeSite(ByteCodeContent methodId);
+    ByteCodeContent GetInvokeSiteMethod(ByteCodeContent site) const;
+    size_t GetNumInvokeSites() const;
 
     /** @brief Instantiate important types and functions from core. To be used only when we don't want to link core. */
     void InstantiateDefaultCoreClassesAndFunctions();
@@ -344,6 +359,8 @@ private:
     Definition linkedByteCode;
     /** @brief class table after linking */
     ClassTable classTable;
+    /** @brief method id of every INVOKE site */
+    std::vector<ByteCodeContent> invokeSites;
     /** @brief all special function pointers
      *
      * Assumption: ByteCodeIndex == 0 means that the function does not exist in BCHIR
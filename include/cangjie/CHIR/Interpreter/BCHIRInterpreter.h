@@ -31,6 +31,7 @@
 #include "cangjie/CHIR/Interpreter/InterpreterStack.h"
 #include "cangjie/CHIR/Interpreter/InterpreterValueUtils.h"
 #include "cangjie/CHIR/OverflowChecking.h"
+#include <array>
 #include <cmath>
 #include <cstring>
 #include <fstream>
@@ -73,6 +74,7 @@ public:
           isConstEval(isConstEval),
           diag(diag)
     {
+        InitDispatchTables();
     }
 
     /** @brief runt the interpreter */
@@ -93,6 +95,9 @@ public:
     /** @brief returns the result of the previous run, or INotRun if interpreter never ran */
     const IResult& GetLastResult() const;
 
+    /** @brief print the statistics of the heap of the interpreter */
+    void PrintHeapStats() const;
+
     /** @brief the max size of the internal playground, the part of the bytecode
      * where this interpreter instance can generate code. */
     static const size_t INTERNAL_PLAYGROUND_SIZE = 20;
@@ -197,8 +202,22 @@ private:
     void InterpretReturn();
 
     IVal* AllocateValue(IVal&& value);
+    /** @brief Free the values of the arena which are no longer reachable. Must only be called between operations. */
+    void CollectGarbage();
 
     // Invoke support
+    /** @brief Polymorphic inline cache of an INVOKE site, the last receiver classes and the methods they dispatched to.
+     * Once full, the site is megamorphic and misses are looked up in the vtables. */
+    struct InlineCache {
+        static const size_t WAYS = 4;
+        std::array<std::pair<Bchir::ByteCodeContent, Bchir::ByteCodeIndex>, WAYS> entries;
+        size_t size{0};
+    };
+    /** @brief inline caches indexed by invoke site */
+    std::vector<InlineCache> inlineCaches;
+    /** @brief class infos indexed by class id */
+    std::vector<const Bchir::ClassInfo*> classes;
+    void InitDispatchTables();
     Bchir::ByteCodeIndex FindMethod(Bchir::ByteCodeContent classId, Bchir::ByteCodeContent nameId);
 
     // Switch support
@@ -75,6 +75,12 @@ private:
         const std::vector<Bchir::ByteCodeContent>& fileMap, const std::vector<Bchir::ByteCodeContent>& typeMap,
         const std::vector<Bchir::ByteCodeContent>& stringMap);
 
+    /**
+     * @brief Replace common pairs of operations in the linked bytecode by superinstructions. Only the opcode of the
+     * first operation is rewritten, so the linked bytecode keeps its layout and all jump targets stay valid.
+     */
+    void FuseSuperInstructions();
+
     void AddPosition(const std::unordered_map<Bchir::ByteCodeIndex, Bchir::CodePosition>& positions,
         const std::vector<Bchir::ByteCodeContent>& fileMap, Bchir::ByteCodeIndex curr);
     void AddMangledName(
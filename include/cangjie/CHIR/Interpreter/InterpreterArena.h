@@ -15,16 +15,34 @@
 #ifndef CANGJIE_CHIR_INTERRETER_INTERPREVERARENA_H
 #define CANGJIE_CHIR_INTERRETER_INTERPREVERARENA_H
 
+#include <unordered_set>
+
 #include "cangjie/CHIR/Interpreter/InterpreterValueUtils.h"
 
 namespace Cangjie::CHIR::Interpreter {
 
+/**
+ * Heap of the interpreter, with a tracing garbage collector.
+ *
+ * Values are never moved: a collection marks the values reachable from the roots given by the interpreter and
+ * frees all the other ones, whose slots are then reused by later allocations. Buckets left without any live value
+ * are released. Pointers may point inside a value (e.g. to a field of an object), such a pointer keeps alive the
+ * value that contains it.
+ *
+ * A collection may only run when no value of the arena is referenced from outside the roots, the interpreter
+ * therefore only collects between two operations.
+ */
 class Arena {
 public:
-    /* list of objects that needs to run finalizer on them */
+    /* list of objects that needs to run finalizer on them, these objects are never collected */
     std::vector<IVal*> finalizingObjects;
 
-    Arena()
+    /**
+     * @param minCollectionThreshold a collection is requested after allocating as many values as survived the
+     * previous collection, but never after less than this number of values.
+     */
+    explicit Arena(size_t minCollectionThreshold = DEFAULT_MIN_COLLECTION_THRESHOLD)
+        : minCollectionThreshold(minCollectionThreshold), collectionThreshold(minCollectionThreshold)
     {
         buckets.reserve(BUCKETS);
         buckets.emplace_back(std::make_unique<std::vector<IVal>>());
@@ -33,6 +51,13 @@ public:
     }
     IVal* Allocate(IVal&& value)
     {
+        ++allocatedSinceCollection;
+        if (!freeSlots.empty()) {
+            auto ptr = freeSlots.back();
+            freeSlots.pop_back();
+            *ptr = std::move(value);
+            return ptr;
+        }
         if (buckets.back()->size() == BUCKET_SIZE) {
             buckets.emplace_back(std::make_unique<std::vector<IVal>>());
             buckets.back()->reserve(BUCKET_SIZE);
@@ -43,21 +68,34 @@ public:
         return ptr;
     }
 
-    void PrintStats()
+    /** @brief whether enough values have been allocated since the last collection to run a new one */
+    bool ShouldCollect() const
     {
-        std::cout << "Number of buckets: " << buckets.size() << std::endl;
+        return allocatedSinceCollection >= collectionThreshold;
     }
 
-    int64_t GetAllocatedSize()
+    /** @brief start a collection, the roots must then be marked before finishing it */
+    void BeginCollection();
+    /** @brief mark all the values reachable from @p root as alive */
+    void MarkRoot(const IVal& root);
+    /** @brief mark all the values reachable from @p root as alive */
+    void MarkRoot(const IValStack& root);
+    /** @brief free all the values which have not been marked since the collection began */
+    void FinishCollection();
+
+    void PrintStats() const;
+
+    int64_t GetAllocatedSize() const
     {
         CJC_ASSERT(buckets.size() >= 1);
-        size_t r = ((buckets.size() - 1) * BUCKET_SIZE + buckets.back()->size()) * sizeof(IVal);
+        size_t r = ((buckets.size() - 1) * BUCKET_SIZE + buckets.back()->size() - freeSlots.size()) * sizeof(IVal);
         return static_cast<int64_t>(r);
     }
 
 private:
     static const size_t BUCKETS = 2048;
     static const size_t BUCKET_SIZE = 2048;
+    static const size_t DEFAULT_MIN_COLLECTION_THRESHOLD = 64 * BUCKET_SIZE;
 
     // Why unique_ptr? Because in C++ vector reallocation may either copy or move its contents.
     // It sohuld move if possible -- and it should be possible in this case.
@@ -67,6 +105,50 @@ private:
     // after profiling. T0D0!!
     using Bucket = std::unique_ptr<std::vector<IVal>>;
     std::vector<Bucket> buckets;
+    /** @brief slots of freed values, reused by Allocate */
+    std::vector<IVal*> freeSlots;
+
+    size_t minCollectionThreshold;
+    size_t collectionThreshold;
+    size_t allocatedSinceCollection{0};
+
+    // State of the current collection.
+    /** @brief mark bits of the slots, one vector per bucket */
+    std::vector<std::vector<uint8_t>> marks;
+    /** @brief the first slot of each bucket and the index of the bucket, sorted by address */
+    std::vector<std::pair<const IVal*, size_t>> bucketStarts;
+    /** @brief values whose content is still to be traced */
+    std::vector<const IVal*> worklist;
+    /** @brief pointers to values which are not slots of the arena, e.g. fields of objects */
+    std::unordered_set<const IVal*> interiorPointers;
+    /** @brief interior pointers whose owner has not been looked up yet */
+    std::vector<const IVal*> unresolvedInteriors;
+    /** @brief a content buffer of a tuple, array or object, with the slot which (transitively) owns it */
+    struct ContentRange {
+        const IVal* begin;
+        const IVal* end;
+        const IVal* owner;
+    };
+    /** @brief the content buffers of all slots sorted by address, built once per collection when first needed */
+    std::vector<ContentRange> contentRanges;
+    bool contentRangesBuilt{false};
+
+    struct Stats {
+        size_t collections{0};
+        size_t freedValues{0};
+        size_t releasedBuckets{0};
+        size_t maxLiveValues{0};
+    } stats;
+
+    bool MarkSlot(const IVal* ptr);
+    void Reach(const IVal* ptr);
+    void TraceContent(const IVal& value);
+    void Drain();
+    void AddContentRanges(const IVal& value, const IVal* owner);
+    void BuildContentRanges();
+    const IVal* FindOwner(const IVal* interior) const;
+    void MarkOwnersOfInteriorPointers();
+    void Sweep();
 };
 
 } // namespace Cangjie::CHIR::Interpreter
@@ -85,6 +85,16 @@ struct Env {
         return bp;
     }
 
+    const std::vector<IVal>& GetGlobals() const
+    {
+        return global;
+    }
+
+    const std::vector<IVal>& GetLocals() const
+    {
+        return local;
+    }
+
 private:
     size_t numberOfGlobals;
     /** @brief environment for global variables */
@@ -41,6 +41,9 @@ struct InterpreterStack {
         while (ArgsSize() > 0) {
             ArgsPopBack();
         }
+        for (auto content : contentPool) {
+            delete content;
+        }
     }
     InterpreterStack(InterpreterStack&) = delete;
     InterpreterStack& operator=(const InterpreterStack& other) = delete;
@@ -48,7 +51,7 @@ struct InterpreterStack {
     /**
      * @brief Consume an IValStack and transform it into an IVal
      **/
-    IVal ToIVal(IValStack&& n) const
+    IVal ToIVal(IValStack&& n)
     {
         return std::visit(
             [&](auto&& arg) -> IVal {
@@ -56,18 +59,18 @@ struct InterpreterStack {
                 if constexpr (std::is_same_v<T, ITuplePtr>) {
                     ITuple res;
                     std::swap(res.content, *arg.contentPtr);
-                    delete arg.contentPtr;
+                    DeleteContent(arg.contentPtr);
                     return res;
                 } else if constexpr (std::is_same_v<T, IArrayPtr>) {
                     IArray res;
                     std::swap(res.content, *arg.contentPtr);
-                    delete arg.contentPtr;
+                    DeleteContent(arg.contentPtr);
                     return res;
                 } else if constexpr (std::is_same_v<T, IObjectPtr>) {
                     IObject res;
                     std::swap(res.content, *arg.contentPtr);
                     res.classId = arg.classId;
-                    delete arg.contentPtr;
+                    DeleteContent(arg.contentPtr);
                     return res;
                 } else {
                     return arg;
@@ -79,23 +82,23 @@ struct InterpreterStack {
     /**
      * @brief Consume an IVal and transform it into an IValStack
      */
-    IValStack FromIVal(IVal&& n) const
+    IValStack FromIVal(IVal&& n)
     {
         return std::visit(
             [&](auto&& arg) -> IValStack {
                 using T = std::decay_t<decltype(arg)>;
                 if constexpr (std::is_same_v<T, ITuple>) {
-                    std::vector<IVal>* ptr = new std::vector<IVal>();
+                    std::vector<IVal>* ptr = NewContent();
                     std::swap(*ptr, arg.content);
                     ITuplePtr res{ptr};
                     return res;
                 } else if constexpr (std::is_same_v<T, IArray>) {
-                    std::vector<IVal>* ptr = new std::vector<IVal>();
+                    std::vector<IVal>* ptr = NewContent();
                     std::swap(*ptr, arg.content);
                     IArrayPtr res{ptr};
                     return res;
                 } else if constexpr (std::is_same_v<T, IObject>) {
-                    std::vector<IVal>* ptr = new std::vector<IVal>();
+                    std::vector<IVal>* ptr = NewContent();
                     std::swap(*ptr, arg.content);
                     IObjectPtr res{arg.classId, ptr};
                     return res;
@@ -122,18 +125,18 @@ struct InterpreterStack {
         if constexpr (std::is_same_v<S, ITuple>) {
             ITuple res;
             std::swap(res.content, *std::get<ITuplePtr>(arg).contentPtr);
-            delete std::get<ITuplePtr>(arg).contentPtr;
+            DeleteContent(std::get<ITuplePtr>(arg).contentPtr);
             return res;
         } else if constexpr (std::is_same_v<S, IArray>) {
             IArray res;
             std::swap(res.content, *std::get<IArrayPtr>(arg).contentPtr);
-            delete std::get<IArrayPtr>(arg).contentPtr;
+            DeleteContent(std::get<IArrayPtr>(arg).contentPtr);
             return res;
         } else if constexpr (std::is_same_v<S, IObject>) {
             IObject res;
             std::swap(res.content, *std::get<IObjectPtr>(arg).contentPtr);
             res.classId = std::get<IObjectPtr>(arg).classId;
-            delete std::get<IObjectPtr>(arg).contentPtr;
+            DeleteContent(std::get<IObjectPtr>(arg).contentPtr);
             return res;
         } else {
             return std::get<S>(arg);
@@ -167,12 +170,9 @@ struct InterpreterStack {
         std::visit(
             [&](auto& arg) {
                 using T = std::decay_t<decltype(arg)>;
-                if constexpr (std::is_same_v<T, ITuplePtr>) {
-                    delete arg.contentPtr;
-                } else if constexpr (std::is_same_v<T, IArrayPtr>) {
-                    delete arg.contentPtr;
-                } else if constexpr (std::is_same_v<T, IObjectPtr>) {
-                    delete arg.contentPtr;
+                if constexpr (std::is_same_v<T, ITuplePtr> || std::is_same_v<T, IArrayPtr> ||
+                    std::is_same_v<T, IObjectPtr>) {
+                    DeleteContent(arg.contentPtr);
                 }
             },
             argStack.back());
@@ -242,6 +242,20 @@ struct InterpreterStack {
         return ArgsGet(idx);
     }
 
+    /**
+     * @brief Get a reference to the index element from offsetFromEnd element from the top, without copying it
+     *
+     * The element must be of type T, which can't be an aggregate
+     */
+    template <typename T> const T& ArgsPeek(size_t offsetFromEnd, size_t index) const
+    {
+        static_assert(!std::is_same_v<T, ITuple> && !std::is_same_v<T, IArray> && !std::is_same_v<T, IObject>,
+            "ArgsPeek can't be used with aggregates");
+        auto idx = (argStack.size() - offsetFromEnd) + index;
+        CJC_ASSERT(idx < argStack.size());
+        return std::get<T>(argStack[idx]);
+    }
+
     /**
      * @brief Get the idx element from the bottom of the stack
      *
@@ -283,15 +297,15 @@ struct InterpreterStack {
         static_assert(!std::is_same_v<S, IVal>, "ArgsPush can't be used with IVal, only the internal values of IVal");
 
         if constexpr (std::is_same_v<S, ITuple>) {
-            ITuplePtr t{new std::vector<IVal>};
+            ITuplePtr t{NewContent()};
             std::swap(*t.contentPtr, node.content);
             (void)argStack.emplace_back(t);
         } else if constexpr (std::is_same_v<S, IArray>) {
-            IArrayPtr t{new std::vector<IVal>};
+            IArrayPtr t{NewContent()};
             std::swap(*t.contentPtr, node.content);
             (void)argStack.emplace_back(t);
         } else if constexpr (std::is_same_v<S, IObject>) {
-            IObjectPtr t{node.classId, new std::vector<IVal>};
+            IObjectPtr t{node.classId, NewContent()};
             std::swap(*t.contentPtr, node.content);
             (void)argStack.emplace_back(t);
         } else {
@@ -360,14 +374,54 @@ struct InterpreterStack {
         return controlStack;
     }
 
+    const std::vector<IValStack>& GetArgStack() const
+    {
+        return argStack;
+    }
+
     size_t CtrlSize() const
     {
         return controlStack.size();
     }
 
 private:
+    /** @brief the maximum number of content vectors kept for reuse */
+    const static size_t CONTENT_POOL_SIZE = 1024;
+
+    /**
+     * @brief Get an empty vector for the content of an aggregate pushed on the stack
+     *
+     * The vector objects of popped aggregates are reused, instead of allocating a new one for every push. Only the
+     * vector objects are reused, not their element buffers: a push swaps in the buffer of the pushed value and a pop
+     * swaps it out, so every aggregate still owns its own element buffer.
+     */
+    std::vector<IVal>* NewContent()
+    {
+        if (contentPool.empty()) {
+            return new std::vector<IVal>();
+        }
+        auto content = contentPool.back();
+        contentPool.pop_back();
+        return content;
+    }
+
+    /** @brief Release the content vector of an aggregate popped from the stack */
+    void DeleteContent(std::vector<IVal>* content)
+    {
+        if (contentPool.size() == CONTENT_POOL_SIZE) {
+            delete content;
+            return;
+        }
+        // Release the elements and the buffer of a discarded aggregate. Keeping the buffer would not save an
+        // allocation, since the next push swaps it out for the buffer of the pushed value.
+        std::vector<IVal>().swap(*content);
+        contentPool.emplace_back(content);
+    }
+
     /** @brief stack for arguments */
     std::vector<IValStack> argStack;
+    /** @brief empty content vectors to be reused by aggregates pushed on the stack */
+    std::vector<std::vector<IVal>*> contentPool;
     /** @brief stack for control flow */
     std::vector<ControlState> controlStack;
 };
@@ -0,0 +1,79 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+// The Cangjie API is in Beta. For details on its capabilities and limitations, please refer to the README file.
+
+/**
+ * @file
+ *
+ * This file declares the helpers for splitting an allocation into its elements, shared by the CHIR passes
+ * NonEscapingAllocateElimination and ScalarReplacementOfAggregates.
+ */
+
+#ifndef CANGJIE_CHIR_TRANSFORMATION_ALLOCATE_SPLITTER_H
+#define CANGJIE_CHIR_TRANSFORMATION_ALLOCATE_SPLITTER_H
+
+#include <unordered_map>
+
+#include "cangjie/CHIR/Analysis/EscapeAnalysis.h"
+#include "cangjie/CHIR/CHIRBuilder.h"
+
+namespace Cangjie::CHIR {
+/**
+ * @brief Whether the memory @p ref points to is only read and written in @p body, not in its nested BlockGroups.
+ * @param ref reference to an element of an allocation.
+ * @param body the body of the function of the allocation.
+ * @param escapeAnalysis if given, @p ref may also be passed to callees which do not let it escape.
+ */
+bool IsOnlyReadAndWritten(const Value& ref, const BlockGroup& body, const EscapeAnalysis* escapeAnalysis = nullptr);
+
+/**
+ * @brief Whether @p path is a valid element access of an aggregate with @p elementTys, which results in @p resultTy.
+ */
+bool IsElementPath(const std::vector<uint64_t>& path, const std::vector<Type*>& elementTys, const Type* resultTy);
+
+/**
+ * Replace an allocation by one local allocation per element, which are created before it on first use.
+ *
+ * The users of the allocation must have been checked by the pass: element accesses by GetElementRef and
+ * StoreElementRef, see IsElementPath, Stores of the whole aggregate, and Loads of the whole aggregate whose
+ * results are only used by Fields. Debug users are removed, so with -g the pass must not split an allocation which
+ * has any. Other users, which are dead, are removed too.
+ */
+class AllocateSplitter {
+public:
+    /**
+     * @param allocate the allocation to split.
+     * @param elementTys the types of the elements, e.g. the instantiated member variable types of a class.
+     * @param body the body of the function of the allocation, all users are in it.
+     * @param builder CHIR builder for creating the element allocations.
+     */
+    AllocateSplitter(
+        Allocate& allocate, std::vector<Type*> elementTys, const BlockGroup& body, CHIRBuilder& builder);
+
+    /**
+     * @brief Replaces the users of the allocation and removes it.
+     * @return the created element allocations, in the order of their first use.
+     */
+    std::vector<Allocate*> Run();
+
+private:
+    LocalVar* GetElementAlloc(uint64_t index);
+    void SplitGetElementRef(GetElementRef& user);
+    void SplitStoreElementRef(StoreElementRef& user);
+    void SplitStore(Store& user);
+    void SplitLoad(Load& user);
+
+    Allocate& allocate;
+    std::vector<Type*> elementTys;
+    const BlockGroup& body;
+    CHIRBuilder& builder;
+    std::unordered_map<uint64_t, LocalVar*> elementRefs;
+    std::vector<Allocate*> elementAllocs;
+};
+} // namespace Cangjie::CHIR
+
+#endif
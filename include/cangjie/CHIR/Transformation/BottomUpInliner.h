@@ -0,0 +1,104 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+// The Cangjie API is in Beta. For details on its capabilities and limitations, please refer to the README file.
+
+/**
+ * @file
+ *
+ * This file declares the BottomUpInliner class, which drives FunctionInline over the call graph of a package.
+ */
+
+#ifndef CANGJIE_CHIR_TRANSFORMATION_BOTTOM_UP_INLINER_H
+#define CANGJIE_CHIR_TRANSFORMATION_BOTTOM_UP_INLINER_H
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "cangjie/CHIR/Analysis/AnalysisManager.h"
+#include "cangjie/CHIR/Analysis/CallGraphAnalysis.h"
+#include "cangjie/CHIR/Transformation/FunctionInline.h"
+
+namespace Cangjie::CHIR {
+/**
+ * CHIR Opt Pass: inline the functions of a package bottom-up over the SCCs of its call graph.
+ *
+ * Every SCC is one level above the highest SCC it calls, so the SCCs of a level are inlined into concurrently while
+ * their callees are not changed any more. An SCC is simplified once inlining into it is done, and its callers use
+ * its size after simplification. The callees inlined into the package are limited by a budget relative to the size
+ * of the package, which every level splits among its SCCs.
+ */
+class BottomUpInliner {
+public:
+    /**
+     * @brief constructor for bottom-up inliner.
+     * @param builder CHIR builder of the package.
+     * @param opts global options, for the optimization level and the number of jobs.
+     * @param profile instrumentation profile to find hot and cold functions, maybe nullptr.
+     * @param analysisManager the manager to mark the functions inlined into in, maybe nullptr.
+     */
+    BottomUpInliner(CHIRBuilder& builder, const GlobalOptions& opts, const PGOProfile* profile,
+        AnalysisManager* analysisManager = nullptr);
+
+    /**
+     * @brief Main process to inline the functions of @p package.
+     * @param package package to do optimization.
+     * @param callGraph call graph analysis of @p package.
+     * @param recordRemarks flag whether record the inlining decisions, see GetRemarks.
+     */
+    void Run(const Package& package, const CallGraphAnalysis& callGraph, bool recordRemarks);
+
+    /**
+     * @brief Get effect map after this pass.
+     * @return effect map affected by this pass.
+     */
+    const OptEffectCHIRMap& GetEffectMap() const;
+
+    /**
+     * @brief Get the inlining decisions, in the order of the SCCs.
+     */
+    const std::vector<InlineRemark>& GetRemarks() const;
+
+    /**
+     * @brief Get the size of all callees inlined into the package.
+     */
+    size_t GetGrowth() const;
+
+    /**
+     * @brief Format @p remarks as JSON Lines, one object per decision.
+     */
+    static std::string RemarksToJsonLines(const std::vector<InlineRemark>& remarks);
+
+private:
+    struct SCCResult {
+        std::vector<std::pair<const Func*, size_t>> funcSizes;
+        size_t growth{0};
+        OptEffectCHIRMap effectMap;
+        std::vector<InlineRemark> remarks;
+    };
+
+    void RunOnLevel(const std::vector<const std::vector<Func*>*>& sccs, bool recordRemarks);
+    void RunOnSCC(const std::vector<Func*>& scc, CHIRBuilder& subBuilder, size_t budget, SCCResult& result,
+        bool recordRemarks) const;
+
+    CHIRBuilder& builder;
+    const GlobalOptions& opts;
+    const PGOProfile* profile;
+    AnalysisManager* analysisManager;
+    // the sizes of the functions in the finished levels, only read while a level is inlined
+    std::unordered_map<const Func*, size_t> funcSizes;
+    // the functions called at most once before inlining, the current users change concurrently
+    std::unordered_set<const Func*> calledOnceFuncs;
+    size_t remainingBudget{0};
+    size_t growth{0};
+    OptEffectCHIRMap effectMap;
+    std::vector<InlineRemark> remarks;
+};
+} // namespace Cangjie::CHIR
+
+#endif
@@ -11,6 +11,7 @@
 
 #include "cangjie/CHIR/CHIRBuilder.h"
 #include "cangjie/CHIR/Package.h"
+#include "cangjie/CHIR/Transformation/FunctionPassManager.h"
 #include "cangjie/Option/Option.h"
 
 namespace Cangjie::CHIR {
@@ -19,6 +20,9 @@ namespace Cangjie::CHIR {
  */
 class ClosureConversion {
 public:
+    // Closure conversion creates global functions and classes, and rewrites their users in every function.
+    static constexpr PassScope SCOPE = PassScope::MODULE;
+
     /**
      * @brief constructor to do closure conversion.
      * @param package input package to do closure conversion.
@@ -63,6 +63,12 @@ public:
      * @return functions
      */
     const std::vector<const Func*>& GetFuncsNeedRemoveBlocks() const;
+
+    /**
+     * @brief Get all funcs changed by this pass.
+     * @return functions
+     */
+    const std::vector<const Func*>& GetChangedFuncs() const;
 private:
     struct RewriteInfo {
         Expression* oldExpr;
@@ -102,7 +108,7 @@ private:
      *
      * note: `-(-a) != a` as there might be an overflow while calculating `(-a)`.
      */
-    void TrySimplifyingUnaryExpr(const Ptr<UnaryExpression>& unary, bool isDebug) const;
+    void TrySimplifyingUnaryExpr(const Ptr<UnaryExpression>& unary, bool isDebug);
 
     /**
      * This function will check if a binary expression can be simplified according to the rules
@@ -130,7 +136,7 @@ private:
      * This function will replaced all use of the result of the expression @p expr with the value
      * @p newVal. A debug message will also be printed if @p isDebug is true.
      */
-    void ReplaceUsageOfExprResult(const Ptr<const Expression>& expr, const Ptr<Value>& newVal, bool isDebug) const;
+    void ReplaceUsageOfExprResult(const Ptr<const Expression>& expr, const Ptr<Value>& newVal, bool isDebug);
 
     // ==================== Rewrite Terminator Expressions ==================== //
 
@@ -146,6 +152,9 @@ private:
     const GlobalOptions& opts;
     static OptEffectCHIRMap effectMap;
     std::vector<const Func*> funcsNeedRemoveBlocks;
+    std::vector<const Func*> changedFuncs;
+    // Whether the func being visited has been changed by simplifying expressions.
+    bool isSimplified{false};
 };
 
 } // namespace Cangjie::CHIR
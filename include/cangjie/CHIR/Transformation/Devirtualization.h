@@ -11,6 +11,7 @@
 
 #include "cangjie/CHIR/Analysis/AnalysisWrapper.h"
 #include "cangjie/CHIR/Analysis/DevirtualizationInfo.h"
+#include "cangjie/CHIR/Analysis/PGOProfile.h"
 #include "cangjie/CHIR/Analysis/TypeAnalysis.h"
 #include "cangjie/CHIR/Package.h"
 #include "cangjie/CHIR/Value.h"
@@ -41,8 +42,10 @@ public:
      * @brief constructor for Devirtualization pass.
      * @param typeAnalysisWrapper
      * @param devirtFuncInfo
+     * @param profile instrumentation profile to speculate the callee of invokes, maybe nullptr.
      */
-    explicit Devirtualization(TypeAnalysisWrapper* typeAnalysisWrapper, DevirtualizationInfo& devirtFuncInfo);
+    explicit Devirtualization(TypeAnalysisWrapper* typeAnalysisWrapper, DevirtualizationInfo& devirtFuncInfo,
+        const PGOProfile* profile = nullptr);
 
     /**
      * @brief main optimization pass entry.
@@ -66,6 +69,9 @@ public:
     /// this function mainly get results from second type analysis.
     void AppendFrozenFuncState(const Func* func, std::unique_ptr<Results<TypeDomain>> analysisRes);
 
+    /// get the number of invokes which are speculatively de-virtualized by the profile.
+    size_t GetSpeculatedNum() const;
+
     /// function signature to determine a certain function.
     struct FuncSig {
         std::string name;
@@ -94,6 +100,17 @@ private:
 
     static void RewriteToApply(CHIRBuilder& builder, std::vector<RewriteInfo>& rewriteInfos, bool isDebug);
 
+    /**
+     * The invokes which can't be de-virtualized are called directly if the object is an instance of the class
+     * most of the profiled calls go to, and virtually otherwise.
+     */
+    void SpeculateByProfile(CHIRBuilder& builder, bool isDebug);
+
+    std::pair<FuncBase*, ClassType*> FindProfiledCallee(
+        CHIRBuilder& builder, const Func& caller, const Invoke& invoke) const;
+
+    static Invoke* GuardByInstanceOf(CHIRBuilder& builder, Invoke& invoke, ClassType& expected);
+
     static bool RewriteToBuiltinOp(CHIRBuilder& builder, const RewriteInfo& info, bool isDebug);
 
     /**
@@ -106,7 +123,11 @@ private:
 
     TypeAnalysisWrapper* analysisWrapper;
     DevirtualizationInfo& devirtFuncInfo;
+    const PGOProfile* profile;
     std::vector<RewriteInfo> rewriteInfos{};
+    // invokes which can't be de-virtualized, with the functions containing them
+    std::vector<std::pair<const Func*, Invoke*>> speculationCandidates{};
+    size_t speculatedNum{0};
 
     // frozen inst functions after devirt, these func need a devirt optimization too after first devirt opt
     std::vector<Func*> frozenInstFuns;
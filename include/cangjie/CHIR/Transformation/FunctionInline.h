@@ -15,26 +15,52 @@
 #ifndef CANGJIE_CHIR_TRANSFORMATION_FUNCTION_INLINE_H
 #define CANGJIE_CHIR_TRANSFORMATION_FUNCTION_INLINE_H
 
+#include <limits>
+#include <unordered_set>
+#include <vector>
+
+#include "cangjie/CHIR/Analysis/PGOProfile.h"
 #include "cangjie/CHIR/CHIRBuilder.h"
 #include "cangjie/CHIR/Expression/Terminator.h"
 #include "cangjie/CHIR/Package.h"
+#include "cangjie/CHIR/Transformation/FunctionPassManager.h"
 #include "cangjie/CHIR/Utils.h"
 #include "cangjie/Option/Option.h"
 
 namespace Cangjie::CHIR {
+/**
+ * An inlining decision, recorded if FunctionInline::SetRemarks is set.
+ */
+struct InlineRemark {
+    const Func* caller;
+    const Func* callee;
+    DebugLocation loc;
+    bool inlined;
+    /** Why the call is or isn't inlined, e.g. "size" or "package-budget". */
+    std::string reason;
+    /** The size of the callee and the threshold it is compared with, 0 if the size is not compared. */
+    size_t calleeSize;
+    size_t threshold;
+};
+
 /**
  * CHIR Opt Pass: do function inline for CHIR IR.
  */
 class FunctionInline {
 public:
+    // Inlining reads the bodies of callees while they may be changed by inlining into them.
+    static constexpr PassScope SCOPE = PassScope::MODULE;
+
     /**
      * @brief constructor for function inline pass
      * @param builder CHIR builder for generating IR.
      * @param optLevel optimization level from Cangjie inputs.
      * @param debug flag whether print debug log.
+     * @param profile instrumentation profile to find hot and cold functions, maybe nullptr.
      */
-    FunctionInline(CHIRBuilder& builder, const GlobalOptions::OptimizationLevel& optLevel, bool debug)
-        : builder(builder), optLevel(optLevel), debug(debug)
+    FunctionInline(CHIRBuilder& builder, const GlobalOptions::OptimizationLevel& optLevel, bool debug,
+        const PGOProfile* profile = nullptr)
+        : builder(builder), optLevel(optLevel), debug(debug), profile(profile)
     {
     }
 
@@ -57,8 +83,58 @@ public:
      */
     void DoFunctionInline(const Apply& apply, const std::string& name);
 
+    /**
+     * @brief Use @p funcSizes for the sizes of the callees in it, and @p calledOnceFuncs instead of the current
+     * users of callees, so that different functions may be inlined into concurrently. Both are only read.
+     */
+    void SetPackageInfo(const std::unordered_map<const Func*, size_t>& funcSizes,
+        const std::unordered_set<const Func*>& calledOnceFuncs);
+
+    /**
+     * @brief Limit the size of the callees inlined from now on to @p budget in total, every inlined callee is
+     * charged with its GetFuncSize. Callees in the white list and instance variable initializers are charged too, but
+     * they are inlined even when the budget is exhausted.
+     */
+    void SetGrowthBudget(size_t budget)
+    {
+        growthBudget = budget;
+        growth = 0;
+    }
+
+    /**
+     * @brief Get the size of the callees inlined since the last SetGrowthBudget.
+     */
+    size_t GetGrowth() const
+    {
+        return growth;
+    }
+
+    /**
+     * @brief Record the following inlining decisions into @p remarks, or stop recording if it is nullptr.
+     */
+    void SetRemarks(std::vector<InlineRemark>* newRemarks)
+    {
+        remarks = newRemarks;
+    }
+
+    /**
+     * @brief The size of @p func, compared with the inline thresholds and charged to the growth budget.
+     */
+    static size_t GetFuncSize(const Func& func);
+
+    /**
+     * @brief Whether @p func is applied at most once in the package.
+     */
+    static bool IsOnlyCalledOnce(const Func& func);
+
 private:
     bool CheckCanRewrite(const Apply& apply);
+    bool Decide(const Apply& apply, bool inlined, const std::string& reason, size_t calleeSize = 0,
+        size_t threshold = 0);
+    bool ChargeGrowth(const Apply& apply, const std::string& reason, size_t calleeSize, size_t threshold,
+        bool mandatory = false);
+    size_t GetCalleeSize(Func& callee);
+    bool IsCalledOnce(const Func& callee) const;
     void RecordEffectMap(const Apply& apply);
     void ReplaceFuncResult(LocalVar* resNew, LocalVar* resOld);
 
@@ -72,9 +148,15 @@ private:
     CHIRBuilder& builder;
     const GlobalOptions::OptimizationLevel& optLevel;
     bool debug{false};
+    const PGOProfile* profile{nullptr};
     Func* globalFunc{nullptr};
     std::unordered_map<Func*, size_t> inlinedCountMap;
     std::unordered_map<Func*, size_t> funcSizeMap;
+    const std::unordered_map<const Func*, size_t>* knownFuncSizes{nullptr};
+    const std::unordered_set<const Func*>* calledOnceFuncs{nullptr};
+    size_t growthBudget{std::numeric_limits<size_t>::max()};
+    size_t growth{0};
+    std::vector<InlineRemark>* remarks{nullptr};
     const std::string optName{"Function Inline"};
     OptEffectCHIRMap effectMap;
 };
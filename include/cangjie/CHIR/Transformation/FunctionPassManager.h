@@ -0,0 +1,80 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+// The Cangjie API is in Beta. For details on its capabilities and limitations, please refer to the README file.
+
+#ifndef CANGJIE_CHIR_TRANSFORMATION_FUNCTION_PASS_MANAGER_H
+#define CANGJIE_CHIR_TRANSFORMATION_FUNCTION_PASS_MANAGER_H
+
+#include <functional>
+
+#include "cangjie/CHIR/Analysis/AnalysisManager.h"
+#include "cangjie/CHIR/CHIRBuilder.h"
+#include "cangjie/CHIR/Package.h"
+
+namespace Cangjie::CHIR {
+/**
+ * The part of a package a CHIR Opt Pass may read and write, declared by each pass as its static member SCOPE.
+ */
+enum class PassScope : uint8_t {
+    /**
+     * The pass only changes the function it runs on and reads no other function body, so it may run on different
+     * functions concurrently.
+     */
+    FUNCTION,
+    /**
+     * The pass changes or reads other functions or declarations, e.g. inlines callees or creates new functions.
+     */
+    MODULE
+};
+
+/**
+ * @brief Run @p task for every index below @p num on @p threadNum threads, serially with @p builder if there is
+ * only one of either. The indexes are assigned to tasks round-robin, there are more tasks than threads so that a
+ * few large items do not leave threads idle. Every task creates IR with its own CHIRBuilder, whose allocations are
+ * merged into @p builder afterwards, as the parallel constant and range propagation do.
+ * @param task run on one index with the builder to create IR with, it must not depend on the other indexes.
+ */
+void ParallelFor(CHIRBuilder& builder, size_t threadNum, size_t num,
+    const std::function<void(size_t idx, CHIRBuilder& builder)>& task);
+
+/**
+ * Runs a pass on every global function of a package, concurrently on different functions if the pass is
+ * function-local, see ParallelFor. The functions changed by a pass are marked in the AnalysisManager, if any.
+ */
+class FunctionPassManager {
+public:
+    /**
+     * @brief A pass on one function. @p builder must be used for all IR created by the pass.
+     * Returns whether @p func has been changed.
+     */
+    using FunctionPass = std::function<bool(Func& func, CHIRBuilder& builder)>;
+
+    /**
+     * @brief constructor for function pass manager.
+     * @param builder CHIR builder of the package.
+     * @param threadNum the number of threads to run function-local passes with.
+     * @param analysisManager the manager to mark changed functions in.
+     */
+    FunctionPassManager(CHIRBuilder& builder, size_t threadNum, AnalysisManager* analysisManager = nullptr);
+
+    /**
+     * @brief Run @p pass on the global functions of @p package, in parallel if @p scope is PassScope::FUNCTION.
+     * The result does not depend on the number of threads.
+     * @param package package to do optimization.
+     * @param scope the scope declared by the pass.
+     * @param pass the pass on one function.
+     */
+    void RunOnPackage(const Package& package, PassScope scope, const FunctionPass& pass) const;
+
+private:
+    CHIRBuilder& builder;
+    size_t threadNum;
+    AnalysisManager* analysisManager;
+};
+} // namespace Cangjie::CHIR
+
+#endif
@@ -0,0 +1,53 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+// The Cangjie API is in Beta. For details on its capabilities and limitations, please refer to the README file.
+
+#ifndef CANGJIE_CHIR_TRANSFORMATION_LOOP_INVARIANT_CODE_MOTION_H
+#define CANGJIE_CHIR_TRANSFORMATION_LOOP_INVARIANT_CODE_MOTION_H
+
+#include "cangjie/CHIR/Analysis/EscapeAnalysis.h"
+#include "cangjie/CHIR/Analysis/LoopAnalysis.h"
+#include "cangjie/CHIR/CHIRBuilder.h"
+#include "cangjie/CHIR/Transformation/FunctionPassManager.h"
+
+namespace Cangjie::CHIR {
+/**
+ * CHIR Opt Pass: hoist loop invariant expressions into the preheaders of the natural loops of a function, innermost
+ * loops first, creating the preheaders where needed.
+ *
+ * An expression is hoisted if its operands are defined outside the loop and it is one of:
+ * 1. an expression which cannot throw, e.g. comparisons, bit operations, wrapping arithmetic, struct fields;
+ * 2. a load from a local allocation which does not escape, see EscapeAnalysis, and is only read in the loop;
+ * 3. a call of a function marked as having no side effect, see NoSideEffectMarker, with value arguments, if the call
+ *    is executed whenever the loop is, i.e. it dominates all latches and exits of the loop.
+ * The first two may run speculatively, so they are hoisted out of conditional blocks as well.
+ */
+class LoopInvariantCodeMotion {
+public:
+    static constexpr PassScope SCOPE = PassScope::FUNCTION;
+
+    explicit LoopInvariantCodeMotion(const EscapeAnalysis& escapeAnalysis);
+
+    /**
+     * @brief Main process to do loop invariant code motion per func.
+     * @param func func to do optimization.
+     * @param builder CHIR builder for creating the preheaders.
+     * @param isDebug flag whether print debug log.
+     * @return the number of hoisted expressions.
+     */
+    size_t RunOnFunc(const Func& func, CHIRBuilder& builder, bool isDebug) const;
+
+private:
+    size_t HoistInvariants(const NaturalLoop& loop, Block& preheader, const DominatorTree& domTree, bool isDebug) const;
+    bool IsHoistable(const Expression& expr, const NaturalLoop& loop, bool isGuaranteed) const;
+    bool IsInvariantMemory(const Value& location, const NaturalLoop& loop) const;
+
+    const EscapeAnalysis& escapeAnalysis;
+};
+} // namespace Cangjie::CHIR
+
+#endif
@@ -11,6 +11,7 @@
 
 #include "cangjie/Option/Option.h"
 #include "cangjie/CHIR/Package.h"
+#include "cangjie/CHIR/Transformation/FunctionPassManager.h"
 #include "cangjie/CHIR/Value.h"
 
 namespace Cangjie::CHIR {
@@ -19,6 +20,8 @@ namespace Cangjie::CHIR {
  */
 class MergeBlocks {
 public:
+    static constexpr PassScope SCOPE = PassScope::FUNCTION;
+
     /**
      * @brief constructor for mergin blocks.
      */
@@ -37,8 +40,9 @@ public:
      * @param body func body to merge blocks
      * @param builder CHIR builder for generating IR.
      * @param opts global options from Cangjie inputs.
+     * @return whether any block is merged.
      */
-    static void RunOnFunc(const BlockGroup& body, CHIRBuilder& builder, const GlobalOptions& opts);
+    static bool RunOnFunc(const BlockGroup& body, CHIRBuilder& builder, const GlobalOptions& opts);
 };
 } // namespace Cangjie::CHIR
 
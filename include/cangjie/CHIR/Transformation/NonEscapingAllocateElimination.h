@@ -0,0 +1,49 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+// The Cangjie API is in Beta. For details on its capabilities and limitations, please refer to the README file.
+
+#ifndef CANGJIE_CHIR_TRANSFORMATION_NON_ESCAPING_ALLOCATE_ELIMINATION_H
+#define CANGJIE_CHIR_TRANSFORMATION_NON_ESCAPING_ALLOCATE_ELIMINATION_H
+
+#include "cangjie/CHIR/Analysis/EscapeAnalysis.h"
+#include "cangjie/CHIR/CHIRBuilder.h"
+#include "cangjie/CHIR/Transformation/FunctionPassManager.h"
+
+namespace Cangjie::CHIR {
+/**
+ * CHIR Opt Pass: replace the heap allocation of a class object which does not escape its function, see
+ * EscapeAnalysis, by one local allocation per member variable, which CodeGen places on the stack.
+ *
+ * The object must only be accessed through its member variables, e.g. after its constructor has been inlined,
+ * because no callee could accept the scattered member variables as an object. A reference to a member variable may
+ * still be passed to a callee which does not let the parameter escape, see EscapeAnalysis::IsParamEscaping, e.g. as
+ * `this` of a mutating method of a struct member variable: it is replaced by the local allocation of the member.
+ */
+class NonEscapingAllocateElimination {
+public:
+    static constexpr PassScope SCOPE = PassScope::FUNCTION;
+
+    explicit NonEscapingAllocateElimination(const EscapeAnalysis& escapeAnalysis);
+
+    /**
+     * @brief Main process to eliminate the non-escaping allocations of a func.
+     * @param func func to do optimization.
+     * @param builder CHIR builder for creating the local allocations.
+     * @param isDebug flag whether print debug log.
+     * @param enableCompileDebug whether debug information is generated, then variables with Debug are not replaced.
+     * @return the number of eliminated heap allocations.
+     */
+    size_t RunOnFunc(const Func& func, CHIRBuilder& builder, bool isDebug, bool enableCompileDebug) const;
+
+private:
+    bool IsReplaceable(const Allocate& allocate, const Func& func, CHIRBuilder& builder, bool enableCompileDebug) const;
+
+    const EscapeAnalysis& escapeAnalysis;
+};
+} // namespace Cangjie::CHIR
+
+#endif
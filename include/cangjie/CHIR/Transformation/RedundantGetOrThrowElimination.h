@@ -10,6 +10,7 @@
 #define CANGJIE_CHIR_TRANSFORMATION_REDUNDANT_GETORTHROW_ELIMINATION_H
 
 #include "cangjie/CHIR/Package.h"
+#include "cangjie/CHIR/Transformation/FunctionPassManager.h"
 #include "cangjie/CHIR/Value.h"
 
 namespace Cangjie::CHIR {
@@ -18,6 +19,8 @@ namespace Cangjie::CHIR {
  */
 class RedundantGetOrThrowElimination {
 public:
+    static constexpr PassScope SCOPE = PassScope::FUNCTION;
+
     /**
      * @brief constructor for GetOrThrow function elimination.
      */
@@ -30,8 +33,13 @@ public:
      */
     void RunOnPackage(const Ptr<const Package>& package, bool isDebug) const;
 
-private:
-    void RunOnFunc(const Ptr<const Func>& func, bool isDebug) const;
+    /**
+     * @brief Main process to do GetOrThrow elimination per func.
+     * @param func func to do optimization.
+     * @param isDebug flag whether print debug log.
+     * @return whether the func is changed.
+     */
+    bool RunOnFunc(const Ptr<const Func>& func, bool isDebug) const;
 };
 } // namespace Cangjie::CHIR
 
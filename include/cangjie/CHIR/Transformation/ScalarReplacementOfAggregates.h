@@ -0,0 +1,40 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+// The Cangjie API is in Beta. For details on its capabilities and limitations, please refer to the README file.
+
+#ifndef CANGJIE_CHIR_TRANSFORMATION_SCALAR_REPLACEMENT_OF_AGGREGATES_H
+#define CANGJIE_CHIR_TRANSFORMATION_SCALAR_REPLACEMENT_OF_AGGREGATES_H
+
+#include "cangjie/CHIR/CHIRBuilder.h"
+#include "cangjie/CHIR/Transformation/FunctionPassManager.h"
+#include "cangjie/CHIR/Value.h"
+
+namespace Cangjie::CHIR {
+/**
+ * CHIR Opt Pass: split the local allocation of a struct or tuple into one local allocation per element, recursively,
+ * so that CodeGen emits scalars instead of aggregates and the copies between them.
+ *
+ * The allocation must not escape its function: it may only be read and written element-wise, stored as a whole, or
+ * loaded as a whole when only elements of the loaded value are used.
+ */
+class ScalarReplacementOfAggregates {
+public:
+    static constexpr PassScope SCOPE = PassScope::FUNCTION;
+
+    /**
+     * @brief Main process to do scalar replacement of aggregates per func.
+     * @param func func to do optimization.
+     * @param builder CHIR builder for creating the element allocations.
+     * @param isDebug flag whether print debug log.
+     * @param enableCompileDebug whether debug information is generated, then variables with Debug are not split.
+     * @return the number of split allocations.
+     */
+    static size_t RunOnFunc(const Func& func, CHIRBuilder& builder, bool isDebug, bool enableCompileDebug);
+};
+} // namespace Cangjie::CHIR
+
+#endif
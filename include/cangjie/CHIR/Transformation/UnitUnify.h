@@ -12,6 +12,7 @@
 #include "cangjie/CHIR/CHIRBuilder.h"
 #include "cangjie/CHIR/Expression/Terminator.h"
 #include "cangjie/CHIR/Package.h"
+#include "cangjie/CHIR/Transformation/FunctionPassManager.h"
 #include "cangjie/CHIR/Value.h"
 
 namespace Cangjie::CHIR {
@@ -31,6 +32,8 @@ namespace Cangjie::CHIR {
  */
 class UnitUnify {
 public:
+    static constexpr PassScope SCOPE = PassScope::FUNCTION;
+
     /**
      * @brief constructor to unify all used units to one in a function.
      * @param builder CHIR builder for generating IR.
@@ -44,9 +47,15 @@ public:
      */
     void RunOnPackage(const Ptr<const Package>& package, bool isDebug);
 
-private:
-    void RunOnFunc(const Ptr<Func>& func, bool isDebug);
+    /**
+     * @brief Main process to unify all used units to one per func.
+     * @param func func to do optimization.
+     * @param isDebug flag whether print debug log.
+     * @return whether the func is changed.
+     */
+    bool RunOnFunc(const Ptr<Func>& func, bool isDebug);
 
+private:
     void LoadOrCreateUnit(Ptr<Constant>& constant, const Ptr<BlockGroup>& group);
 
     CHIRBuilder& builder;
@@ -10,6 +10,7 @@
 #define CANGJIE_CHIR_TRANSFORMATION_USELESS_ALLOCATE_ELIMINATION_H
 
 #include "cangjie/CHIR/Package.h"
+#include "cangjie/CHIR/Transformation/FunctionPassManager.h"
 #include "cangjie/CHIR/Value.h"
 
 namespace Cangjie::CHIR {
@@ -18,14 +19,22 @@ namespace Cangjie::CHIR {
  */
 class UselessAllocateElimination {
 public:
+    static constexpr PassScope SCOPE = PassScope::FUNCTION;
+
     /**
      * @brief Main process to do useless allocate elimination.
      * @param package package to do optimization.
      * @param isDebug flag whether print debug log.
      */
     static void RunOnPackage(const Package& package, bool isDebug);
-private:
-    static void RunOnFunc(const Func& func, bool isDebug);
+
+    /**
+     * @brief Main process to do useless allocate elimination per func.
+     * @param func func to do optimization.
+     * @param isDebug flag whether print debug log.
+     * @return whether the func is changed.
+     */
+    static bool RunOnFunc(const Func& func, bool isDebug);
 };
 } // namespace Cangjie::CHIR
 
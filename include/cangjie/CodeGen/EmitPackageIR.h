@@ -16,8 +16,46 @@
 #include "cangjie/Frontend/CompilerInstance.h"
 #include "cangjie/FrontendTool/IncrementalCompilerInstance.h"
 #include "cangjie/Option/Option.h"
+#include "cangjie/Utils/PersistentCache.h"
 
 namespace Cangjie::CodeGen {
+#ifdef CANGJIE_CODEGEN_CJNATIVE_BACKEND
+/**
+ * @brief The use of the persistent object cache while generating the modules of a package.
+ *
+ * Each sub-module is keyed by a hash of its CHIR content, of the package-wide CHIR it depends on (type definitions,
+ * signatures of global values, imports) and of the options. Sub-modules whose object file is found in the cache are
+ * not generated at all.
+ */
+struct ObjectCacheSession {
+    struct Entry {
+        std::string key;
+        size_t index;                              /**< The index of the sub-module among all sub-modules. */
+        std::vector<std::string> localizedSymbols; /**< See GlobalOptions::symbolsNeedLocalized. */
+        std::vector<uint8_t> object;               /**< The cached object file, empty for generated modules. */
+    };
+
+    explicit ObjectCacheSession(Utils::PersistentCache& cache) : cache(cache)
+    {
+    }
+
+    Utils::PersistentCache& cache;
+    std::vector<Entry> generated; /**< One entry per returned module, to be stored once its object file is emitted. */
+    std::vector<Entry> reused;    /**< The sub-modules which are not generated because their object file is cached. */
+};
+
+/**
+ * @brief Serialize every option which affects the code generated for a package, for the object cache key.
+ *
+ * GlobalOptions::ToSerialized() only covers the options which affect the frontend, so the options read by CodeGen
+ * alone are added explicitly. An option newly read by CodeGen must be added here as well.
+ *
+ * @param options GlobalOptions to compile a package.
+ * @return The serialized options.
+ */
+std::vector<std::string> SerializeCodeGenOptions(const GlobalOptions& options);
+#endif
+
 /**
  * @brief This function generates the package modules.
  *        Note that after using llvm::Module, call the ClearPackageModules to clear the memory.
@@ -27,12 +65,14 @@ namespace Cangjie::CodeGen {
  * @param options GlobalOptions to compile a package.
  * @param compilerInstance DefaultCompilerInstance.
  * @param enableIncrement A falg, indicating whether incremental compilation is enabled.
+ * @param objectCache If not null, sub-modules cached in the object cache are skipped and recorded in it.
  * @return A vector of std::unique_ptr<llvm::Module>. If --aggressive-parallel-compile is enabled,
  *         multiple llvm::Modules are returned. Otherwise, only one llvm::Module is returned.
  */
 #ifdef CANGJIE_CODEGEN_CJNATIVE_BACKEND
 std::vector<std::unique_ptr<llvm::Module>> GenPackageModules(CHIR::CHIRBuilder& chirBuilder, const CHIRData& chirData,
-    const GlobalOptions& options, DefaultCompilerInstance& compilerInstance, bool enableIncrement);
+    const GlobalOptions& options, DefaultCompilerInstance& compilerInstance, bool enableIncrement,
+    ObjectCacheSession* objectCache = nullptr);
 #endif
 
 /**
@@ -0,0 +1,47 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+// The Cangjie API is in Beta. For details on its capabilities and limitations, please refer to the README file.
+
+/**
+ * @file
+ *
+ * This file declares the in-process backend, which optimizes LLVM modules and emits object files without running
+ * the 'opt' and 'llc' tools.
+ */
+
+#ifndef CANGJIE_CODEGEN_INPROCESSBACKEND_H
+#define CANGJIE_CODEGEN_INPROCESSBACKEND_H
+
+#include <string>
+#include <vector>
+
+#include "llvm/IR/Module.h"
+
+namespace Cangjie::CodeGen {
+/**
+ * @brief Configure the in-process backend with the 'opt' and 'llc' arguments prepared by the driver.
+ *
+ * LLVM command line options are global to the process, so they are applied once. Later compilations in the same
+ * process can only use the in-process backend if they pass identical arguments.
+ *
+ * @param args The arguments 'opt' and 'llc' would be invoked with, see GlobalOptions::inProcessBackendArgs.
+ * @return false if the backend cannot run in this process, the modules must then be saved as bitcode and compiled
+ *         by 'opt' and 'llc'.
+ */
+bool InitInProcessBackend(const std::vector<std::string>& args);
+
+/**
+ * @brief Run the optimization pipeline of 'opt' on @p module and write its object code to @p objFilePath as 'llc'
+ * would. @ref InitInProcessBackend must have succeeded. Modules of different LLVM contexts may be compiled
+ * concurrently.
+ *
+ * @return If the object file is written successfully, true is returned. Otherwise, false is returned.
+ */
+bool EmitObjectFile(llvm::Module& module, const std::string& objFilePath);
+} // namespace Cangjie::CodeGen
+
+#endif // CANGJIE_CODEGEN_INPROCESSBACKEND_H
@@ -47,6 +47,13 @@ public:
      */
     ~CJNATIVEBackend() = default;
 
+    /**
+     * @brief Decide whether the frontend may run 'opt' and 'llc' in process on the LLVM modules it has generated,
+     * instead of writing bitcode for the 'opt' and 'llc' tools. If so, the arguments these tools would be invoked
+     * with are stored in `inProcessBackendArgs` of @p driverOptions.
+     */
+    static void PrepareInProcessBackend(DriverOptions& driverOptions);
+
 protected:
     bool GenerateToolChain() override;
     /**
@@ -80,6 +87,9 @@ private:
     std::vector<TempFileInfo> GeneratePreprocessTools(const std::vector<TempFileInfo>& bitCodeFiles);
 
     void PreprocessOfNewPassManager(Tool& tool);
+    static std::string GetNewPassManagerPipeline(const DriverOptions& driverOptions);
+    static std::vector<std::string> GetPreprocessOptions(const DriverOptions& driverOptions);
+    static std::vector<std::string> GetCompileOptions(const DriverOptions& driverOptions);
     bool ProcessGenerationOfNormalCompile(const std::vector<TempFileInfo>& bitCodeFiles);
     bool ProcessGenerationOfIncrementalNoChangeCompile(const std::vector<TempFileInfo>& bitCodeFiles);
 
@@ -25,6 +25,7 @@ struct TempFileInfo {
     std::string rawPath{""};        // Record the original path of the file.
     bool isFrontendOutput{false};   // Record file is output by the frontend
     bool isForeignInput{false};     // Record whether it is a pre-compiled file (.bc/.o) provided by users.
+    bool isObject{false};           // Record whether the frontend has already emitted it as an object file.
 };
 
 enum class TempFileKind {
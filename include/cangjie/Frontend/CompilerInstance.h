@@ -24,6 +24,7 @@
 #include "cangjie/Basic/DiagnosticEngine.h"
 #include "cangjie/CHIR/Analysis/AnalysisWrapper.h"
 #include "cangjie/CHIR/Analysis/ConstAnalysis.h"
+#include "cangjie/CHIR/Analysis/PGOProfile.h"
 #include "cangjie/CHIR/Analysis/TypeAnalysis.h"
 #include "cangjie/CHIR/CHIRBuilder.h"
 #include "cangjie/Frontend/CompileStrategy.h"
@@ -86,6 +87,9 @@ public:
     CHIR::AnalysisWrapper<CHIR::ConstAnalysis, CHIR::ConstDomain>& GetConstAnalysisResultRef();
     const CHIR::AnalysisWrapper<CHIR::ConstAnalysis, CHIR::ConstDomain>& GetConstAnalysisResult() const;
 
+    void SetPGOProfile(std::unique_ptr<CHIR::PGOProfile> profile);
+    const CHIR::PGOProfile* GetPGOProfile() const;
+
 private:
     CHIR::CHIRContext cctx;
     std::vector<CHIR::Package*> chirPkgs;
@@ -97,6 +101,8 @@ private:
     CHIR::CHIRBuilder builder{cctx, 0};
     // provide the capability and results of constant analysis, used by cjlint
     CHIR::AnalysisWrapper<CHIR::ConstAnalysis, CHIR::ConstDomain> constAnalysisWrapper{builder};
+    // profile of `--pgo-instr-use`, used by CHIR optimizations
+    std::unique_ptr<CHIR::PGOProfile> pgoProfile;
 };
 #endif
 
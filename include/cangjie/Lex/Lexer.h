@@ -16,6 +16,7 @@
 #define CANGJIE_LEX_LEXER_H
 
 #include <cstdint>
+#include <deque>
 #include <list>
 #include <string>
 
@@ -96,7 +97,7 @@ public:
     // Parse/unittests.
     /// Read and return the next \ref num tokens. If there are less than \ref num tokens left, all are returned.
     /// otherwise, comments are omitted.
-    const std::list<Token>& LookAhead(size_t num);
+    const std::deque<Token>& LookAhead(size_t num);
     /// Returns true if the next token is any of the TokenKind's described by range \ref begin and \ref end.
     /// \param skipNewline whether to ignore NL
     bool Seeing(const std::vector<TokenKind>::const_iterator& begin, const std::vector<TokenKind>::const_iterator& end,
@@ -109,7 +110,7 @@ public:
     // Parse/unittests.
     /// Read and return the next \ref num tokens. If there are less than \ref num tokens left, all are returned.
     /// otherwise, comments and NL's are omitted.
-    std::list<Token> LookAheadSkipNL(size_t num);
+    std::vector<Token> LookAheadSkipNL(size_t num);
     /// Return all comments collected, and clear the comment cache
     std::vector<Token> GetComments();
     const std::vector<Token>& GetTokenStream() const;
@@ -17,6 +17,7 @@
 
 #include <cstdint>
 #include <flatbuffers/flatbuffers.h>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -27,6 +28,7 @@
 #include "cangjie/Basic/DiagnosticEngine.h"
 #include "cangjie/Modules/ASTSerializationTypeDef.h"
 #include "cangjie/Sema/TypeManager.h"
+#include "cangjie/Utils/ReadOnlyBuffer.h"
 
 namespace Cangjie {
 constexpr FormattedIndex INVALID_FORMAT_INDEX = 0;
@@ -72,6 +74,9 @@ class ASTLoader {
 public:
     ASTLoader(std::vector<uint8_t>&& data, const std::string& fullPackageName, TypeManager& typeManager,
         const CjoManager& cjoManager, const GlobalOptions& opts);
+    /** Create a loader reading from @p data which may be shared with other loaders, e.g. by SharedCjoCache. */
+    ASTLoader(std::shared_ptr<const Utils::ReadOnlyBuffer> data, const std::string& fullPackageName,
+        TypeManager& typeManager, const CjoManager& cjoManager, const GlobalOptions& opts);
     // Not use default destructor because 'ASTLoaderImpl' is defined as forward decl in header.
     ~ASTLoader();
 
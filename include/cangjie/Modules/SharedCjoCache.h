@@ -0,0 +1,75 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+// The Cangjie API is in Beta. For details on its capabilities and limitations, please refer to the README file.
+
+/**
+ * @file
+ *
+ * This file declares class SharedCjoCache.
+ */
+
+#ifndef CANGJIE_MODULES_SHARED_CJO_CACHE_H
+#define CANGJIE_MODULES_SHARED_CJO_CACHE_H
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include "cangjie/Utils/ReadOnlyBuffer.h"
+
+namespace Cangjie {
+/**
+ * Process-wide cache of the contents of `.cjo` files, keyed by absolute path.
+ *
+ * Every `ASTLoader` created for the same unchanged file shares one read-only mapping of it instead of reading its own
+ * copy. An entry is revalidated against the file's modification time and size on each lookup and reloaded if the file
+ * has been rebuilt. Buffers are only held weakly, so a buffer is released with the last loader using it.
+ */
+class SharedCjoCache {
+public:
+    using Buffer = std::shared_ptr<const Utils::ReadOnlyBuffer>;
+
+    static SharedCjoCache& Get();
+
+    /**
+     * Read the file @p cjoPath, or return the cached contents if the file has not changed since it was last read.
+     * @param[out] failedReason Why reading the file failed, empty on success.
+     * @return The contents of the file, nullptr if reading failed.
+     */
+    Buffer Load(const std::string& cjoPath, std::string& failedReason);
+
+private:
+    SharedCjoCache() = default;
+    ~SharedCjoCache() = default;
+    SharedCjoCache(SharedCjoCache&&) = delete;
+    SharedCjoCache(const SharedCjoCache&) = delete;
+    SharedCjoCache& operator=(const SharedCjoCache&) = delete;
+    SharedCjoCache& operator=(SharedCjoCache&&) = delete;
+
+    struct FileStamp {
+        int64_t mtime{0}; /**< Modification time in nanoseconds, in the precision provided by the platform. */
+        uint64_t size{0};
+        bool operator==(const FileStamp& other) const
+        {
+            return mtime == other.mtime && size == other.size;
+        }
+    };
+    struct Entry {
+        FileStamp stamp;
+        std::weak_ptr<const Utils::ReadOnlyBuffer> buffer;
+    };
+
+    static std::optional<FileStamp> GetFileStamp(const std::string& path);
+
+    std::mutex mtx;
+    std::unordered_map<std::string, Entry> entries;
+};
+} // namespace Cangjie
+#endif
@@ -606,6 +606,7 @@ public:
 #endif
     bool chirEA = false;   /**< Whether enable escape analysis on CHIR. */
     bool chirLICM = false; /**< Whether enable LICM on CHIR (this depends on escape analysis) */
+    std::string chirInlineRemarksFile; /**< The file to write the CHIR inlining decisions to, if not empty. */
 
     // CHIR closure-conversion
     bool chirCC = false;
@@ -838,6 +839,18 @@ public:
     bool aggressiveParallelCompileWithoutArg = false;
     std::vector<std::string> bitcodeFilesName; /** < the name of packageMoudle.bc. */
     std::vector<std::string> symbolsNeedLocalized; /** < Symbols that need to be localized in the compiled binary. */
+    bool inProcessBackend = false; /**< Optimize and emit objects in the compiler process instead of opt and llc. */
+    /**
+     * Arguments of 'opt' and 'llc' for the in-process backend. They are set by the driver only if `inProcessBackend`
+     * can be honoured for this compilation, otherwise the frontend outputs bitcode to be compiled by 'opt' and 'llc'.
+     */
+    std::vector<std::string> inProcessBackendArgs;
+    /**
+     * Directory of the persistent object cache, which is only used together with the in-process backend. Object
+     * files of sub-modules whose CHIR, imports and options are unchanged are taken from it instead of being generated.
+     */
+    std::string objectCacheDir;
+    uint64_t objectCacheSize = 2048ULL * 1024 * 1024; /**< The size in bytes the object cache is trimmed to. */
 
     /**
      * @brief Determine if the output mode is executable.
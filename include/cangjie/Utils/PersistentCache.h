@@ -0,0 +1,78 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+// The Cangjie API is in Beta. For details on its capabilities and limitations, please refer to the README file.
+
+/**
+ * @file
+ *
+ * This file declares class PersistentCache.
+ */
+
+#ifndef CANGJIE_UTILS_PERSISTENT_CACHE_H
+#define CANGJIE_UTILS_PERSISTENT_CACHE_H
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Cangjie::Utils {
+/**
+ * A content-addressed store of files in a directory on disk, which may be shared by any number of compiler processes,
+ * e.g. by builds of different checkouts on the same machine.
+ *
+ * An entry is a data file and a metadata string stored under a key, which the user derives from everything that
+ * determines the data, so entries are never updated. Entries are written to a temporary file and renamed into place
+ * (MoveFileExW on Windows), so readers never observe a partially written entry and concurrent stores of the same key
+ * are harmless.
+ *
+ * A lookup refreshes the modification time of the entry, which @ref Trim uses to remove the least recently used
+ * entries once the total size of the cache exceeds its capacity.
+ */
+class PersistentCache {
+public:
+    struct Stats {
+        size_t hits{0};
+        size_t misses{0};
+        size_t stores{0};
+        size_t evictions{0};
+    };
+
+    /**
+     * @param dir The directory of the cache, created when the first entry is stored.
+     * @param capacity The size in bytes the cache is trimmed to.
+     */
+    PersistentCache(const std::string& dir, uint64_t capacity);
+
+    /** Format a hash as a key, keys of several hashes can be concatenated. */
+    static std::string HashToKey(uint64_t hash);
+
+    /**
+     * Read the entry @p key.
+     * @return false if there is no such entry, @p data and @p metadata are left unchanged then.
+     */
+    bool Lookup(const std::string& key, std::vector<uint8_t>& data, std::string& metadata);
+
+    /** Store the contents of the file @p filePath and @p metadata as the entry @p key. */
+    bool Store(const std::string& key, const std::string& filePath, const std::string& metadata);
+
+    /** Remove the least recently used entries until the cache fits its capacity. */
+    void Trim();
+
+    Stats GetStats() const;
+
+private:
+    std::string GetDataPath(const std::string& key) const;
+    std::string GetMetadataPath(const std::string& key) const;
+
+    std::string dir;
+    uint64_t capacity;
+    mutable std::mutex mtx;
+    Stats stats;
+};
+} // namespace Cangjie::Utils
+#endif
@@ -0,0 +1,77 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+// The Cangjie API is in Beta. For details on its capabilities and limitations, please refer to the README file.
+
+/**
+ * @file
+ *
+ * This file declares class ReadOnlyBuffer.
+ */
+
+#ifndef CANGJIE_UTILS_READONLYBUFFER_H
+#define CANGJIE_UTILS_READONLYBUFFER_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Cangjie::Utils {
+/**
+ * An immutable byte buffer holding the contents of a serialized file such as `.cjo` or `.chir`.
+ *
+ * On POSIX systems a file is mapped read-only into memory, so its pages are shared with the page cache and with
+ * every other user of the same file, and FlatBuffers tables are read in place without any copy. On Windows, where a
+ * mapped file cannot be replaced while it is open, or if mapping fails, the file is read into memory instead.
+ *
+ * If another program truncates a mapped file, reading the lost pages raises SIGBUS. A fault inside a live mapping is
+ * reported as an error reading that file and the compiler exits, as it would for any unreadable input.
+ */
+class ReadOnlyBuffer {
+public:
+    /**
+     * Map or read the file @p filePath.
+     * @param[out] failedReason Why reading the file failed, empty on success.
+     * @return The buffer, nullptr if the file cannot be read.
+     */
+    static std::shared_ptr<const ReadOnlyBuffer> FromFile(const std::string& filePath, std::string& failedReason);
+    /** Wrap bytes which are already in memory. */
+    static std::shared_ptr<const ReadOnlyBuffer> FromVector(std::vector<uint8_t>&& data);
+
+    ~ReadOnlyBuffer();
+    ReadOnlyBuffer(const ReadOnlyBuffer&) = delete;
+    ReadOnlyBuffer& operator=(const ReadOnlyBuffer&) = delete;
+
+    const uint8_t* Data() const
+    {
+        return data;
+    }
+    size_t Size() const
+    {
+        return size;
+    }
+    bool Empty() const
+    {
+        return size == 0;
+    }
+    bool IsMapped() const
+    {
+        return mapped;
+    }
+
+private:
+    ReadOnlyBuffer() = default;
+
+    const uint8_t* data{nullptr};
+    size_t size{0};
+    bool mapped{false};
+    size_t guardSlot{0};        /**< Slot of the mapping in the SIGBUS guard, only valid if mapped. */
+    std::string path;           /**< Path of the mapped file, reported if it is truncated. */
+    std::vector<uint8_t> owned; /**< Storage when the contents are not mapped. */
+};
+} // namespace Cangjie::Utils
+#endif
@@ -41,6 +41,10 @@ public:
     {
         return GetHashValue(std::string{data});
     }
+    static uint64_t GetHashValue(const uint8_t* data, size_t size)
+    {
+        return SipHash_2_4(data, size);
+    }
 
 private:
     static const uint64_t k0_ = 0xdeadbeef;
@@ -15,12 +15,17 @@
 #ifndef CANGJIE_UTILS_TASKQUEUE_H
 #define CANGJIE_UTILS_TASKQUEUE_H
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <functional>
 #include <future>
 #include <mutex>
 #include <queue>
 #include <thread>
+#include <vector>
 #include "cangjie/Utils/CheckUtils.h"
+#include "cangjie/Utils/ThreadPool.h"
 
 namespace Cangjie::Utils {
 
@@ -49,16 +54,19 @@ private:
 
 /**
  * A heuristic parallel task queue. Each task needs to be created with a
- * specified weight. Each available thread selects the task at the head
+ * specified weight. Each available runner selects the task at the head
  * of the queue from the task queue to execute. This means tasks with
  * higher weights can always be executed with higher priority.
  *
- * Note that **adding tasks** and **executing tasks** are phased and it
- * is not allowed to add tasks again after TaskQueue starts to execute.
- * Therefore, make sure all tasks have been added before TaskQueue is
- * executed. Otherwise, unintended behavior may occur.
+ * Tasks are executed by the process-wide work-stealing `ThreadPool`, so no
+ * thread is created per queue. At most `threadsNum` tasks of one queue run at
+ * the same time. Tasks added before the queue starts are sorted once and then
+ * claimed lock-free; tasks may also be added while the queue is executing
+ * (e.g. from inside a running task), they are scheduled by priority among the
+ * remaining dynamically added tasks.
  *
- * @tparam TRes The type of task result
+ * Waiting for a queue from inside a task of another queue is allowed: the
+ * waiting worker keeps executing pending jobs instead of blocking the pool.
  */
 class TaskQueue {
 public:
@@ -72,11 +80,16 @@ public:
 
     ~TaskQueue()
     {
-        threads.clear();
+        WaitForAllTasksCompleted();
     }
 
+    TaskQueue(const TaskQueue&) = delete;
+    TaskQueue& operator=(const TaskQueue&) = delete;
+
     /**
-     * Add a task into the queue. This is not a concurrency-safe method.
+     * Add a task into the queue. Before the queue starts this is not a
+     * concurrency-safe method; once the queue is executing, tasks may be added
+     * from any thread.
      * @tparam TRes The result type of the task.
      * @param fn Function to be executed by the task.
      * @param priority Priority of the task.
@@ -84,41 +97,65 @@ public:
      */
     template <typename TRes> TaskResult<TRes> AddTask(const std::function<TRes()>& fn, uint64_t priority = 0U)
     {
-        CJC_ASSERT(!isStarted && "Do not add new tasks while executing.");
         auto task = std::make_shared<std::packaged_task<TRes()>>(fn);
         TaskResult<TRes> res = task->get_future();
-        tasks.emplace([task]() mutable { (*task)(); }, priority);
+        if (!isStarted) {
+            (void)tasks.emplace_back([task]() mutable { (*task)(); }, priority);
+            return res;
+        }
+        std::unique_lock<std::mutex> lock(mutex);
+        lateTasks.emplace([task]() mutable { (*task)(); }, priority);
+        if (activeRunners < threadsNum) {
+            ++activeRunners;
+            lock.unlock();
+            ThreadPool::Get().Submit([this]() { DoTask(); });
+        }
         return res;
     }
 
     /**
-     * Create threads and start executing tasks in the queue asynchronously
-     * in the background.
+     * Start executing tasks in the queue asynchronously in the background.
      */
     void RunInBackground()
     {
         if (tasks.empty()) {
             return;
         }
-        CreateThreads();
+        Start(false);
     }
 
     /**
-     * Waiting for all threads to complete the tasks.
+     * Waiting for all tasks to be completed.
      */
     void WaitForAllTasksCompleted()
     {
-        for (auto& thread : threads) {
-            if (thread.joinable()) {
-                thread.join();
+        if (!ThreadPool::IsWorkerThread()) {
+            std::unique_lock<std::mutex> lock(mutex);
+            allDone.wait(lock, [this]() { return activeRunners == 0; });
+            return;
+        }
+        // A worker must not block while jobs are pending: the tasks it waits for may be queued behind it on its own
+        // deque. Once nothing is left to run, it parks until the queue is done or a new job is submitted.
+        auto isDone = [this]() {
+            std::unique_lock<std::mutex> lock(mutex);
+            return activeRunners == 0;
+        };
+        size_t spins = 0;
+        while (!isDone()) {
+            if (ThreadPool::Get().TryRunOne()) {
+                spins = 0;
+            } else if (++spins < MAX_SPINS_BEFORE_PARK) {
+                std::this_thread::yield();
+            } else {
+                ThreadPool::Get().Park(isDone);
+                spins = 0;
             }
         }
-        threads.clear();
     }
 
     /**
-     * Create threads to start asynchronously executing tasks in the queue and
-     * waiting for all threads to complete the tasks.
+     * Start executing tasks in the queue and waiting for all of them to be
+     * completed. The calling thread takes part in the execution.
      * Note: it will block the main thread.
      */
     void RunAndWaitForAllTasksCompleted()
@@ -126,40 +163,68 @@ public:
         if (tasks.empty()) {
             return;
         }
-        CreateThreads();
+        Start(true);
         WaitForAllTasksCompleted();
     }
 
 private:
-    void CreateThreads()
+    void Start(bool runOnCaller)
     {
         isStarted = true;
+        std::stable_sort(tasks.begin(), tasks.end(), [](const Task& a, const Task& b) { return b < a; });
         auto fixedThreadsNum = std::min(tasks.size(), threadsNum);
-        for (size_t threadIdx = 0; threadIdx < fixedThreadsNum; ++threadIdx) {
-            (void)threads.emplace_back([this] { DoTask(); });
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            activeRunners += fixedThreadsNum;
+        }
+        size_t pooledRunners = runOnCaller ? fixedThreadsNum - 1 : fixedThreadsNum;
+        for (size_t i = 0; i < pooledRunners; ++i) {
+            ThreadPool::Get().Submit([this]() { DoTask(); });
+        }
+        if (runOnCaller) {
+            DoTask();
         }
     }
 
     void DoTask()
     {
-        // Once the thread is idle, it selects the task at the head of the queue to execute.
+        // Once the runner is idle, it selects the task at the head of the queue to execute.
         while (true) {
+            size_t idx = nextTask.fetch_add(1, std::memory_order_relaxed);
+            if (idx < tasks.size()) {
+                tasks[idx]();
+                continue;
+            }
             std::unique_lock<std::mutex> lock(mutex);
-            // No remaining tasks. Thread exits polling.
-            if (tasks.empty()) {
+            // No remaining tasks. Runner exits polling. Notify while holding the lock, since the queue may be
+            // destroyed as soon as the waiter observes the last runner leaving.
+            if (lateTasks.empty()) {
+                if (--activeRunners != 0) {
+                    return;
+                }
+                allDone.notify_all();
+                lock.unlock();
+                // Workers waiting for this queue are parked on the pool. The pool outlives the queue, so it is safe
+                // to use after the queue may have been destroyed.
+                ThreadPool::Get().WakeWaiters();
                 return;
             }
-            Task task = tasks.top();
-            tasks.pop();
+            Task task = lateTasks.top();
+            lateTasks.pop();
             lock.unlock();
             task();
         }
     }
 
-    std::priority_queue<Task> tasks;
+    static constexpr size_t MAX_SPINS_BEFORE_PARK = 64;
+
+    std::vector<Task> tasks;                /**< Tasks added before start, sorted by priority when starting. */
+    std::atomic<size_t> nextTask{0};        /**< Index of the next task in `tasks` to be claimed. */
+    std::priority_queue<Task> lateTasks;    /**< Tasks added while executing, guarded by `mutex`. */
     std::mutex mutex;
+    std::condition_variable allDone;
     size_t threadsNum;
-    std::vector<std::thread> threads;
+    size_t activeRunners = 0;               /**< Runners submitted and not yet exited, guarded by `mutex`. */
     bool isStarted = false;
 };
 } // namespace Cangjie::Utils
@@ -0,0 +1,97 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+// The Cangjie API is in Beta. For details on its capabilities and limitations, please refer to the README file.
+
+/**
+ * @file
+ *
+ * This file declares the process-wide work-stealing ThreadPool.
+ */
+
+#ifndef CANGJIE_UTILS_THREADPOOL_H
+#define CANGJIE_UTILS_THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Cangjie::Utils {
+/**
+ * A persistent pool of worker threads shared by the whole process. Each worker owns a deque of jobs: the owner pushes
+ * and pops at the back (LIFO, good locality for jobs spawned by a running job), while idle workers steal from the
+ * front of other workers' deques. Jobs submitted from a non-worker thread are distributed round-robin.
+ *
+ * Workers are created lazily on the first submission and live until the process exits, so phases of the compiler no
+ * longer pay for thread creation. Users normally go through `TaskQueue`, which adds priorities, result futures and a
+ * per-queue concurrency limit on top of this pool.
+ */
+class ThreadPool {
+public:
+    using Job = std::function<void()>;
+
+    static ThreadPool& Get();
+
+    /** Submit a job. It is safe to call from any thread, including from inside a running job. */
+    void Submit(Job job);
+
+    /**
+     * Run at most one pending job on the calling thread. Used by threads that wait for other jobs to complete, so
+     * that a job waiting for its children never deadlocks the pool.
+     * @return true if a job has been executed.
+     */
+    bool TryRunOne();
+
+    /**
+     * Block the calling thread until @p done returns true or a job is pending. @p done is evaluated under the pool's
+     * sleep lock, so whoever makes it true must call `WakeWaiters` afterwards.
+     */
+    void Park(const std::function<bool()>& done);
+
+    /** Wake the threads blocked in `Park` (and idle workers) to re-check their conditions. */
+    void WakeWaiters();
+
+    /** Number of worker threads in the pool. */
+    size_t GetWorkersNum() const
+    {
+        return workersNum;
+    }
+
+    /** Whether the calling thread is one of the pool's workers. */
+    static bool IsWorkerThread();
+
+private:
+    explicit ThreadPool(size_t workersNum);
+    ~ThreadPool() = default;
+    ThreadPool(ThreadPool&&) = delete;
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ThreadPool& operator=(ThreadPool&&) = delete;
+
+    struct WorkDeque {
+        std::mutex mtx;
+        std::deque<Job> jobs;
+    };
+
+    void StartWorkers();
+    void WorkerLoop(size_t idx);
+    bool PopOrSteal(size_t startIdx, bool popOwn, Job& job);
+
+    const size_t workersNum;
+    std::vector<std::unique_ptr<WorkDeque>> deques;
+    std::once_flag startFlag;
+    std::atomic<size_t> nextDeque{0};
+    std::atomic<size_t> queuedJobs{0};
+    std::mutex sleepMtx;
+    std::condition_variable sleepCv;
+};
+} // namespace Cangjie::Utils
+#endif
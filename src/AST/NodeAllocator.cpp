@@ -0,0 +1,277 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+// The Cangjie API is in Beta. For details on its capabilities and limitations, please refer to the README file.
+
+/**
+ * @file
+ *
+ * This file implements the allocator of AST nodes.
+ */
+
+#include "cangjie/AST/NodeAllocator.h"
+
+#include <algorithm>
+#include <mutex>
+#include <new>
+#include <vector>
+
+using namespace Cangjie::AST;
+
+namespace {
+// Every pooled node is allocated at a multiple of GRANULE bytes, which keeps the default alignment of operator new.
+constexpr size_t GRANULE = 16;
+// The largest node is about 1.6 KiB.
+constexpr size_t MAX_POOLED_SIZE = 2048;
+constexpr size_t SIZE_CLASSES = MAX_POOLED_SIZE / GRANULE;
+constexpr size_t SLAB_SIZE = 64 * 1024;
+// A thread keeps at most this many free nodes of a size class, the surplus moves to the depot.
+constexpr size_t MAX_CACHED_NODES = 256;
+// The number of free nodes moved between a thread and the depot at once.
+constexpr size_t BATCH_NODES = 64;
+
+struct FreeNode {
+    FreeNode* next;
+};
+
+struct FreeList {
+    FreeNode* head{nullptr};
+    size_t count{0};
+
+    void Push(void* ptr)
+    {
+        auto node = static_cast<FreeNode*>(ptr);
+        node->next = head;
+        head = node;
+        ++count;
+    }
+
+    void* Pop()
+    {
+        FreeNode* node = head;
+        head = node->next;
+        --count;
+        return node;
+    }
+
+    /** Moves up to @p n nodes to @p other, returns the number of moved nodes. */
+    size_t MoveTo(FreeList& other, size_t n)
+    {
+        size_t moved = 0;
+        while (head != nullptr && moved < n) {
+            other.Push(Pop());
+            ++moved;
+        }
+        return moved;
+    }
+};
+
+/**
+ * The free nodes of a thread. It is trivially destructible on purpose: nodes may still be freed by destructors of
+ * other thread-local or static objects, after the destructor of the cache would have run. Its nodes move to the depot
+ * when the thread exits, see ThreadCacheFlusher.
+ */
+struct ThreadCache {
+    FreeList lists[SIZE_CLASSES];
+};
+
+thread_local ThreadCache g_threadCache;
+
+inline size_t NodeSizeOf(size_t sizeClass)
+{
+    return (sizeClass + 1) * GRANULE;
+}
+
+inline size_t NodesPerSlab(size_t sizeClass)
+{
+    return SLAB_SIZE / NodeSizeOf(sizeClass);
+}
+
+/**
+ * The free nodes shared by all threads and the slabs all nodes are carved from.
+ */
+class Depot {
+public:
+    static Depot& Get()
+    {
+        // Never destroyed, nodes owned by static objects may be freed after the destructors of function-local statics.
+        static Depot* depot = new Depot();
+        return *depot;
+    }
+
+    /**
+     * Moves a batch of free nodes of @p sizeClass to @p list, carving a new slab if the depot has none. The nodes of a
+     * new slab beyond the batch go to the depot, so that a thread never holds more than a batch after a refill.
+     */
+    void Refill(size_t sizeClass, FreeList& list)
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (lists[sizeClass].MoveTo(list, BATCH_NODES) != 0) {
+            return;
+        }
+        size_t nodeSize = NodeSizeOf(sizeClass);
+        size_t nodeNum = NodesPerSlab(sizeClass);
+        auto slab = static_cast<char*>(::operator new(nodeNum * nodeSize));
+        slabs[sizeClass].emplace_back(slab);
+        // Pushed backwards, so that nodes are handed out in address order.
+        size_t batch = std::min(nodeNum, BATCH_NODES);
+        for (size_t i = nodeNum; i > batch; --i) {
+            lists[sizeClass].Push(slab + (i - 1) * nodeSize);
+        }
+        for (size_t i = batch; i > 0; --i) {
+            list.Push(slab + (i - 1) * nodeSize);
+        }
+    }
+
+    /** Moves a batch of free nodes of @p sizeClass from @p list to the depot. */
+    void Release(size_t sizeClass, FreeList& list)
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        list.MoveTo(lists[sizeClass], BATCH_NODES);
+    }
+
+    /** Moves all free nodes of @p cache to the depot. */
+    void ReleaseAll(ThreadCache& cache)
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        for (size_t sizeClass = 0; sizeClass < SIZE_CLASSES; ++sizeClass) {
+            cache.lists[sizeClass].MoveTo(lists[sizeClass], cache.lists[sizeClass].count);
+        }
+    }
+
+    /** Frees the slabs whose nodes are all in the depot, returns the number of freed bytes. */
+    size_t FreeUnusedSlabs()
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        size_t freedBytes = 0;
+        for (size_t sizeClass = 0; sizeClass < SIZE_CLASSES; ++sizeClass) {
+            size_t nodeNum = NodesPerSlab(sizeClass);
+            size_t slabBytes = nodeNum * NodeSizeOf(sizeClass);
+            if (lists[sizeClass].count < nodeNum) {
+                continue;
+            }
+            std::vector<char*> nodes;
+            nodes.reserve(lists[sizeClass].count);
+            while (lists[sizeClass].head != nullptr) {
+                nodes.emplace_back(static_cast<char*>(lists[sizeClass].Pop()));
+            }
+            std::sort(nodes.begin(), nodes.end());
+            std::sort(slabs[sizeClass].begin(), slabs[sizeClass].end());
+            // Both vectors are sorted, so one sweep finds the free nodes of each slab. Free nodes are distinct, so a
+            // slab is unused if it contains as many free nodes as it has nodes.
+            std::vector<char*> keptSlabs;
+            std::vector<char*> keptNodes;
+            keptNodes.reserve(nodes.size());
+            auto first = nodes.begin();
+            for (auto slab : slabs[sizeClass]) {
+                auto slabFirst = std::lower_bound(first, nodes.end(), slab);
+                auto last = std::lower_bound(slabFirst, nodes.end(), slab + slabBytes);
+                keptNodes.insert(keptNodes.end(), first, slabFirst);
+                first = last;
+                if (static_cast<size_t>(last - slabFirst) != nodeNum) {
+                    keptSlabs.emplace_back(slab);
+                    keptNodes.insert(keptNodes.end(), slabFirst, last);
+                    continue;
+                }
+                ::operator delete(slab);
+                freedBytes += slabBytes;
+            }
+            keptNodes.insert(keptNodes.end(), first, nodes.end());
+            slabs[sizeClass] = std::move(keptSlabs);
+            // Pushed backwards, so that nodes are handed out in address order.
+            for (auto it = keptNodes.rbegin(); it != keptNodes.rend(); ++it) {
+                lists[sizeClass].Push(*it);
+            }
+        }
+        return freedBytes;
+    }
+
+private:
+    Depot() = default;
+
+    std::mutex mtx;
+    FreeList lists[SIZE_CLASSES];
+    /** The slabs of each size class. */
+    std::vector<char*> slabs[SIZE_CLASSES];
+};
+
+/**
+ * Moves the free nodes of a thread to the depot when the thread exits. It is constructed on the first refill or free
+ * of the thread. Nodes freed by destructors running after it are left in the cache and not reused.
+ */
+struct ThreadCacheFlusher {
+    ~ThreadCacheFlusher()
+    {
+        Depot::Get().ReleaseAll(g_threadCache);
+    }
+};
+
+thread_local bool g_flusherRegistered = false;
+thread_local ThreadCacheFlusher g_threadCacheFlusher;
+
+inline void RegisterThreadCacheFlusher()
+{
+    if (!g_flusherRegistered) {
+        g_flusherRegistered = true;
+        // The first use of a thread-local object with a destructor registers the destructor for thread exit.
+        (void)&g_threadCacheFlusher;
+    }
+}
+
+inline size_t SizeClassOf(size_t size)
+{
+    return (std::max(size, static_cast<size_t>(1)) - 1) / GRANULE;
+}
+} // namespace
+
+void* NodeAllocator::Allocate(size_t size)
+{
+#ifndef CANGJIE_AST_NODE_POOL_DISABLED
+    if (size <= MAX_POOLED_SIZE) {
+        size_t sizeClass = SizeClassOf(size);
+        FreeList& list = g_threadCache.lists[sizeClass];
+        if (list.head == nullptr) {
+            RegisterThreadCacheFlusher();
+            Depot::Get().Refill(sizeClass, list);
+        }
+        return list.Pop();
+    }
+#endif
+    return ::operator new(size);
+}
+
+void NodeAllocator::Deallocate(void* ptr, size_t size) noexcept
+{
+    if (ptr == nullptr) {
+        return;
+    }
+#ifndef CANGJIE_AST_NODE_POOL_DISABLED
+    if (size <= MAX_POOLED_SIZE) {
+        size_t sizeClass = SizeClassOf(size);
+        FreeList& list = g_threadCache.lists[sizeClass];
+        if (list.head == nullptr) {
+            RegisterThreadCacheFlusher();
+        }
+        list.Push(ptr);
+        if (list.count > MAX_CACHED_NODES) {
+            Depot::Get().Release(sizeClass, list);
+        }
+        return;
+    }
+#endif
+    ::operator delete(ptr);
+}
+
+size_t NodeAllocator::Trim()
+{
+#ifndef CANGJIE_AST_NODE_POOL_DISABLED
+    auto& depot = Depot::Get();
+    depot.ReleaseAll(g_threadCache);
+    return depot.FreeUnusedSlabs();
+#else
+    return 0;
+#endif
+}
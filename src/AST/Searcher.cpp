@@ -14,6 +14,8 @@
 
 #include "cangjie/AST/Searcher.h"
 
+#include <algorithm>
+#include <iterator>
 #include <memory>
 #include <string>
 #include <unordered_set>
@@ -230,7 +232,7 @@ std::set<Symbol*> PosSearchApi::GetIDsGreaterThanPos(const Trie& posTrie, const
             startIter = n->next.upper_bound(posStr[n->depth]);
         }
         for (auto it = startIter; it != n->next.end(); ++it) {
-            ids = Searcher::Union(ids, it->second->ids);
+            ids.insert(it->second->ids.cbegin(), it->second->ids.cend());
         }
         n = n->parent;
     }
@@ -250,7 +252,7 @@ void PosSearchApi::GetIDsLessThanPosOfDepth(
         }
     }
     for (auto it = n.next.cbegin(); it != endIter; ++it) {
-        ids = Searcher::Union(ids, it->second->ids);
+        ids.insert(it->second->ids.cbegin(), it->second->ids.cend());
     }
 }
 
@@ -278,8 +280,10 @@ std::set<Symbol*> PosSearchApi::GetIDsWithinPosXByRange(
     if (endPos <= startPos) {
         return ids;
     }
-    ids = GetIDsGreaterThanPos(posTrie, startPos, isLeftClose);
-    ids = Searcher::Intersection(ids, GetIDsLessThanPos(posTrie, endPos, isRightClose));
+    auto greater = GetIDsGreaterThanPos(posTrie, startPos, isLeftClose);
+    auto less = GetIDsLessThanPos(posTrie, endPos, isRightClose);
+    std::set_intersection(
+        greater.cbegin(), greater.cend(), less.cbegin(), less.cend(), std::inserter(ids, ids.end()));
     return ids;
 }
 
@@ -328,7 +332,7 @@ std::pair<std::vector<Symbol*>, bool> Searcher::FindInSearchCache(
 }
 
 std::vector<Symbol*> Searcher::FilterAndSortSearchResult(
-    const std::set<Symbol*>& ids, const Query& query, const Order& order) const
+    const SymbolIDs& ids, const Query& query, const Order& order) const
 {
     std::vector<Symbol*> results;
     bool needFilter = !query.fileHashes.empty();
@@ -352,7 +356,7 @@ std::vector<Symbol*> Searcher::Search(const ASTContext& ctx, const Query* query,
     if (ret.second) {
         return ret.first;
     }
-    std::set<Symbol*> ids = PerformSearch(ctx, *query);
+    SymbolIDs ids = PerformSearch(ctx, *query);
     auto results = FilterAndSortSearchResult(ids, *query, order);
     cache.insert_or_assign(normalizedQuery, results);
     return results;
@@ -373,44 +377,40 @@ std::vector<Symbol*> Searcher::Search(
     return symbols;
 }
 
-std::set<Symbol*> Searcher::GetIDsByName(const ASTContext& ctx, const std::string& name) const
+namespace {
+template <typename Map, typename Key>
+std::vector<Symbol*> GetPosting(const Map& indexes, const Key& key)
 {
-    std::set<Symbol*> ids;
-    auto it = ctx.invertedIndex.nameIndexes.find(name);
-    if (it != ctx.invertedIndex.nameIndexes.end()) {
-        ids.insert(it->second.begin(), it->second.end());
+    auto it = indexes.find(key);
+    if (it == indexes.end()) {
+        return {};
     }
-    return ids;
+    // The std::set is ordered by address already.
+    return std::vector<Symbol*>(it->second.cbegin(), it->second.cend());
 }
+} // namespace
 
-std::set<Symbol*> Searcher::GetIDsByNamePrefix(const ASTContext& ctx, const std::string& prefix) const
+Searcher::SymbolIDs Searcher::GetIDsByName(const ASTContext& ctx, const std::string& name) const
 {
-    std::set<Symbol*> ids;
-    std::vector<std::string> names = ctx.invertedIndex.nameTrie->PrefixMatch(prefix);
-    for (std::string& name : names) {
-        ids = Union(ids, GetIDsByName(ctx, name));
-    }
-    return ids;
+    return GetPosting(ctx.invertedIndex.nameIndexes, name);
 }
 
-std::set<Symbol*> Searcher::GetIDsByNameSuffix(const ASTContext& ctx, const std::string& suffix) const
+Searcher::SymbolIDs Searcher::GetIDsByNames(const ASTContext& ctx, const std::vector<std::string>& names) const
 {
-    std::set<Symbol*> ids;
-    std::vector<std::string> names = ctx.invertedIndex.nameTrie->SuffixMatch(suffix);
-    for (std::string& name : names) {
-        ids = Union(ids, GetIDsByName(ctx, name));
+    std::vector<const std::set<Symbol*>*> postings;
+    postings.reserve(names.size());
+    for (auto& name : names) {
+        auto it = ctx.invertedIndex.nameIndexes.find(name);
+        if (it != ctx.invertedIndex.nameIndexes.end()) {
+            postings.emplace_back(&it->second);
+        }
     }
-    return ids;
+    return UnionAll(postings);
 }
 
-std::set<Symbol*> Searcher::GetIDsByScopeName(const ASTContext& ctx, const std::string& scopeName) const
+Searcher::SymbolIDs Searcher::GetIDsByScopeName(const ASTContext& ctx, const std::string& scopeName) const
 {
-    std::set<Symbol*> ids;
-    auto it = ctx.invertedIndex.scopeNameIndexes.find(scopeName);
-    if (it != ctx.invertedIndex.scopeNameIndexes.end()) {
-        ids.insert(it->second.begin(), it->second.end());
-    }
-    return ids;
+    return GetPosting(ctx.invertedIndex.scopeNameIndexes, scopeName);
 }
 
 void Searcher::InvalidateCacheBut(const std::string& query)
@@ -429,24 +429,14 @@ std::vector<std::string> Searcher::GetScopeNamesByPrefix(const ASTContext& ctx,
     return ctx.invertedIndex.scopeNameTrie->PrefixMatch(prefix);
 }
 
-std::set<Symbol*> Searcher::GetIDsByScopeLevel(const ASTContext& ctx, uint32_t scopeLevel) const
+Searcher::SymbolIDs Searcher::GetIDsByScopeLevel(const ASTContext& ctx, uint32_t scopeLevel) const
 {
-    std::set<Symbol*> ids;
-    auto it = ctx.invertedIndex.scopeLevelIndexes.find(scopeLevel);
-    if (it != ctx.invertedIndex.scopeLevelIndexes.end()) {
-        ids.insert(it->second.begin(), it->second.end());
-    }
-    return ids;
+    return GetPosting(ctx.invertedIndex.scopeLevelIndexes, scopeLevel);
 }
 
-std::set<Symbol*> Searcher::GetIDsByASTKind(const ASTContext& ctx, const std::string& astKind) const
+Searcher::SymbolIDs Searcher::GetIDsByASTKind(const ASTContext& ctx, const std::string& astKind) const
 {
-    std::set<Symbol*> ids;
-    auto it = ctx.invertedIndex.astKindIndexes.find(astKind);
-    if (it != ctx.invertedIndex.astKindIndexes.end()) {
-        ids.insert(it->second.begin(), it->second.end());
-    }
-    return ids;
+    return GetPosting(ctx.invertedIndex.astKindIndexes, astKind);
 }
 
 std::vector<std::string> Searcher::GetAstKindsBySuffix(const ASTContext& ctx, const std::string& suffix) const
@@ -454,7 +444,7 @@ std::vector<std::string> Searcher::GetAstKindsBySuffix(const ASTContext& ctx, co
     return ctx.invertedIndex.astKindTrie->SuffixMatch(suffix);
 }
 
-std::set<Symbol*> Searcher::GetIDsByPosEQ(
+Searcher::SymbolIDs Searcher::GetIDsByPosEQ(
     const ASTContext& ctx, const Position& pos, bool isLeftClose, bool isRightClose) const
 {
     // Equivalent to finding symbol n whose position meets n->node->begin <= pos && pos < n->node->end.
@@ -466,18 +456,20 @@ std::set<Symbol*> Searcher::GetIDsByPosEQ(
     if (ctx.invertedIndex.posEndTrie != nullptr) {
         ids1 = PosSearchApi::GetIDsGreaterThanPos(*ctx.invertedIndex.posEndTrie, pos, isRightClose);
     }
+    SymbolIDs result;
     if (!ids1.empty()) {
-        return Intersection(ids, ids1);
+        std::set_intersection(
+            ids.cbegin(), ids.cend(), ids1.cbegin(), ids1.cend(), std::back_inserter(result));
+        return result;
     }
     // We use scope_level to filter the node contain the pos.
     if (ids.empty()) {
         return {};
     }
-    std::set<Symbol*> result;
     int scopeLevel = static_cast<int>((*ids.cbegin())->scopeLevel);
     for (auto id : ids) {
         if (scopeLevel >= 0) {
-            result.insert(id);
+            result.emplace_back(id);
             scopeLevel--;
         } else {
             break;
@@ -486,12 +478,13 @@ std::set<Symbol*> Searcher::GetIDsByPosEQ(
     return result;
 }
 
-std::set<Symbol*> Searcher::GetIDsByPosLT(const ASTContext& ctx, const Position& pos, bool contain) const
+Searcher::SymbolIDs Searcher::GetIDsByPosLT(const ASTContext& ctx, const Position& pos, bool contain) const
 {
     // Equivalent to finding symbol n whose position meets n->node->begin <= pos && pos < n->node->end.
-    std::set<Symbol*> ids;
+    SymbolIDs ids;
     if (ctx.invertedIndex.posEndTrie != nullptr) {
-        ids = PosSearchApi::GetIDsLessThanPos(*ctx.invertedIndex.posEndTrie, pos, false);
+        auto less = PosSearchApi::GetIDsLessThanPos(*ctx.invertedIndex.posEndTrie, pos, false);
+        ids.assign(less.cbegin(), less.cend());
     }
     if (contain) {
         ids = Union(ids, GetIDsByPosEQ(ctx, pos));
@@ -499,12 +492,13 @@ std::set<Symbol*> Searcher::GetIDsByPosLT(const ASTContext& ctx, const Position&
     return ids;
 }
 
-std::set<Symbol*> Searcher::GetIDsByPosGT(const ASTContext& ctx, const Position& pos, bool contain) const
+Searcher::SymbolIDs Searcher::GetIDsByPosGT(const ASTContext& ctx, const Position& pos, bool contain) const
 {
     // Equivalent to finding symbol n whose position meets n->node->begin > pos && pos <= n->node->end.
-    std::set<Symbol*> ids;
+    SymbolIDs ids;
     if (ctx.invertedIndex.posBeginTrie != nullptr) {
-        ids = PosSearchApi::GetIDsGreaterThanPos(*ctx.invertedIndex.posBeginTrie, pos, false);
+        auto greater = PosSearchApi::GetIDsGreaterThanPos(*ctx.invertedIndex.posBeginTrie, pos, false);
+        ids.assign(greater.cbegin(), greater.cend());
     }
     if (contain) {
         ids = Union(ids, GetIDsByPosEQ(ctx, pos));
@@ -512,9 +506,9 @@ std::set<Symbol*> Searcher::GetIDsByPosGT(const ASTContext& ctx, const Position&
     return ids;
 }
 
-std::set<Symbol*> Searcher::PerformSearch(const ASTContext& ctx, const Query& query)
+Searcher::SymbolIDs Searcher::PerformSearch(const ASTContext& ctx, const Query& query)
 {
-    std::set<Symbol*> ids;
+    SymbolIDs ids;
     if (query.type == QueryType::OP) {
         if (!query.left || !query.right) {
             return {};
@@ -535,9 +529,9 @@ std::set<Symbol*> Searcher::PerformSearch(const ASTContext& ctx, const Query& qu
     return ids;
 }
 
-std::set<Symbol*> Searcher::GetIDsByPos(const ASTContext& ctx, const Query& query) const
+Searcher::SymbolIDs Searcher::GetIDsByPos(const ASTContext& ctx, const Query& query) const
 {
-    std::set<Symbol*> ids;
+    SymbolIDs ids;
     if (query.type != QueryType::POS) {
         return ids;
     }
@@ -555,25 +549,25 @@ std::set<Symbol*> Searcher::GetIDsByPos(const ASTContext& ctx, const Query& quer
     return ids;
 }
 
-std::set<Symbol*> Searcher::GetIDsByName(const ASTContext& ctx, const Query& query) const
+Searcher::SymbolIDs Searcher::GetIDsByName(const ASTContext& ctx, const Query& query) const
 {
-    std::set<Symbol*> ids;
+    SymbolIDs ids;
     if (query.key != "name") {
         return ids;
     }
     if (query.matchKind == MatchKind::PRECISE) {
         ids = GetIDsByName(ctx, query.value);
     } else if (query.matchKind == MatchKind::PREFIX) {
-        ids = GetIDsByNamePrefix(ctx, query.value);
+        ids = GetIDsByNames(ctx, ctx.invertedIndex.nameTrie->PrefixMatch(query.value));
     } else {
-        ids = GetIDsByNameSuffix(ctx, query.value);
+        ids = GetIDsByNames(ctx, ctx.invertedIndex.nameTrie->SuffixMatch(query.value));
     }
     return ids;
 }
 
-std::set<Symbol*> Searcher::GetIDsByScopeLevel(const ASTContext& ctx, const Query& query) const
+Searcher::SymbolIDs Searcher::GetIDsByScopeLevel(const ASTContext& ctx, const Query& query) const
 {
-    std::set<Symbol*> ids;
+    SymbolIDs ids;
     constexpr int decimalBase = 10;
     if (query.key != "scope_level") {
         return ids;
@@ -583,59 +577,67 @@ std::set<Symbol*> Searcher::GetIDsByScopeLevel(const ASTContext& ctx, const Quer
         if (level < UINT32_MAX) {
             ids = GetIDsByScopeLevel(ctx, static_cast<uint32_t>(level));
         }
-    } else if (query.sign == "<") {
-        for (uint32_t scopelevel = 0; scopelevel < std::strtoul(query.value.c_str(), nullptr, decimalBase);
-            ++scopelevel) {
-            ids = Union(ids, GetIDsByScopeLevel(ctx, scopelevel));
-        }
-    } else if (query.sign == "<=") {
-        for (uint32_t scopelevel = 0; scopelevel <= std::strtoul(query.value.c_str(), nullptr, decimalBase);
-            ++scopelevel) {
-            ids = Union(ids, GetIDsByScopeLevel(ctx, scopelevel));
+    } else if (query.sign == "<" || query.sign == "<=") {
+        auto bound = std::strtoul(query.value.c_str(), nullptr, decimalBase);
+        std::vector<const std::set<Symbol*>*> postings;
+        // Only the levels present in the index are visited, instead of every level below the bound.
+        for (auto& [level, posting] : ctx.invertedIndex.scopeLevelIndexes) {
+            if (level < bound || (query.sign == "<=" && level == bound)) {
+                postings.emplace_back(&posting);
+            }
         }
+        ids = UnionAll(postings);
     }
     return ids;
 }
 
-std::set<Symbol*> Searcher::GetIDsByScopeName(const ASTContext& ctx, const Query& query) const
+Searcher::SymbolIDs Searcher::GetIDsByScopeName(const ASTContext& ctx, const Query& query) const
 {
-    std::set<Symbol*> ids;
+    SymbolIDs ids;
     if (query.key != "scope_name") {
         return ids;
     }
     if (query.matchKind == MatchKind::PRECISE) {
         ids = GetIDsByScopeName(ctx, query.value);
     } else if (query.matchKind == MatchKind::PREFIX) {
-        auto scopeNames = GetScopeNamesByPrefix(ctx, query.value);
-        for (auto& n : scopeNames) {
-            ids = Union(ids, GetIDsByScopeName(ctx, n));
+        std::vector<const std::set<Symbol*>*> postings;
+        for (auto& n : GetScopeNamesByPrefix(ctx, query.value)) {
+            auto it = ctx.invertedIndex.scopeNameIndexes.find(n);
+            if (it != ctx.invertedIndex.scopeNameIndexes.end()) {
+                postings.emplace_back(&it->second);
+            }
         }
+        ids = UnionAll(postings);
     } else {
         ctx.diag.DiagnoseRefactor(DiagKindRefactor::searcher_invalid_scope_name, DEFAULT_POSITION, query.value);
     }
     return ids;
 }
 
-std::set<Symbol*> Searcher::GetIDsByASTKind(const ASTContext& ctx, const Query& query) const
+Searcher::SymbolIDs Searcher::GetIDsByASTKind(const ASTContext& ctx, const Query& query) const
 {
-    std::set<Symbol*> ids;
+    SymbolIDs ids;
     if (query.key != "ast_kind") {
         return ids;
     }
     if (query.matchKind == MatchKind::PRECISE) {
         ids = GetIDsByASTKind(ctx, query.value);
     } else if (query.matchKind == MatchKind::SUFFIX) {
-        auto astKinds = GetAstKindsBySuffix(ctx, query.value);
-        for (auto& n : astKinds) {
-            ids = Union(ids, GetIDsByASTKind(ctx, n));
+        std::vector<const std::set<Symbol*>*> postings;
+        for (auto& n : GetAstKindsBySuffix(ctx, query.value)) {
+            auto it = ctx.invertedIndex.astKindIndexes.find(n);
+            if (it != ctx.invertedIndex.astKindIndexes.end()) {
+                postings.emplace_back(&it->second);
+            }
         }
+        ids = UnionAll(postings);
     }
     return ids;
 }
 
-std::set<Symbol*> Searcher::GetIDs(const ASTContext& ctx, const Query& query) const
+Searcher::SymbolIDs Searcher::GetIDs(const ASTContext& ctx, const Query& query) const
 {
-    std::set<Symbol*> ids;
+    SymbolIDs ids;
     if (query.type == QueryType::POS) {
         ids = GetIDsByPos(ctx, query);
     } else {
@@ -681,24 +683,46 @@ unsigned long Searcher::StrToUint(const ASTContext& ctx, const std::string& quer
     return uintValue;
 }
 
-std::set<Symbol*> Searcher::Intersection(const std::set<Symbol*>& set1, const std::set<Symbol*>& set2)
+Searcher::SymbolIDs Searcher::Intersection(const SymbolIDs& set1, const SymbolIDs& set2)
+{
+    SymbolIDs ret;
+    ret.reserve(std::min(set1.size(), set2.size()));
+    std::set_intersection(set1.cbegin(), set1.cend(), set2.cbegin(), set2.cend(), std::back_inserter(ret));
+    return ret;
+}
+
+Searcher::SymbolIDs Searcher::Union(const SymbolIDs& set1, const SymbolIDs& set2)
 {
-    std::set<Symbol*> ret;
-    std::set_intersection(set1.begin(), set1.end(), set2.begin(), set2.end(), std::inserter(ret, ret.begin()));
+    SymbolIDs ret;
+    ret.reserve(set1.size() + set2.size());
+    std::set_union(set1.cbegin(), set1.cend(), set2.cbegin(), set2.cend(), std::back_inserter(ret));
     return ret;
 }
 
-std::set<Symbol*> Searcher::Union(const std::set<Symbol*>& set1, const std::set<Symbol*>& set2)
+Searcher::SymbolIDs Searcher::Difference(const SymbolIDs& set1, const SymbolIDs& set2)
 {
-    std::set<Symbol*> ret;
-    std::set_union(set1.begin(), set1.end(), set2.begin(), set2.end(), std::inserter(ret, ret.begin()));
+    SymbolIDs ret;
+    ret.reserve(set1.size());
+    std::set_difference(set1.cbegin(), set1.cend(), set2.cbegin(), set2.cend(), std::back_inserter(ret));
     return ret;
 }
 
-std::set<Symbol*> Searcher::Difference(const std::set<Symbol*>& set1, const std::set<Symbol*>& set2) const
+Searcher::SymbolIDs Searcher::UnionAll(const std::vector<const std::set<Symbol*>*>& postings)
 {
-    std::set<Symbol*> ret;
-    std::set_difference(set1.begin(), set1.end(), set2.begin(), set2.end(), std::inserter(ret, ret.begin()));
+    if (postings.size() == 1) {
+        return SymbolIDs(postings[0]->cbegin(), postings[0]->cend());
+    }
+    size_t total = 0;
+    for (auto posting : postings) {
+        total += posting->size();
+    }
+    SymbolIDs ret;
+    ret.reserve(total);
+    for (auto posting : postings) {
+        ret.insert(ret.end(), posting->cbegin(), posting->cend());
+    }
+    std::sort(ret.begin(), ret.end());
+    ret.erase(std::unique(ret.begin(), ret.end()), ret.end());
     return ret;
 }
 
@@ -74,8 +74,8 @@ void SourceManager::SaveSourceFile(
     uint64_t fileHash,
     std::optional<std::string> packageName)
 {
-    sources.emplace_back(fileID, normalizedPath, buffer, fileHash, packageName);
     filePathToFileIDMap.emplace(normalizedPath, fileID);
+    sources.emplace_back(fileID, std::move(normalizedPath), std::move(buffer), fileHash, std::move(packageName));
 }
 
 void SourceManager::ReserveCommonPartSources(std::vector<std::string> files)
@@ -108,6 +108,31 @@ unsigned int SourceManager::AddSource(
     }
 }
 
+unsigned int SourceManager::ReserveSource(const std::string& path, std::optional<std::string> packageName)
+{
+    std::string normalizePath = FileUtil::Normalize(path);
+    uint64_t fileHash = Utils::GetHash(normalizePath);
+    auto existed = filePathToFileIDMap.find(normalizePath);
+    if (existed != filePathToFileIDMap.end()) {
+        unsigned int fileID = static_cast<unsigned int>(existed->second);
+        CJC_ASSERT(static_cast<size_t>(fileID) < sources.size());
+        sources[fileID].fileHash = fileHash;
+        sources[fileID].packageName = std::move(packageName);
+        return fileID;
+    }
+    auto fileID = static_cast<unsigned int>(sources.size());
+    SaveSourceFile(fileID, std::move(normalizePath), "", fileHash, std::move(packageName));
+    return fileID;
+}
+
+void SourceManager::SetSourceBuffer(unsigned int fileID, std::string&& buffer)
+{
+    CJC_ASSERT(fileID > 0 && static_cast<size_t>(fileID) < sources.size());
+    auto& source = sources[fileID];
+    // Rebuild the source so that line offsets and comments of a previous content are dropped.
+    source = Source{fileID, std::move(source.path), std::move(buffer), source.fileHash, source.packageName};
+}
+
 unsigned int SourceManager::AppendSource(const std::string& path, const std::string& buffer)
 {
     // path canonicalize
@@ -0,0 +1,41 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+// The Cangjie API is in Beta. For details on its capabilities and limitations, please refer to the README file.
+
+#include "cangjie/CHIR/Analysis/AnalysisManager.h"
+
+using namespace Cangjie::CHIR;
+
+void AnalysisManager::MarkChanged(const Func& func)
+{
+    std::lock_guard<std::mutex> lock(mtx);
+    changeLog.emplace_back(&func);
+}
+
+void AnalysisManager::MarkAllChanged()
+{
+    std::lock_guard<std::mutex> lock(mtx);
+    changeLog.emplace_back(nullptr);
+}
+
+void AnalysisManager::Synchronize(AnalysisResultCache& cache)
+{
+    std::lock_guard<std::mutex> lock(mtx);
+    auto& synced = syncedLength[&cache];
+    // Changes before the last time all functions were marked need not be replayed.
+    size_t begin = changeLog.size();
+    while (begin > synced && changeLog[begin - 1] != nullptr) {
+        --begin;
+    }
+    if (begin > synced) {
+        cache.InvalidateAllAnalysisResults();
+    }
+    for (size_t i = begin; i < changeLog.size(); ++i) {
+        (void)cache.InvalidateAnalysisResult(changeLog[i]);
+    }
+    synced = changeLog.size();
+}
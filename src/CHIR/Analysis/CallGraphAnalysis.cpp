@@ -77,16 +77,6 @@ CallGraph::Edge::Edge(Node* n, Kind k)
     edgeValue = std::make_pair(n, k);
 }
 
-inline CallGraph::Node* CallGraph::Edge::GetNode() const
-{
-    return edgeValue.first;
-}
-
-inline CallGraph::Edge::Kind CallGraph::Edge::GetKind() const
-{
-    return edgeValue.second;
-}
-
 bool CallGraph::Edge::operator==(const Edge& other) const
 {
     return this->edgeValue.first == other.edgeValue.first;
@@ -287,12 +277,30 @@ void CallGraphAnalysis::BuildSCC(const CallGraph& callGraph)
     DFSVisitOne(*callGraph.GetEntryNode());
     do {
         GetNextSCC();
+        std::vector<Func*> scc;
         for (unsigned i = 0; i < currentSCC.size(); i++) {
             postOrderSCCFunctionlist.push_back(currentSCC[i]->GetFunction());
+            if (auto func = currentSCC[i]->GetFunction()) {
+                scc.push_back(func);
+                CollectDirectCallees(*currentSCC[i]);
+            }
+        }
+        if (!scc.empty()) {
+            postOrderSCCs.emplace_back(std::move(scc));
         }
     } while (!currentSCC.empty());
 }
 
+void CallGraphAnalysis::CollectDirectCallees(const CallGraph::Node& node)
+{
+    auto& callees = directCallees[node.GetFunction()];
+    for (auto it = node.Begin(); it != node.End(); ++it) {
+        if (it->GetKind() == CallGraph::Edge::Kind::DIRECT && it->GetNode()->GetFunction()) {
+            callees.push_back(it->GetNode()->GetFunction());
+        }
+    }
+}
+
 void CallGraphAnalysis::DFSVisitOne(CallGraph::Node& node)
 {
     ++visitNum;
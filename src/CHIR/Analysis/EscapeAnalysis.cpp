@@ -0,0 +1,160 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+// The Cangjie API is in Beta. For details on its capabilities and limitations, please refer to the README file.
+
+#include "cangjie/CHIR/Analysis/EscapeAnalysis.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+#include "cangjie/CHIR/CHIRCasting.h"
+#include "cangjie/CHIR/Expression/Terminator.h"
+
+using namespace Cangjie::CHIR;
+
+namespace {
+/// A lambda may run after its function returns, so every reference it uses escapes.
+bool IsInLambda(const Expression& expr)
+{
+    auto blockGroup = expr.GetParentBlockGroup();
+    while (blockGroup != nullptr && blockGroup->GetOwnerFunc() == nullptr) {
+        auto owner = blockGroup->GetOwnerExpression();
+        if (owner == nullptr) {
+            return false;
+        }
+        if (owner->GetExprKind() == ExprKind::LAMBDA) {
+            return true;
+        }
+        blockGroup = owner->GetParentBlockGroup();
+    }
+    return false;
+}
+} // namespace
+
+void EscapeAnalysis::RunOnPackage(const Package& package, const CallGraphAnalysis& callGraph)
+{
+    for (auto& scc : callGraph.postOrderSCCs) {
+        for (auto func : scc) {
+            paramEscapes[func] = std::vector<bool>(func->GetParams().size(), false);
+        }
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            for (auto func : scc) {
+                changed = Summarize(*func) || changed;
+            }
+        }
+    }
+    // Functions missing from the call graph are summarized once, calls among them are treated as escaping.
+    for (auto func : package.GetGlobalFuncs()) {
+        if (paramEscapes.find(func) == paramEscapes.end()) {
+            Summarize(*func);
+        }
+    }
+}
+
+bool EscapeAnalysis::Summarize(const Func& func)
+{
+    auto& params = func.GetParams();
+    std::vector<bool> escapes(params.size(), true);
+    if (func.GetBody() != nullptr) {
+        for (size_t i = 0; i < params.size(); ++i) {
+            escapes[i] = !params[i]->GetType()->IsRef() || IsEscaping(*params[i]);
+        }
+    }
+    auto& summary = paramEscapes[&func];
+    if (summary == escapes) {
+        return false;
+    }
+    summary = std::move(escapes);
+    return true;
+}
+
+bool EscapeAnalysis::IsParamEscaping(const Func& func, size_t index) const
+{
+    auto it = paramEscapes.find(&func);
+    return it == paramEscapes.end() || index >= it->second.size() || it->second[index];
+}
+
+size_t EscapeAnalysis::GetNonEscapingParamNum() const
+{
+    size_t num = 0;
+    for (auto& [func, escapes] : paramEscapes) {
+        num += static_cast<size_t>(std::count(escapes.begin(), escapes.end(), false));
+    }
+    return num;
+}
+
+bool EscapeAnalysis::IsEscapingThroughCall(const Expression& call, const Value& ref) const
+{
+    Value* callee = nullptr;
+    std::vector<Value*> args;
+    if (call.GetExprKind() == ExprKind::APPLY) {
+        auto apply = StaticCast<const Apply*>(&call);
+        callee = apply->GetCallee();
+        args = apply->GetArgs();
+    } else {
+        auto apply = StaticCast<const ApplyWithException*>(&call);
+        callee = apply->GetCallee();
+        args = apply->GetArgs();
+    }
+    auto func = DynamicCast<Func*>(callee);
+    if (callee == &ref || func == nullptr) {
+        return true;
+    }
+    for (size_t i = 0; i < args.size(); ++i) {
+        if (args[i] == &ref && IsParamEscaping(*func, i)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool EscapeAnalysis::IsEscaping(const Value& ref) const
+{
+    std::vector<const Value*> worklist{&ref};
+    std::unordered_set<const Value*> visited{&ref};
+    while (!worklist.empty()) {
+        auto value = worklist.back();
+        worklist.pop_back();
+        for (auto user : value->GetUsers()) {
+            if (IsInLambda(*user)) {
+                return true;
+            }
+            switch (user->GetExprKind()) {
+                case ExprKind::DEBUGEXPR:
+                case ExprKind::LOAD:
+                    break;
+                case ExprKind::GET_ELEMENT_REF:
+                    // A reference into the memory escapes with it.
+                    if (visited.emplace(user->GetResult()).second) {
+                        worklist.emplace_back(user->GetResult());
+                    }
+                    break;
+                case ExprKind::STORE:
+                    if (StaticCast<Store*>(user)->GetValue() == value) {
+                        return true;
+                    }
+                    break;
+                case ExprKind::STORE_ELEMENT_REF:
+                    if (StaticCast<StoreElementRef*>(user)->GetValue() == value) {
+                        return true;
+                    }
+                    break;
+                case ExprKind::APPLY:
+                case ExprKind::APPLY_WITH_EXCEPTION:
+                    if (IsEscapingThroughCall(*user, *value)) {
+                        return true;
+                    }
+                    break;
+                default:
+                    return true;
+            }
+        }
+    }
+    return false;
+}
@@ -0,0 +1,198 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+// The Cangjie API is in Beta. For details on its capabilities and limitations, please refer to the README file.
+
+/**
+ * @file
+ *
+ * This file implements the dominator tree, by the iterative algorithm of Cooper, Harvey and Kennedy, and the natural
+ * loops of a BlockGroup.
+ */
+
+#include "cangjie/CHIR/Analysis/LoopAnalysis.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "cangjie/CHIR/Expression/Terminator.h"
+
+using namespace Cangjie::CHIR;
+
+namespace {
+std::vector<Block*> ComputeReversePostOrder(Block& entry)
+{
+    std::vector<Block*> postOrder;
+    std::unordered_set<const Block*> visited{&entry};
+    // Each frame is a block and the index of its next successor to visit.
+    std::vector<std::pair<Block*, size_t>> stack{{&entry, 0}};
+    while (!stack.empty()) {
+        auto& [block, next] = stack.back();
+        auto terminator = block->GetTerminator();
+        if (terminator != nullptr && next < terminator->GetNumOfSuccessor()) {
+            auto succ = terminator->GetSuccessor(next++);
+            if (visited.emplace(succ).second) {
+                stack.emplace_back(succ, 0);
+            }
+            continue;
+        }
+        postOrder.emplace_back(block);
+        stack.pop_back();
+    }
+    std::reverse(postOrder.begin(), postOrder.end());
+    return postOrder;
+}
+} // namespace
+
+DominatorTree::DominatorTree(const BlockGroup& blockGroup)
+{
+    auto entry = blockGroup.GetEntryBlock();
+    if (entry == nullptr) {
+        return;
+    }
+    rpo = ComputeReversePostOrder(*entry);
+    for (size_t i = 0; i < rpo.size(); ++i) {
+        rpoIndex.emplace(rpo[i], i);
+    }
+    constexpr size_t undefined = std::numeric_limits<size_t>::max();
+    idoms.assign(rpo.size(), undefined);
+    idoms[0] = 0;
+    auto intersect = [this](size_t a, size_t b) {
+        while (a != b) {
+            while (a > b) {
+                a = idoms[a];
+            }
+            while (b > a) {
+                b = idoms[b];
+            }
+        }
+        return a;
+    };
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (size_t i = 1; i < rpo.size(); ++i) {
+            size_t newIDom = undefined;
+            for (auto pred : rpo[i]->GetPredecessors()) {
+                auto it = rpoIndex.find(pred);
+                if (it == rpoIndex.end() || idoms[it->second] == undefined) {
+                    continue;
+                }
+                newIDom = newIDom == undefined ? it->second : intersect(it->second, newIDom);
+            }
+            if (newIDom != idoms[i]) {
+                idoms[i] = newIDom;
+                changed = true;
+            }
+        }
+    }
+}
+
+bool DominatorTree::IsReachable(const Block& block) const
+{
+    return rpoIndex.find(&block) != rpoIndex.end();
+}
+
+Block* DominatorTree::GetIDom(const Block& block) const
+{
+    auto it = rpoIndex.find(&block);
+    if (it == rpoIndex.end() || it->second == 0) {
+        return nullptr;
+    }
+    return rpo[idoms[it->second]];
+}
+
+bool DominatorTree::Dominates(const Block& a, const Block& b) const
+{
+    auto itA = rpoIndex.find(&a);
+    auto itB = rpoIndex.find(&b);
+    if (itA == rpoIndex.end() || itB == rpoIndex.end()) {
+        return false;
+    }
+    // Immediate dominators come earlier in reverse post order, so the walk up the tree stops once it passes a.
+    size_t cur = itB->second;
+    while (cur > itA->second) {
+        cur = idoms[cur];
+    }
+    return cur == itA->second;
+}
+
+Block* NaturalLoop::GetPreheader() const
+{
+    Block* preheader = nullptr;
+    for (auto pred : header->GetPredecessors()) {
+        if (Contains(*pred)) {
+            continue;
+        }
+        if (preheader != nullptr) {
+            return nullptr;
+        }
+        preheader = pred;
+    }
+    if (preheader == nullptr || preheader->GetTerminator() == nullptr ||
+        preheader->GetTerminator()->GetNumOfSuccessor() != 1) {
+        return nullptr;
+    }
+    return preheader;
+}
+
+LoopForest::LoopForest(const DominatorTree& domTree)
+{
+    std::unordered_map<const Block*, NaturalLoop*> loopOfHeader;
+    for (auto block : domTree.GetReversePostOrder()) {
+        for (auto succ : block->GetSuccessors()) {
+            if (!domTree.Dominates(*succ, *block)) {
+                continue;
+            }
+            auto& loop = loopOfHeader[succ];
+            if (loop == nullptr) {
+                loops.emplace_back(std::make_unique<NaturalLoop>());
+                loop = loops.back().get();
+                loop->header = succ;
+                loop->blocks.emplace(succ);
+            }
+            loop->latches.emplace_back(block);
+        }
+    }
+    for (auto& loop : loops) {
+        std::vector<Block*> worklist;
+        for (auto latch : loop->latches) {
+            if (loop->blocks.emplace(latch).second) {
+                worklist.emplace_back(latch);
+            }
+        }
+        while (!worklist.empty()) {
+            auto block = worklist.back();
+            worklist.pop_back();
+            for (auto pred : block->GetPredecessors()) {
+                if (domTree.IsReachable(*pred) && loop->blocks.emplace(pred).second) {
+                    worklist.emplace_back(pred);
+                }
+            }
+        }
+    }
+    // Natural loops with different headers are either disjoint or nested, so the enclosing loops of a loop are the
+    // larger loops containing its header.
+    std::stable_sort(loops.begin(), loops.end(),
+        [](const auto& lhs, const auto& rhs) { return lhs->blocks.size() > rhs->blocks.size(); });
+    for (auto& loop : loops) {
+        auto it = innermostLoops.find(loop->header);
+        if (it != innermostLoops.end()) {
+            loop->parent = it->second;
+            it->second->subLoops.emplace_back(loop.get());
+        }
+        for (auto block : loop->blocks) {
+            innermostLoops[block] = loop.get();
+        }
+    }
+    std::reverse(loops.begin(), loops.end());
+}
+
+NaturalLoop* LoopForest::GetLoopFor(const Block& block) const
+{
+    auto it = innermostLoops.find(&block);
+    return it == innermostLoops.end() ? nullptr : it->second;
+}
@@ -0,0 +1,49 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+// The Cangjie API is in Beta. For details on its capabilities and limitations, please refer to the README file.
+
+#include "cangjie/CHIR/Analysis/PGOProfile.h"
+
+#include <algorithm>
+
+using namespace Cangjie::CHIR;
+
+namespace {
+/// The profile name of a local function is "<file>;<name>", CHIR only knows the name.
+std::string StripFilePrefix(const std::string& name)
+{
+    auto pos = name.rfind(';');
+    return pos == std::string::npos ? name : name.substr(pos + 1);
+}
+} // namespace
+
+void PGOProfile::AddFuncProfile(const std::string& name, const FuncProfile& profile)
+{
+    auto& merged = funcProfiles[StripFilePrefix(name)];
+    merged.maxCount = std::max(merged.maxCount, profile.maxCount);
+    for (auto& [target, count] : profile.callTargets) {
+        merged.callTargets[StripFilePrefix(target)] += count;
+    }
+}
+
+const PGOProfile::FuncProfile* PGOProfile::GetFuncProfile(const FuncBase& func) const
+{
+    auto it = funcProfiles.find(func.GetIdentifierWithoutPrefix());
+    return it == funcProfiles.end() ? nullptr : &it->second;
+}
+
+bool PGOProfile::IsHot(const FuncBase& func) const
+{
+    auto profile = GetFuncProfile(func);
+    return profile != nullptr && profile->maxCount >= hotCountThreshold;
+}
+
+bool PGOProfile::IsCold(const FuncBase& func) const
+{
+    auto profile = GetFuncProfile(func);
+    return profile != nullptr && profile->maxCount == 0;
+}
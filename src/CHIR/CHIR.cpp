@@ -8,8 +8,11 @@
 
 #include "cangjie/CHIR/CHIR.h"
 
+#include <atomic>
+
 #include "cangjie/CHIR/Analysis/CallGraphAnalysis.h"
 #include "cangjie/CHIR/Analysis/DevirtualizationInfo.h"
+#include "cangjie/CHIR/Analysis/EscapeAnalysis.h"
 #include "cangjie/CHIR/CHIRPrinter.h"
 #include "cangjie/CHIR/Checker/ConstSafetyCheck.h"
 #include "cangjie/CHIR/Checker/UnreachableBranchCheck.h"
@@ -21,6 +24,7 @@
 #include "cangjie/CHIR/Serializer/CHIRSerializer.h"
 #include "cangjie/CHIR/Transformation/ArrayLambdaOpt.h"
 #include "cangjie/CHIR/Transformation/ArrayListConstStartOpt.h"
+#include "cangjie/CHIR/Transformation/BottomUpInliner.h"
 #include "cangjie/CHIR/Transformation/BoxRecursionValueType.h"
 #include "cangjie/CHIR/Transformation/ClosureConversion.h"
 #include "cangjie/CHIR/Transformation/ConstPropagation.h"
@@ -28,15 +32,19 @@
 #include "cangjie/CHIR/Transformation/Devirtualization.h"
 #include "cangjie/CHIR/Transformation/FlatForInExpr.h"
 #include "cangjie/CHIR/Transformation/FunctionInline.h"
+#include "cangjie/CHIR/Transformation/FunctionPassManager.h"
 #include "cangjie/CHIR/Transformation/GetRefToArrayElem.h"
+#include "cangjie/CHIR/Transformation/LoopInvariantCodeMotion.h"
 #include "cangjie/CHIR/Transformation/MarkClassHasInited.h"
 #include "cangjie/CHIR/Transformation/MergeBlocks.h"
 #include "cangjie/CHIR/Transformation/NoSideEffectMarker.h"
+#include "cangjie/CHIR/Transformation/NonEscapingAllocateElimination.h"
 #include "cangjie/CHIR/Transformation/RangePropagation.h"
 #include "cangjie/CHIR/Transformation/RedundantFutureRemoval.h"
 #include "cangjie/CHIR/Transformation/RedundantGetOrThrowElimination.h"
 #include "cangjie/CHIR/Transformation/RedundantLoadElimination.h"
 #include "cangjie/CHIR/Transformation/SanitizerCoverage.h"
+#include "cangjie/CHIR/Transformation/ScalarReplacementOfAggregates.h"
 #include "cangjie/CHIR/Transformation/UnitUnify.h"
 #include "cangjie/CHIR/Transformation/UselessAllocateElimination.h"
 #include "cangjie/CHIR/Visitor/Visitor.h"
@@ -326,8 +334,10 @@ void ToCHIR::RedundantLoadElimination()
         return;
     }
     Utils::ProfileRecorder recorder("CHIR Opt", "RedundantLoadElimination");
-    auto rle = CHIR::RedundantLoadElimination();
-    rle.RunOnPackage(chirPkg, opts.chirDebugOptimizer);
+    bool isDebug = opts.chirDebugOptimizer;
+    FunctionPassManager(builder, opts.GetJobs(), &analysisManager)
+        .RunOnPackage(*chirPkg, CHIR::RedundantLoadElimination::SCOPE,
+            [isDebug](Func& func, CHIRBuilder&) { return CHIR::RedundantLoadElimination().RunOnFunc(&func, isDebug); });
     DumpCHIRToFile("RedundantLoadElimination");
 }
 
@@ -337,10 +347,102 @@ void ToCHIR::UselessAllocateElimination()
         return;
     }
     Utils::ProfileRecorder recorder("CHIR Opt", "UselessAllocateElimination");
-    UselessAllocateElimination::RunOnPackage(*chirPkg, opts.chirDebugOptimizer);
+    bool isDebug = opts.chirDebugOptimizer;
+    FunctionPassManager(builder, opts.GetJobs(), &analysisManager)
+        .RunOnPackage(*chirPkg, UselessAllocateElimination::SCOPE,
+            [isDebug](Func& func, CHIRBuilder&) { return UselessAllocateElimination::RunOnFunc(func, isDebug); });
     DumpCHIRToFile("UselessAllocateElimination");
 }
 
+EscapeAnalysis ToCHIR::RunEscapeAnalysis(DevirtualizationInfo& devirtInfo)
+{
+    EscapeAnalysis escapeAnalysis;
+    if (!(opts.chirEA || opts.chirLICM) || opts.interpFullBchir) {
+        return escapeAnalysis;
+    }
+    Utils::ProfileRecorder recorder("CHIR Opt", "EscapeAnalysis");
+    CallGraphAnalysis callGraphAnalysis(chirPkg, devirtInfo);
+    callGraphAnalysis.DoCallGraphAnalysis(opts.chirDebugOptimizer);
+    escapeAnalysis.RunOnPackage(*chirPkg, callGraphAnalysis);
+    if (opts.chirDebugOptimizer) {
+        std::cout << "[EscapeAnalysis] " << escapeAnalysis.GetNonEscapingParamNum() << " non-escaping parameters\n";
+    }
+    return escapeAnalysis;
+}
+
+void ToCHIR::RunNonEscapingAllocateElimination(const EscapeAnalysis& escapeAnalysis)
+{
+    if (!opts.chirEA || opts.interpFullBchir) {
+        return;
+    }
+    Utils::ProfileRecorder recorder("CHIR Opt", "NonEscapingAllocateElimination");
+    auto pass = NonEscapingAllocateElimination(escapeAnalysis);
+    bool isDebug = opts.chirDebugOptimizer;
+    bool enableCompileDebug = opts.enableCompileDebug;
+    std::atomic<size_t> eliminated{0};
+    FunctionPassManager(builder, opts.GetJobs(), &analysisManager)
+        .RunOnPackage(*chirPkg, NonEscapingAllocateElimination::SCOPE,
+            [&pass, &eliminated, isDebug, enableCompileDebug](Func& func, CHIRBuilder& subBuilder) {
+                auto num = pass.RunOnFunc(func, subBuilder, isDebug, enableCompileDebug);
+                eliminated += num;
+                return num != 0;
+            });
+    if (isDebug) {
+        std::cout << "[NonEscapingAllocateElimination] " << eliminated << " heap allocations eliminated\n";
+    }
+    if (opts.enableTimer || opts.enableMemoryCollect) {
+        Utils::ProfileRecorder::RecordCodeInfo(
+            "heap allocation eliminated by escape analysis", static_cast<int64_t>(eliminated.load()));
+    }
+    DumpCHIRToFile("EscapeAnalysis");
+}
+
+void ToCHIR::RunScalarReplacementOfAggregates()
+{
+    if (!opts.IsOptimizationExisted(GlobalOptions::OptimizationFlag::SROA_OPT) || opts.interpFullBchir) {
+        return;
+    }
+    Utils::ProfileRecorder recorder("CHIR Opt", "ScalarReplacementOfAggregates");
+    bool isDebug = opts.chirDebugOptimizer;
+    bool enableCompileDebug = opts.enableCompileDebug;
+    std::atomic<size_t> split{0};
+    FunctionPassManager(builder, opts.GetJobs(), &analysisManager)
+        .RunOnPackage(*chirPkg, ScalarReplacementOfAggregates::SCOPE,
+            [&split, isDebug, enableCompileDebug](Func& func, CHIRBuilder& subBuilder) {
+                auto num = ScalarReplacementOfAggregates::RunOnFunc(func, subBuilder, isDebug, enableCompileDebug);
+                split += num;
+                return num != 0;
+            });
+    if (opts.enableTimer || opts.enableMemoryCollect) {
+        Utils::ProfileRecorder::RecordCodeInfo(
+            "aggregate allocation split by sroa", static_cast<int64_t>(split.load()));
+    }
+    DumpCHIRToFile("ScalarReplacementOfAggregates");
+}
+
+void ToCHIR::RunLoopInvariantCodeMotion(const EscapeAnalysis& escapeAnalysis)
+{
+    if (!opts.chirLICM || opts.interpFullBchir) {
+        return;
+    }
+    Utils::ProfileRecorder recorder("CHIR Opt", "LoopInvariantCodeMotion");
+    auto pass = LoopInvariantCodeMotion(escapeAnalysis);
+    bool isDebug = opts.chirDebugOptimizer;
+    std::atomic<size_t> hoisted{0};
+    FunctionPassManager(builder, opts.GetJobs(), &analysisManager)
+        .RunOnPackage(*chirPkg, LoopInvariantCodeMotion::SCOPE,
+            [&pass, &hoisted, isDebug](Func& func, CHIRBuilder& subBuilder) {
+                auto num = pass.RunOnFunc(func, subBuilder, isDebug);
+                hoisted += num;
+                return num != 0;
+            });
+    if (opts.enableTimer || opts.enableMemoryCollect) {
+        Utils::ProfileRecorder::RecordCodeInfo(
+            "expression hoisted out of loops", static_cast<int64_t>(hoisted.load()));
+    }
+    DumpCHIRToFile("LoopInvariantCodeMotion");
+}
+
 void ToCHIR::RunGetRefToArrayElemOpt()
 {
     if (!opts.IsCHIROptimizationLevelOverO2() || opts.interpFullBchir) {
@@ -370,7 +472,7 @@ void ToCHIR::Devirtualization(DevirtualizationInfo& devirtInfo)
     TypeValue::SetCHIRBuilder(&builder);
     AnalysisWrapper<TypeAnalysis, TypeDomain> typeAnalysisWrapper(builder);
     typeAnalysisWrapper.RunOnPackage(chirPkg, opts.chirDebugOptimizer, threadNum, devirtInfo);
-    auto devirt = CHIR::Devirtualization(&typeAnalysisWrapper, devirtInfo);
+    auto devirt = CHIR::Devirtualization(&typeAnalysisWrapper, devirtInfo, GetPGOProfile());
     devirt.RunOnFuncs(funcs, builder, opts.chirDebugOptimizer);
 
     // if get frozen inst funcs after first devirtualization, opt them in the second round
@@ -382,12 +484,18 @@ void ToCHIR::Devirtualization(DevirtualizationInfo& devirtInfo)
         }
         devirt.RunOnFuncs(frozenFuncs, builder, opts.chirDebugOptimizer);
 
-        auto pass = FunctionInline(
-            builder, opts.optimizationLevel, opts.chirDebugOptimizer);
+        auto pass = FunctionInline(builder, opts.optimizationLevel, opts.chirDebugOptimizer, GetPGOProfile());
         for (auto& func : frozenFuncs) {
             pass.Run(*func);
         }
     }
+    // The rewritten invokes, including the speculated ones, are not tracked by function, and new instantiated
+    // functions may be called instead.
+    analysisManager.MarkAllChanged();
+    if (GetPGOProfile() != nullptr && (opts.enableTimer || opts.enableMemoryCollect)) {
+        Utils::ProfileRecorder::RecordCodeInfo(
+            "invoke speculatively devirtualized by profile", static_cast<int64_t>(devirt.GetSpeculatedNum()));
+    }
     DumpCHIRToFile("Devirtualization");
 }
 
@@ -397,8 +505,11 @@ void ToCHIR::RedundantGetOrThrowElimination()
         return;
     }
     Utils::ProfileRecorder recorder("CHIR Opt", "RedundantGetOrThrowElimination");
-    auto rGetOrThrowE = CHIR::RedundantGetOrThrowElimination();
-    rGetOrThrowE.RunOnPackage(chirPkg, opts.chirDebugOptimizer);
+    bool isDebug = opts.chirDebugOptimizer;
+    FunctionPassManager(builder, opts.GetJobs(), &analysisManager)
+        .RunOnPackage(*chirPkg, CHIR::RedundantGetOrThrowElimination::SCOPE, [isDebug](Func& func, CHIRBuilder&) {
+            return CHIR::RedundantGetOrThrowElimination().RunOnFunc(&func, isDebug);
+        });
     DumpCHIRToFile("RedundantGetOrThrowElimination");
 }
 
@@ -441,6 +552,15 @@ void ToCHIR::RunArrayListConstStartOpt()
     DumpCHIRToFile("RunArrayListConstStartOpt");
 }
 
+const PGOProfile* ToCHIR::GetPGOProfile() const
+{
+#ifdef CANGJIE_CODEGEN_CJNATIVE_BACKEND
+    return ci.chirData.GetPGOProfile();
+#else
+    return nullptr;
+#endif
+}
+
 void ToCHIR::RunFunctionInline(DevirtualizationInfo& devirtInfo)
 {
     if (!opts.IsOptimizationExisted(GlobalOptions::OptimizationFlag::FUNC_INLINING)) {
@@ -450,20 +570,18 @@ void ToCHIR::RunFunctionInline(DevirtualizationInfo& devirtInfo)
     CallGraphAnalysis callGraphAnalysis(chirPkg, devirtInfo);
     // Collect all call graph information.
     callGraphAnalysis.DoCallGraphAnalysis(opts.chirDebugOptimizer);
-    auto pass = FunctionInline(builder, opts.optimizationLevel, opts.chirDebugOptimizer);
-    for (auto func : callGraphAnalysis.postOrderSCCFunctionlist) {
-        if (!func) {
-            continue;
-        }
-        // 1. $toAny is a function needed by reflection, it's used by runtime and it mustn't be optimized
-        // 2. annotation factory functions mustn't be optimized
-        if (func->GetSrcCodeIdentifier() == "$toAny" ||
-            func->GetFuncKind() == FuncKind::ANNOFACTORY_FUNC) {
-            continue;
-        }
-        pass.Run(*func);
+    auto inliner = BottomUpInliner(builder, opts, GetPGOProfile(), &analysisManager);
+    inliner.Run(*chirPkg, callGraphAnalysis, !opts.chirInlineRemarksFile.empty());
+    MergeEffectMap(inliner.GetEffectMap(), effectMap);
+    if (!opts.chirInlineRemarksFile.empty() &&
+        !FileUtil::WriteToFile(opts.chirInlineRemarksFile, BottomUpInliner::RemarksToJsonLines(inliner.GetRemarks()))) {
+        diag.DiagnoseRefactor(
+            DiagKindRefactor::driver_inline_remarks_write_failed, DEFAULT_POSITION, opts.chirInlineRemarksFile);
+    }
+    if (opts.enableTimer || opts.enableMemoryCollect) {
+        Utils::ProfileRecorder::RecordCodeInfo(
+            "expression added by function inlining", static_cast<int64_t>(inliner.GetGrowth()));
     }
-    MergeEffectMap(pass.GetEffectMap(), effectMap);
     Utils::ProfileRecorder::Stop("CHIR Opt", "FunctionInline");
     DumpCHIRToFile("FunctionInline");
 
@@ -484,16 +602,29 @@ void ToCHIR::RunUnreachableMarkBlockRemoval()
 void ToCHIR::RunMergingBlocks(const std::string& firstName, const std::string& secondName)
 {
     Utils::ProfileRecorder recorder(firstName, secondName);
-    MergeBlocks::RunOnPackage(*chirPkg, builder, opts);
+    FunctionPassManager(builder, opts.GetJobs(), &analysisManager)
+        .RunOnPackage(*chirPkg, MergeBlocks::SCOPE, [this](Func& func, CHIRBuilder& subBuilder) {
+            bool isCommonFunctionWithoutBody = func.TestAttr(Attribute::SKIP_ANALYSIS);
+            return !isCommonFunctionWithoutBody && MergeBlocks::RunOnFunc(*func.GetBody(), subBuilder, opts);
+        });
     DumpCHIRToFile(secondName);
 }
 
 void ToCHIR::RunConstantAnalysis()
 {
     Utils::ProfileRecorder recorder("CHIR Opt", "Constant Analysis");
+    // Only the functions changed since the last run are analysed again.
+    analysisManager.Synchronize(constAnalysisWrapper);
     constAnalysisWrapper.RunOnPackage(chirPkg, opts.chirDebugOptimizer, opts.GetJobs(), &diag);
 }
 
+void ToCHIR::MarkChanged(const std::vector<const Func*>& funcs)
+{
+    for (auto func : funcs) {
+        analysisManager.MarkChanged(*func);
+    }
+}
+
 bool ToCHIR::RunConstantPropagation()
 {
     Utils::ProfileRecorder recorder("CHIR Opt", "Constant Propagation & Safety Check");
@@ -504,6 +635,7 @@ bool ToCHIR::RunConstantPropagation()
         cp.RunOnPackage(chirPkg, opts.chirDebugOptimizer, ci.isCJLint);
         MergeEffectMap(cp.GetEffectMap(), effectMap);
         dce.UnreachableBlockElimination(cp.GetFuncsNeedRemoveBlocks(), opts.chirDebugOptimizer);
+        MarkChanged(cp.GetChangedFuncs());
     } else {
         bool isDebug = opts.chirDebugOptimizer;
         bool isCJLint = ci.isCJLint;
@@ -524,6 +656,7 @@ bool ToCHIR::RunConstantPropagation()
         for (auto& cp : cpList) {
             MergeEffectMap(cp->GetEffectMap(), effectMap);
             dce.UnreachableBlockElimination(cp->GetFuncsNeedRemoveBlocks(), opts.chirDebugOptimizer);
+            MarkChanged(cp->GetChangedFuncs());
         }
         for (auto& subBd : builderList) {
             (*subBd).MergeAllocatedInstance();
@@ -630,8 +763,12 @@ void ToCHIR::RunUnitUnify()
         return;
     }
     Utils::ProfileRecorder recorder("CHIR Opt", "Unit Unify");
-    auto unitUnify = CHIR::UnitUnify(builder);
-    unitUnify.RunOnPackage(chirPkg, opts.chirDebugOptimizer);
+    bool isDebug = opts.chirDebugOptimizer;
+    FunctionPassManager(builder, opts.GetJobs(), &analysisManager)
+        .RunOnPackage(*chirPkg, CHIR::UnitUnify::SCOPE,
+            [isDebug](Func& func, CHIRBuilder& subBuilder) {
+                return CHIR::UnitUnify(subBuilder).RunOnFunc(&func, isDebug);
+            });
     DumpCHIRToFile("Unit_Unify");
 }
 
@@ -710,10 +847,16 @@ bool ToCHIR::RunOptimizationPassAndRulesChecking()
     RunRangePropagation();
     RunMergingBlocks("CHIR Opt", "MergingBlockAfterRangeAnalysis");
     UselessAllocateElimination();
+    // The passes between the two users of the escape analysis only remove escapes or add functions without summary,
+    // so its summaries stay conservative and it is computed once.
+    auto escapeAnalysis = RunEscapeAnalysis(devirtInfo);
+    RunNonEscapingAllocateElimination(escapeAnalysis);
+    RunScalarReplacementOfAggregates();
     Devirtualization(devirtInfo);
     RunArrayLambdaOpt();
     RunRedundantFutureOpt();
     RunNoSideEffectMarkerOpt();
+    RunLoopInvariantCodeMotion(escapeAnalysis);
     RunGetRefToArrayElemOpt();
     return true;
 }
@@ -849,6 +992,16 @@ void ToCHIR::RecordCodeInfoAtTheEnd()
     Utils::ProfileRecorder::RecordCodeInfo("wrapper func after CHIR stage", wrapperFuncNum);
     Utils::ProfileRecorder::RecordCodeInfo("expr num in global func after CHIR stage", funcExprNum);
     Utils::ProfileRecorder::RecordCodeInfo("expr num in wrapper func after CHIR stage", wrapperFuncExprNum);
+    RecordAnalysisCacheStats();
+}
+
+void ToCHIR::RecordAnalysisCacheStats()
+{
+    if (!opts.enableTimer && !opts.enableMemoryCollect) {
+        return;
+    }
+    // The statistics accumulate over all runs of an analysis, so they are recorded once at the end of the stage.
+    constAnalysisWrapper.RecordCacheStats("Constant");
 }
 
 void ToCHIR::RecordCHIRExprNum(const std::string& suffix)
@@ -919,7 +1072,6 @@ bool ToCHIR::RunAnalysisForCJLint()
     }
     UnreachableBlockElimination();
     if (RunConstantPropagationAndSafetyCheck()) {
-        constAnalysisWrapper.InvalidateAllAnalysisResults();
         RunConstantAnalysis();
         return true;
     }
@@ -1190,7 +1342,9 @@ bool ToCHIR::Run()
     RunMarkClassHasInited();
 
     if (ci.isCJLint) {
-        return RunAnalysisForCJLint() && RunIRChecker(Phase::ANALYSIS_FOR_CJLINT);
+        bool success = RunAnalysisForCJLint() && RunIRChecker(Phase::ANALYSIS_FOR_CJLINT);
+        RecordAnalysisCacheStats();
+        return success;
     }
     if (!RunOptimizationPassAndRulesChecking()) {
         return false;
@@ -14,7 +14,6 @@
 
 #include "cangjie/CHIR/CHIRContext.h"
 
-#include <thread>
 #include "cangjie/Basic/Print.h"
 #include "cangjie/CHIR/CHIRCasting.h"
 #include "cangjie/CHIR/Package.h"
@@ -23,6 +22,7 @@
 #include "cangjie/CHIR/Type/ExtendDef.h"
 #include "cangjie/CHIR/Type/StructDef.h"
 #include "cangjie/CHIR/Value.h"
+#include "cangjie/Utils/TaskQueue.h"
 
 using namespace Cangjie::CHIR;
 
@@ -170,8 +170,7 @@ CHIRContext::~CHIRContext()
         DeleteAllocatedTys();
     } else {
         // Delete the allocated instances.
-        std::vector<std::thread> threads;
-        threads.reserve(threadsNum);
+        Utils::TaskQueue taskQueue(threadsNum);
         std::vector<std::vector<size_t>> indexs(threadsNum, std::vector<size_t>());
         DivideArray(allocatedValues.size(), threadsNum - 1, indexs);
         DivideArray(allocatedExprs.size(), threadsNum - 1, indexs);
@@ -182,14 +181,10 @@ CHIRContext::~CHIRContext()
         DivideArray(allocatedEnums.size(), threadsNum - 1, indexs);
         for (size_t i = 0; i < threadsNum - 1; i++) {
             std::vector<size_t>& idxs = indexs[i];
-            threads.emplace_back([&idxs, this]() { DeleteAllocatedInstance(idxs); });
-        }
-        threads.emplace_back([this]() { DeleteAllocatedTys(); });
-        for (auto& thread : threads) {
-            if (thread.joinable()) {
-                thread.join();
-            }
+            taskQueue.AddTask<void>([&idxs, this]() { DeleteAllocatedInstance(idxs); });
         }
+        taskQueue.AddTask<void>([this]() { DeleteAllocatedTys(); });
+        taskQueue.RunAndWaitForAllTasksCompleted();
     }
     allocatedExprs.clear();
     allocatedValues.clear();
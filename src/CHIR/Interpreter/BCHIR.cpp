@@ -12,6 +12,7 @@
  * This file implements BCHIR representation.
  */
 
+#include <algorithm>
 #include <functional>
 
 #include "cangjie/CHIR/Interpreter/BCHIR.h"
@@ -345,6 +346,40 @@ const Bchir::ClassTable& Bchir::GetClassTable() const
     return classTable;
 }
 
+void Bchir::LayoutDispatchTables()
+{
+    constexpr size_t bitsPerWord = 64;
+    for (auto& [id, classInfo] : classTable) {
+        classInfo.superClassBits.clear();
+        if (!classInfo.superClasses.empty()) {
+            // std::set is ordered, the last superclass has the highest id
+            classInfo.superClassBits.resize(*classInfo.superClasses.rbegin() / bitsPerWord + 1, 0);
+        }
+        for (auto superId : classInfo.superClasses) {
+            classInfo.superClassBits[superId / bitsPerWord] |= uint64_t(1) << (superId % bitsPerWord);
+        }
+        classInfo.flatVTable.assign(classInfo.vtable.begin(), classInfo.vtable.end());
+        std::sort(classInfo.flatVTable.begin(), classInfo.flatVTable.end());
+    }
+}
+
+Bchir::ByteCodeContent Bchir::AddInvokeSite(ByteCodeContent methodId)
+{
+    invokeSites.emplace_back(methodId);
+    return static_cast<ByteCodeContent>(invokeSites.size() - 1);
+}
+
+Bchir::ByteCodeContent Bchir::GetInvokeSiteMethod(ByteCodeContent site) const
+{
+    CJC_ASSERT(site < invokeSites.size());
+    return invokeSites[site];
+}
+
+size_t Bchir::GetNumInvokeSites() const
+{
+    return invokeSites.size();
+}
+
 void Bchir::RemoveFunction(const std::string& name)
 {
     functions.erase(name);
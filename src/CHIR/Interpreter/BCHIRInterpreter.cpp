@@ -34,9 +34,43 @@ const Bchir& BCHIRInterpreter::GetBchir() const
     return bchir;
 }
 
+// Release builds compiled with GCC or Clang dispatch operations by direct threading: each handler jumps straight to
+// the handler of the next operation through a table of label addresses, instead of going back to the switch. This
+// removes the range check of the switch and gives every handler its own indirect branch, which predicts much better.
+// Other builds keep the switch, and debug builds also trace every operation with PrintDebugInfo.
+#if (defined(__GNUC__) || defined(__clang__)) && defined(NDEBUG)
+#define BCHIR_DIRECT_THREADED_DISPATCH
+#endif
+
+#ifdef BCHIR_DIRECT_THREADED_DISPATCH
+#define OP_CASE(ID)                                                                                                    \
+    case OpCode::ID:                                                                                                   \
+    OP_##ID
+#define NEXT_OP()                                                                                                      \
+    do {                                                                                                               \
+        if (interpreterError) {                                                                                        \
+            return;                                                                                                    \
+        }                                                                                                              \
+        pcExcOffset = 0;                                                                                               \
+        current = static_cast<OpCode>(bchir.Get(pc));                                                                  \
+        goto* dispatchTable[current < OpCode::INVALID ? static_cast<size_t>(current)                                   \
+                                                      : static_cast<size_t>(OpCode::INVALID)];                         \
+    } while (false)
+#else
+#define OP_CASE(ID) case OpCode::ID
+#define NEXT_OP() continue
+#endif
+
 void BCHIRInterpreter::Interpret()
 {
     CJC_ASSERT(pc == baseIndex);
+#ifdef BCHIR_DIRECT_THREADED_DISPATCH
+    static const void* const dispatchTable[static_cast<size_t>(OpCode::INVALID) + 1]{
+#define OPCODE(ID, VALUE, SIZE, HAS_EXC_HANDLER) &&OP_##ID,
+#include "cangjie/CHIR/Interpreter/OpCodes.inc"
+#undef OPCODE
+    };
+#endif
     // no bound variables in the top-level thunk
     while (!interpreterError) {
         auto current = static_cast<OpCode>(bchir.Get(pc));
@@ -55,119 +89,114 @@ void BCHIRInterpreter::Interpret()
         // pcExcOffset is going to 0 if entry point was X or 1 is entry point was X_EXC
         Bchir::ByteCodeIndex pcExcOffset{0};
         switch (current) {
-            case OpCode::ALLOCATE_RAW_ARRAY: {
+            OP_CASE(ALLOCATE_RAW_ARRAY): {
                 InterpretAllocateRawArray<false, false>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::ALLOCATE_EXC:
+            OP_CASE(ALLOCATE_EXC):
                 pcExcOffset = 1;
                 // intended missing break
                 // for the time being allocate never raises exception
-            case OpCode::ALLOCATE: {
+            OP_CASE(ALLOCATE): {
                 auto ptr = IPointer();
                 ptr.content = AllocateValue(INullptr());
                 interpStack.ArgsPush(ptr);
                 pc += 1 + pcExcOffset;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::ALLOCATE_STRUCT_EXC:
+            OP_CASE(ALLOCATE_STRUCT_EXC):
                 pcExcOffset = 1;
                 // intended missing break
                 // for the time being allocate never raises exception
-            case OpCode::ALLOCATE_STRUCT: {
+            OP_CASE(ALLOCATE_STRUCT): {
                 auto numField = bchir.Get(pc + 1);
-                std::vector<IVal> content;
-                for (size_t i = 0; i < numField; i++) {
-                    content.emplace_back(INullptr());
-                }
                 auto ptr = IPointer();
-                ptr.content = AllocateValue(ITuple{std::move(content)});
+                ptr.content = AllocateValue(ITuple{std::vector<IVal>(numField, INullptr())});
                 interpStack.ArgsPush(ptr);
                 pc += Bchir::FLAG_TWO + pcExcOffset;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::ALLOCATE_CLASS_EXC:
+            OP_CASE(ALLOCATE_CLASS_EXC):
                 pcExcOffset = 1;
                 // intended missing break
                 // for the time being allocate never raises exception
-            case OpCode::ALLOCATE_CLASS: {
+            OP_CASE(ALLOCATE_CLASS): {
                 auto classId = bchir.Get(pc + 1);
                 auto numField = bchir.Get(pc + Bchir::FLAG_TWO);
-                std::vector<IVal> content;
-                for (size_t i = 0; i < numField; i++) {
-                    content.emplace_back(INullptr());
-                }
                 auto ptr = IPointer();
-                ptr.content = AllocateValue(IObject{classId, std::move(content)});
+                ptr.content = AllocateValue(IObject{classId, std::vector<IVal>(numField, INullptr())});
                 interpStack.ArgsPush(ptr);
                 pc += Bchir::FLAG_THREE + pcExcOffset;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::FRAME: {
+            OP_CASE(FRAME): {
+                if (arena.ShouldCollect()) {
+                    CollectGarbage();
+                }
                 auto num = bchir.Get(pc + 1);
                 env.AllocateLocalVarsForFrame(static_cast<size_t>(num));
                 pc += Bchir::FLAG_TWO;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::LVAR: {
+            OP_CASE(LVAR): {
                 auto varIdx = pc + 1;
                 auto var = bchir.Get(varIdx);
                 // update pc for next operation
                 pc += Bchir::FLAG_TWO;
 
                 interpStack.ArgsPushIValRef(env.GetLocal(var));
-                continue;
+                NEXT_OP();
             }
-            case OpCode::GVAR: {
+            OP_CASE(GVAR): {
                 auto varId = bchir.Get(pc + 1);
                 auto& val = env.GetGlobal(varId);
                 interpStack.ArgsPush(IPointer{&val});
                 // update pc for next operation
                 pc += Bchir::FLAG_TWO;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::GVAR_SET: {
+            OP_CASE(GVAR_SET): {
                 auto varId = bchir.Get(pc + 1);
                 env.SetGlobal(varId, interpStack.ArgsPopIVal());
                 pc = pc + 1 + 1;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::LVAR_SET: {
+            OP_CASE(LVAR_SET): {
                 auto varId = bchir.Get(pc + 1);
                 env.SetLocal(varId, interpStack.ArgsPopIVal());
                 pc = pc + 1 + 1;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::UINT8: {
+            OP_CASE(UINT8): {
                 auto valIdx = pc + 1;
                 interpStack.ArgsPush(IValUtils::PrimitiveValue<IUInt8>(static_cast<uint8_t>(bchir.Get(valIdx))));
                 // update pc for next operation
                 pc += Bchir::FLAG_TWO;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::UINT16: {
+            OP_CASE(UINT16): {
                 auto valIdx = pc + 1;
                 interpStack.ArgsPush(IValUtils::PrimitiveValue<IUInt16>(static_cast<uint16_t>(bchir.Get(valIdx))));
                 // update pc for next operation
                 pc += Bchir::FLAG_TWO;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::UINT32: {
+            OP_CASE(UINT32): {
                 auto valIdx = pc + 1;
                 interpStack.ArgsPush(IValUtils::PrimitiveValue<IUInt32>(static_cast<uint32_t>(bchir.Get(valIdx))));
                 // update pc for next operation
                 pc += Bchir::FLAG_TWO;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::UINT64: {
+            OP_CASE(UINT64): {
                 auto valIdx = pc + 1;
                 interpStack.ArgsPush(
                     IValUtils::PrimitiveValue<IUInt64>(static_cast<uint64_t>(bchir.Get8bytes(valIdx))));
                 // update pc for next operation
                 pc += Bchir::FLAG_THREE;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::UINTNAT: {
+            OP_CASE(UINTNAT): {
                 auto valIdx = pc + 1;
 #if (defined(__x86_64__) || defined(__aarch64__))
                 interpStack.ArgsPush(
@@ -178,37 +207,37 @@ void BCHIRInterpreter::Interpret()
 #endif
                 // update pc for next operation
                 pc += Bchir::FLAG_THREE;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::INT8: {
+            OP_CASE(INT8): {
                 auto valIdx = pc + 1;
                 interpStack.ArgsPush(IValUtils::PrimitiveValue<IInt8>(static_cast<int8_t>(bchir.Get(valIdx))));
                 // update pc for next operation
                 pc += Bchir::FLAG_TWO;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::INT16: {
+            OP_CASE(INT16): {
                 auto valIdx = pc + 1;
                 interpStack.ArgsPush(IValUtils::PrimitiveValue<IInt16>(static_cast<int16_t>(bchir.Get(valIdx))));
                 // update pc for next operation
                 pc += Bchir::FLAG_TWO;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::INT32: {
+            OP_CASE(INT32): {
                 auto valIdx = pc + 1;
                 interpStack.ArgsPush(IValUtils::PrimitiveValue<IInt32>(static_cast<int32_t>(bchir.Get(valIdx))));
                 // update pc for next operation
                 pc += Bchir::FLAG_TWO;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::INT64: {
+            OP_CASE(INT64): {
                 auto valIdx = pc + 1;
                 interpStack.ArgsPush(IValUtils::PrimitiveValue<IInt64>(static_cast<int64_t>(bchir.Get8bytes(valIdx))));
                 // update pc for next operation
                 pc += Bchir::FLAG_THREE;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::INTNAT: {
+            OP_CASE(INTNAT): {
                 auto valIdx = pc + 1;
 #if (defined(__x86_64__) || defined(__aarch64__))
                 interpStack.ArgsPush(IValUtils::PrimitiveValue<IIntNat>(static_cast<int64_t>(bchir.Get8bytes(valIdx))));
@@ -217,9 +246,9 @@ void BCHIRInterpreter::Interpret()
 #endif
                 // update pc for next operation
                 pc += Bchir::FLAG_THREE;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::FLOAT16: {
+            OP_CASE(FLOAT16): {
                 auto valIdx = pc + 1;
                 auto tmp = bchir.Get(valIdx);
                 // Value for a FLOAT16 instruction is a 32-bit float.
@@ -230,9 +259,9 @@ void BCHIRInterpreter::Interpret()
                 }
                 interpStack.ArgsPush(IValUtils::PrimitiveValue<IFloat16>(static_cast<float>(f)));
                 pc += Bchir::FLAG_TWO;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::FLOAT32: {
+            OP_CASE(FLOAT32): {
                 auto valIdx = pc + 1;
                 auto tmp = bchir.Get(valIdx);
                 float f;
@@ -242,9 +271,9 @@ void BCHIRInterpreter::Interpret()
                 }
                 interpStack.ArgsPush(IValUtils::PrimitiveValue<IFloat32>(static_cast<float>(f)));
                 pc += Bchir::FLAG_TWO;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::FLOAT64: {
+            OP_CASE(FLOAT64): {
                 auto valIdx = pc + 1;
                 auto tmp = bchir.Get8bytes(valIdx);
                 double d;
@@ -254,40 +283,40 @@ void BCHIRInterpreter::Interpret()
                 }
                 interpStack.ArgsPush(IValUtils::PrimitiveValue<IFloat64>(d));
                 pc += Bchir::FLAG_THREE;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::RUNE: {
+            OP_CASE(RUNE): {
                 auto valIdx = pc + 1;
                 interpStack.ArgsPush(IValUtils::PrimitiveValue<IRune>(bchir.Get(static_cast<char32_t>(valIdx))));
                 // update pc for next operation
                 pc += Bchir::FLAG_TWO;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::BOOL: {
+            OP_CASE(BOOL): {
                 auto valIdx = pc + 1;
                 interpStack.ArgsPush(IValUtils::PrimitiveValue<IBool>(bchir.Get(valIdx)));
                 // update pc for next operation
                 pc += Bchir::FLAG_TWO;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::UNIT: {
+            OP_CASE(UNIT): {
                 interpStack.ArgsPush(IUnit());
                 // update pc for next operation
                 pc += 1;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::NULLPTR: {
+            OP_CASE(NULLPTR): {
                 interpStack.ArgsPush(INullptr());
                 // update pc for next operation
                 pc += 1;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::STRING: {
+            OP_CASE(STRING): {
                 InterpretString();
                 pc += Bchir::FLAG_TWO;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::TUPLE: {
+            OP_CASE(TUPLE): {
                 auto sizeIdx = pc + 1;
                 auto size = bchir.Get(sizeIdx);
                 pc = sizeIdx + 1;
@@ -295,188 +324,223 @@ void BCHIRInterpreter::Interpret()
                 auto tuple = ITuple();
                 interpStack.ArgsPop(size, tuple.content);
                 interpStack.ArgsPush(std::move(tuple));
-                continue;
+                NEXT_OP();
             }
-            case OpCode::VARRAY: {
+            OP_CASE(VARRAY): {
                 auto sizeIdx = pc + 1;
                 auto size = bchir.Get(sizeIdx);
                 auto array = IArray();
                 interpStack.ArgsPop(size, array.content);
                 interpStack.ArgsPush(std::move(array));
                 pc = sizeIdx + 1;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::VARRAY_GET: {
+            OP_CASE(VARRAY_GET): {
                 InterpretVArrayGet();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::RAW_ARRAY_LITERAL_INIT: {
+            OP_CASE(RAW_ARRAY_LITERAL_INIT): {
                 InterpretRawArrayLiteralInit();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::FUNC: {
+            OP_CASE(FUNC): {
                 // FUNC :: THUNK_IDX :: NEXT_OP
                 auto thunkIdx = pc + 1;
                 auto func = IFunc{bchir.Get(thunkIdx)};
                 interpStack.ArgsPush(func);
                 pc = thunkIdx + 1;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::RETURN: {
+            OP_CASE(RETURN): {
                 InterpretReturn();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::EXIT: {
+            OP_CASE(EXIT): {
                 // we are done
                 return;
             }
-            case OpCode::DROP: {
+            OP_CASE(DROP): {
                 interpStack.ArgsPopBack();
                 pc += 1;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::JUMP: {
+            OP_CASE(JUMP): {
+                // loops go back through a jump, like calls go through a frame
+                if (arena.ShouldCollect()) {
+                    CollectGarbage();
+                }
                 pc = bchir.Get(pc + 1);
-                continue;
+                NEXT_OP();
             }
-            case OpCode::BRANCH: {
+            OP_CASE(BRANCH): {
                 auto cond = interpStack.ArgsPop<IBool>();
                 if (cond.content) {
                     pc = bchir.Get(pc + 1);
                 } else {
                     pc = bchir.Get(pc + Bchir::FLAG_TWO);
                 }
-                continue;
+                NEXT_OP();
+            }
+            OP_CASE(LVAR_LVAR): {
+                // LVAR :: var1 :: LVAR :: var2
+                interpStack.ArgsPushIValRef(env.GetLocal(bchir.Get(pc + 1)));
+                interpStack.ArgsPushIValRef(env.GetLocal(bchir.Get(pc + Bchir::FLAG_THREE)));
+                pc += Bchir::FLAG_FOUR;
+                NEXT_OP();
+            }
+            OP_CASE(LVAR_FIELD): {
+                // LVAR :: var :: FIELD :: field, only the field is copied instead of the whole aggregate
+                auto& arg = env.GetLocal(bchir.Get(pc + 1));
+                auto field = bchir.Get(pc + Bchir::FLAG_THREE);
+                if (auto tuple = IValUtils::GetIf<ITuple>(&arg)) {
+                    interpStack.ArgsPushIValRef(tuple->content[field]);
+                } else {
+                    CJC_ASSERT(std::holds_alternative<IObject>(arg));
+                    // -1 because we don't have the class node anymore
+                    interpStack.ArgsPushIValRef(IValUtils::Get<IObject>(arg).content[field - 1]);
+                }
+                pc += Bchir::FLAG_FOUR;
+                NEXT_OP();
+            }
+            OP_CASE(LVAR_BRANCH): {
+                // LVAR :: var :: BRANCH :: true target :: false target
+                auto& cond = IValUtils::Get<IBool>(env.GetLocal(bchir.Get(pc + 1)));
+                if (cond.content) {
+                    pc = bchir.Get(pc + Bchir::FLAG_THREE);
+                } else {
+                    pc = bchir.Get(pc + Bchir::FLAG_FOUR);
+                }
+                NEXT_OP();
             }
-            case OpCode::UN_NEG_EXC: {
+            OP_CASE(UN_NEG_EXC): {
                 BinOp<OpCode::UN_NEG_EXC>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::BIN_ADD_EXC: {
+            OP_CASE(BIN_ADD_EXC): {
                 BinOp<OpCode::BIN_ADD_EXC>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::BIN_SUB_EXC: {
+            OP_CASE(BIN_SUB_EXC): {
                 BinOp<OpCode::BIN_SUB_EXC>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::BIN_MUL_EXC: {
+            OP_CASE(BIN_MUL_EXC): {
                 BinOp<OpCode::BIN_MUL_EXC>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::BIN_DIV_EXC: {
+            OP_CASE(BIN_DIV_EXC): {
                 BinOp<OpCode::BIN_DIV_EXC>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::BIN_MOD_EXC: {
+            OP_CASE(BIN_MOD_EXC): {
                 BinOp<OpCode::BIN_MOD_EXC>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::BIN_EXP_EXC: {
+            OP_CASE(BIN_EXP_EXC): {
                 BinOp<OpCode::BIN_EXP_EXC>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::BIN_LSHIFT_EXC: {
+            OP_CASE(BIN_LSHIFT_EXC): {
                 BinOp<OpCode::BIN_LSHIFT_EXC>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::BIN_RSHIFT_EXC: {
+            OP_CASE(BIN_RSHIFT_EXC): {
                 BinOp<OpCode::BIN_RSHIFT_EXC>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::UN_NEG: {
+            OP_CASE(UN_NEG): {
                 BinOp<OpCode::UN_NEG>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::UN_DEC: {
+            OP_CASE(UN_DEC): {
                 BinOp<OpCode::UN_DEC>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::UN_INC: {
+            OP_CASE(UN_INC): {
                 BinOp<OpCode::UN_INC>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::UN_NOT: {
+            OP_CASE(UN_NOT): {
                 BinOpFixedBool<OpCode::UN_NOT>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::UN_BITNOT: {
+            OP_CASE(UN_BITNOT): {
                 BinOp<OpCode::UN_BITNOT>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::BIN_ADD: {
+            OP_CASE(BIN_ADD): {
                 BinOp<OpCode::BIN_ADD>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::BIN_SUB: {
+            OP_CASE(BIN_SUB): {
                 BinOp<OpCode::BIN_SUB>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::BIN_MUL: {
+            OP_CASE(BIN_MUL): {
                 BinOp<OpCode::BIN_MUL>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::BIN_DIV: {
+            OP_CASE(BIN_DIV): {
                 BinOp<OpCode::BIN_DIV>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::BIN_MOD: {
+            OP_CASE(BIN_MOD): {
                 BinOp<OpCode::BIN_MOD>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::BIN_EXP: {
+            OP_CASE(BIN_EXP): {
                 BinOp<OpCode::BIN_EXP>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::BIN_LT: {
+            OP_CASE(BIN_LT): {
                 BinOp<OpCode::BIN_LT>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::BIN_GT: {
+            OP_CASE(BIN_GT): {
                 BinOp<OpCode::BIN_GT>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::BIN_LE: {
+            OP_CASE(BIN_LE): {
                 BinOp<OpCode::BIN_LE>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::BIN_GE: {
+            OP_CASE(BIN_GE): {
                 BinOp<OpCode::BIN_GE>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::BIN_NOTEQ: {
+            OP_CASE(BIN_NOTEQ): {
                 BinOp<OpCode::BIN_NOTEQ>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::BIN_EQUAL: {
+            OP_CASE(BIN_EQUAL): {
                 BinOp<OpCode::BIN_EQUAL>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::BIN_BITAND: {
+            OP_CASE(BIN_BITAND): {
                 BinOp<OpCode::BIN_BITAND>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::BIN_BITOR: {
+            OP_CASE(BIN_BITOR): {
                 BinOp<OpCode::BIN_BITOR>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::BIN_BITXOR: {
+            OP_CASE(BIN_BITXOR): {
                 BinOp<OpCode::BIN_BITXOR>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::BIN_LSHIFT: {
+            OP_CASE(BIN_LSHIFT): {
                 BinOp<OpCode::BIN_LSHIFT>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::BIN_RSHIFT: {
+            OP_CASE(BIN_RSHIFT): {
                 BinOp<OpCode::BIN_RSHIFT>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::FIELD_TPL: {
+            OP_CASE(FIELD_TPL): {
                 InterpretFieldTpl();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::FIELD: {
+            OP_CASE(FIELD): {
                 auto fieldIdx = pc + 1;
                 auto field = bchir.Get(fieldIdx);
                 // OPTIMIZE
@@ -490,33 +554,33 @@ void BCHIRInterpreter::Interpret()
                     interpStack.ArgsPushIVal(std::move(object.content[field - 1]));
                 }
                 pc = fieldIdx + 1;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::INVOKE_EXC: {
+            OP_CASE(INVOKE_EXC): {
                 InterpretInvoke<OpCode::INVOKE_EXC>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::INVOKE: {
+            OP_CASE(INVOKE): {
                 InterpretInvoke<OpCode::INVOKE>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::TYPECAST: {
+            OP_CASE(TYPECAST): {
                 InterpretTypeCast();
                 if (raiseExnToTopLevel) {
                     return;
                 }
-                continue;
+                NEXT_OP();
             }
-            case OpCode::INSTANCEOF: {
+            OP_CASE(INSTANCEOF): {
                 auto ptr = interpStack.ArgsPop<IPointer>();
                 auto& obj = IValUtils::Get<IObject>(*ptr.content);
                 auto lhs = obj.classId;
                 auto rhs = bchir.Get(pc + 1);
                 interpStack.ArgsPush(IBool{IsSubclass(lhs, rhs)});
                 pc += Bchir::FLAG_TWO;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::BOX: {
+            OP_CASE(BOX): {
                 auto classId = bchir.Get(pc + 1);
                 std::vector<IVal> content;
                 interpStack.ArgsPop(1, content);
@@ -524,89 +588,105 @@ void BCHIRInterpreter::Interpret()
                 ptr.content = AllocateValue(IObject{classId, std::move(content)});
                 interpStack.ArgsPush(std::move(ptr));
                 pc += Bchir::FLAG_TWO;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::UNBOX: {
+            OP_CASE(UNBOX): {
                 auto ptr = interpStack.ArgsPop<IPointer>();
                 auto& obj = IValUtils::Get<IObject>(*ptr.content);
                 auto value = obj.content[0];
                 interpStack.ArgsPushIVal(std::move(value));
                 pc++;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::UNBOX_REF: {
+            OP_CASE(UNBOX_REF): {
                 auto ptr = interpStack.ArgsPop<IPointer>();
                 auto& obj = IValUtils::Get<IObject>(*ptr.content);
                 ptr.content = &obj.content[0]; // reusing ptr
                 interpStack.ArgsPush(std::move(ptr));
                 pc++;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::APPLY: {
+            OP_CASE(APPLY): {
                 InterpretApply<OpCode::APPLY>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::APPLY_EXC: {
+            OP_CASE(APPLY_EXC): {
                 InterpretApply<OpCode::APPLY_EXC>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::ASG: {
+            OP_CASE(ASG): {
                 auto ptr = interpStack.ArgsPop<IPointer>();
                 auto value = interpStack.ArgsPopIVal();
                 *ptr.content = std::move(value);
                 interpStack.ArgsPush(IUnit());
                 pc += 1;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::STOREINREF: {
+            OP_CASE(STOREINREF): {
                 InterpretStoreInRef();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::STORE: {
+            OP_CASE(STORE): {
                 auto ptr = interpStack.ArgsPop<IPointer>();
                 auto value = interpStack.ArgsPopIVal();
                 *ptr.content = std::move(value);
                 pc += 1;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::DEREF: {
+            OP_CASE(DEREF): {
                 InterpretDeref();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::INTRINSIC0: {
+            OP_CASE(INTRINSIC0): {
                 InterpretIntrinsic<OpCode::INTRINSIC0>();
                 if (raiseExnToTopLevel) {
                     return;
                 }
-                continue;
+                NEXT_OP();
             }
-            case OpCode::INTRINSIC1: {
+            OP_CASE(INTRINSIC1): {
                 InterpretIntrinsic<OpCode::INTRINSIC1>();
                 if (raiseExnToTopLevel) {
                     return;
                 }
-                continue;
+                NEXT_OP();
             }
-            case OpCode::SWITCH: {
+            OP_CASE(SWITCH): {
                 InterpretSwitch();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::GETREF: {
+            OP_CASE(GETREF): {
                 InterpretGetRef();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::SYSCALL:
-            case OpCode::CAPPLY:
-            case OpCode::ABORT: {
+            OP_CASE(SYSCALL):
+            OP_CASE(CAPPLY):
+            OP_CASE(ABORT): {
                 if (!isConstEval) {
                     FailWith(pc, "operation not currently supported in const eval", DiagKind::const_eval_unsupported);
                 }
                 interpreterError = true;
                 return;
             }
-            case OpCode::SPAWN:
-            case OpCode::NOT_SUPPORTED:
-            case OpCode::INVALID:
+            // every operation needs a label for the dispatch table, even the ones interpreted nowhere
+            OP_CASE(SPAWN):
+            OP_CASE(SPAWN_EXC):
+            OP_CASE(NOT_SUPPORTED):
+            OP_CASE(INVALID):
+            OP_CASE(ALLOCATE_RAW_ARRAY_EXC):
+            OP_CASE(ALLOCATE_RAW_ARRAY_LITERAL):
+            OP_CASE(ALLOCATE_RAW_ARRAY_LITERAL_EXC):
+            OP_CASE(ARRAY):
+            OP_CASE(GET_EXCEPTION):
+            OP_CASE(INTRINSIC0_EXC):
+            OP_CASE(INTRINSIC1_EXC):
+            OP_CASE(INTRINSIC2):
+            OP_CASE(INTRINSIC2_EXC):
+            OP_CASE(RAISE):
+            OP_CASE(RAISE_EXC):
+            OP_CASE(RAW_ARRAY_INIT_BY_VALUE):
+            OP_CASE(TYPECAST_EXC):
+            OP_CASE(VARRAY_BY_VALUE):
             default: {
                 FailWith(pc, "operation not currently supported in interpreter", DiagKind::interp_unsupported,
                     "Interpret", GetOpCodeLabel(current));
@@ -616,6 +696,10 @@ void BCHIRInterpreter::Interpret()
     }
 }
 
+#undef NEXT_OP
+#undef OP_CASE
+#undef BCHIR_DIRECT_THREADED_DISPATCH
+
 void BCHIRInterpreter::InterpretString()
 {
     // String values in the interpreter must match the definition of strings in the core library
@@ -1028,7 +1112,7 @@ template <OpCode op> void BCHIRInterpreter::InterpretApply()
     CJC_ASSERT(numberArgs > 0);
     CJC_ASSERT(interpStack.ArgsSize() >= numberArgs);
     // argStack = ... :: FUNC :: ARG_1 :: ... :: ARG_N
-    auto func = IValUtils::Get<IFunc>(interpStack.ArgsGet(numberArgs, 0));
+    auto func = interpStack.ArgsPeek<IFunc>(numberArgs, 0);
     auto funcThunkIdx = func.content;
     // add apply to opStack so that we know where to continue when we reach RETURN
     interpStack.CtrlPush({op, funcThunkIdx, pc, env.GetBP()});
@@ -1036,41 +1120,65 @@ template <OpCode op> void BCHIRInterpreter::InterpretApply()
     pc = static_cast<unsigned>(funcThunkIdx);
 }
 
+void BCHIRInterpreter::InitDispatchTables()
+{
+    inlineCaches.resize(bchir.GetNumInvokeSites());
+    for (auto& [id, classInfo] : bchir.GetClassTable()) {
+        if (id >= classes.size()) {
+            classes.resize(static_cast<size_t>(id) + 1, nullptr);
+        }
+        classes[id] = &classInfo;
+    }
+}
+
 Bchir::ByteCodeIndex BCHIRInterpreter::FindMethod(Bchir::ByteCodeContent classId, Bchir::ByteCodeContent nameId)
 {
-    auto classInfoIt = bchir.GetClassTable().find(classId);
-    CJC_ASSERT(classInfoIt != bchir.GetClassTable().end());
-    auto& classInfo = classInfoIt->second;
-    auto methodIt = classInfo.vtable.find(nameId);
-    CJC_ASSERT(methodIt != classInfo.vtable.end());
+    CJC_ASSERT(classId < classes.size() && classes[classId] != nullptr);
+    auto& vtable = classes[classId]->flatVTable;
+    auto methodIt = std::lower_bound(vtable.begin(), vtable.end(), nameId,
+        [](const std::pair<Bchir::ByteCodeContent, Bchir::ByteCodeIndex>& entry,
+            Bchir::ByteCodeContent id) { return entry.first < id; });
+    CJC_ASSERT(methodIt != vtable.end() && methodIt->first == nameId);
     return methodIt->second;
 }
 
 bool BCHIRInterpreter::IsSubclass(Bchir::ByteCodeContent lhs, Bchir::ByteCodeContent rhs)
 {
+    constexpr size_t bitsPerWord = 64;
     if (lhs == rhs) {
         return true;
     }
-    auto& classTable = bchir.GetClassTable();
-    auto it = classTable.find(lhs);
-    CJC_ASSERT(it != classTable.end());
-    return it->second.superClasses.find(rhs) != it->second.superClasses.end();
+    CJC_ASSERT(lhs < classes.size() && classes[lhs] != nullptr);
+    auto& bits = classes[lhs]->superClassBits;
+    return rhs / bitsPerWord < bits.size() && (bits[rhs / bitsPerWord] >> (rhs % bitsPerWord)) & 1;
 }
 
 template <OpCode op> void BCHIRInterpreter::InterpretInvoke()
 {
-    // INVOKE :: NUMBER_OF_ARGS
+    // INVOKE :: NUMBER_OF_ARGS :: INVOKE_SITE
     auto numberArgsIdx = pc + 1;
     size_t numberArgs = bchir.Get(numberArgsIdx);
-    size_t nameId = bchir.Get(numberArgsIdx + 1);
+    auto site = bchir.Get(numberArgsIdx + 1);
     CJC_ASSERT(numberArgs > 0);
     CJC_ASSERT(interpStack.ArgsSize() >= numberArgs);
     // argStack = ... :: DUMMY :: PTR :: ARG_1 :: ... :: ARG_N
-    auto ptr = IValUtils::Get<IPointer>(interpStack.ArgsGet(numberArgs, 0));
+    auto& ptr = interpStack.ArgsPeek<IPointer>(numberArgs, 0);
     auto& object = IValUtils::Get<IObject>(*ptr.content);
     auto classId = object.classId;
 
-    auto funcThunkIdx = FindMethod(classId, static_cast<unsigned>(nameId));
+    CJC_ASSERT(site < inlineCaches.size());
+    auto& cache = inlineCaches[site];
+    Bchir::ByteCodeIndex funcThunkIdx = 0;
+    auto hit = std::find_if(cache.entries.begin(), cache.entries.begin() + static_cast<std::ptrdiff_t>(cache.size),
+        [classId](auto& entry) { return entry.first == classId; });
+    if (hit != cache.entries.begin() + static_cast<std::ptrdiff_t>(cache.size)) {
+        funcThunkIdx = hit->second;
+    } else {
+        funcThunkIdx = FindMethod(classId, bchir.GetInvokeSiteMethod(site));
+        if (cache.size < InlineCache::WAYS) {
+            cache.entries[cache.size++] = {classId, funcThunkIdx};
+        }
+    }
 
     // add apply to opStack so that we know where to continue when we reach RETURN
     interpStack.CtrlPush({op, funcThunkIdx, pc, env.GetBP()});
@@ -1574,6 +1682,11 @@ const IResult& BCHIRInterpreter::GetLastResult() const
     return result;
 }
 
+void BCHIRInterpreter::PrintHeapStats() const
+{
+    arena.PrintStats();
+}
+
 void BCHIRInterpreter::InterpretSwitch()
 {
     pc += 1;
@@ -1666,6 +1779,29 @@ IVal* BCHIRInterpreter::AllocateValue(IVal&& value)
     return ptr;
 }
 
+void BCHIRInterpreter::CollectGarbage()
+{
+    arena.BeginCollection();
+    for (auto& arg : interpStack.GetArgStack()) {
+        arena.MarkRoot(arg);
+    }
+    for (auto& var : env.GetGlobals()) {
+        arena.MarkRoot(var);
+    }
+    for (auto& var : env.GetLocals()) {
+        arena.MarkRoot(var);
+    }
+    if (exception.has_value()) {
+        arena.MarkRoot(IVal{*exception});
+    }
+    if (auto exc = std::get_if<IException>(&result)) {
+        arena.MarkRoot(exc->ptr);
+    } else if (auto success = std::get_if<ISuccess>(&result)) {
+        arena.MarkRoot(success->val);
+    }
+    arena.FinishCollection();
+}
+
 #ifndef NDEBUG
 std::string BCHIRInterpreter::DebugGetPosition(Bchir::ByteCodeIndex index)
 {
@@ -1736,9 +1872,7 @@ template <bool isLiteral, bool isExc> void BCHIRInterpreter::InterpretAllocateRa
 
         array.content.reserve(static_cast<size_t>(size) + 1);
         array.content.emplace_back(std::move(sizeIVal));
-        for (size_t i = 0; i < static_cast<size_t>(size); ++i) {
-            array.content.emplace_back(INullptr());
-        }
+        array.content.resize(static_cast<size_t>(size) + 1, INullptr());
         CJC_ASSERT(array.content.size() == static_cast<size_t>(size) + 1);
     }
     auto ptr = IPointer();
@@ -79,8 +79,10 @@ std::unordered_map<Bchir::ByteCodeIndex, IVal> BCHIRLinker::Run(
     for (const auto& bchir : packages) {
         LinkClasses(bchir);
     }
+    topBchir.LayoutDispatchTables();
 
     topBchir.LinkDefaultFunctions(mName2FuncBodyIdx);
+    FuseSuperInstructions();
     // Used for filename when debugging both below and when running interpreter
     topBchir.packageName = packages.back().packageName;
 
@@ -336,6 +338,70 @@ void BCHIRLinker::AddMangledName(
     }
 }
 
+namespace {
+/** @brief returns the index of the operation following the operation at @p idx in linked bytecode */
+Bchir::ByteCodeIndex NextOpIndex(const Bchir::Definition& def, Bchir::ByteCodeIndex idx)
+{
+    auto op = static_cast<OpCode>(def.Get(idx));
+    auto next = idx + GetOpCodeArgSize(op) + 1;
+    switch (op) {
+        case OpCode::SYSCALL:
+            // argument types
+            return next + def.Get(idx + Bchir::FLAG_TWO) + 1;
+        case OpCode::CAPPLY:
+            // argument types and result type
+            return next + def.Get(idx + 1) + 1;
+        case OpCode::STOREINREF:
+        case OpCode::GETREF:
+        case OpCode::FIELD_TPL:
+            // path
+            return next + def.Get(idx + 1);
+        case OpCode::SWITCH: {
+            // cases (8 bytes each), default target and other targets
+            auto cases = def.Get(idx + Bchir::FLAG_TWO);
+            return next + cases * Bchir::FLAG_TWO + 1 + cases;
+        }
+        default:
+            return next;
+    }
+}
+
+/** @brief returns the superinstruction starting with the operation at @p idx, or INVALID if there is none */
+OpCode SuperInstructionAt(const Bchir::Definition& def, Bchir::ByteCodeIndex idx)
+{
+    if (static_cast<OpCode>(def.Get(idx)) != OpCode::LVAR || idx + Bchir::FLAG_TWO >= def.NextIndex()) {
+        return OpCode::INVALID;
+    }
+    switch (static_cast<OpCode>(def.Get(idx + Bchir::FLAG_TWO))) {
+        case OpCode::LVAR:
+            return OpCode::LVAR_LVAR;
+        case OpCode::FIELD:
+            return OpCode::LVAR_FIELD;
+        case OpCode::BRANCH:
+            return OpCode::LVAR_BRANCH;
+        default:
+            return OpCode::INVALID;
+    }
+}
+} // namespace
+
+void BCHIRLinker::FuseSuperInstructions()
+{
+    Bchir::ByteCodeIndex curr{0};
+    while (curr < topDef.NextIndex()) {
+        auto superOp = SuperInstructionAt(topDef, curr);
+        // LVAR :: LVAR :: FIELD is better fused as LVAR :: LVAR_FIELD, the same goes for BRANCH
+        if (superOp == OpCode::LVAR_LVAR && SuperInstructionAt(topDef, curr + Bchir::FLAG_TWO) != OpCode::INVALID &&
+            SuperInstructionAt(topDef, curr + Bchir::FLAG_TWO) != OpCode::LVAR_LVAR) {
+            superOp = OpCode::INVALID;
+        }
+        if (superOp != OpCode::INVALID) {
+            topDef.SetOp(curr, superOp);
+        }
+        curr = NextOpIndex(topDef, curr);
+    }
+}
+
 void BCHIRLinker::TraverseAndLink(const Bchir& bchir, const Bchir::Definition& currentDef,
     const std::vector<Bchir::ByteCodeContent>& fileMap, const std::vector<Bchir::ByteCodeContent>& typeMap,
     const std::vector<Bchir::ByteCodeContent>& stringMap)
@@ -430,14 +496,14 @@ void BCHIRLinker::TraverseAndLink(const Bchir& bchir, const Bchir::Definition& c
             case OpCode::INVOKE_EXC: {
                 topDef.Push(currentDef.Get(curr + 1)); // number of arguments
                 auto& mgl = currentDef.GetMangledNameAnnotation(curr);
-                topDef.Push(GetMethodId(mgl));                                  // method ID
+                topDef.Push(topBchir.AddInvokeSite(GetMethodId(mgl)));          // invoke site
                 topDef.Push(currentDef.Get(curr + Bchir::FLAG_THREE) + offset); // jump target for when exception
                 break;
             }
             case OpCode::INVOKE: {
                 topDef.Push(currentDef.Get(curr + 1));
                 auto& mgl = currentDef.GetMangledNameAnnotation(curr);
-                topDef.Push(GetMethodId(mgl));
+                topDef.Push(topBchir.AddInvokeSite(GetMethodId(mgl)));
                 break;
             }
             case OpCode::JUMP: {
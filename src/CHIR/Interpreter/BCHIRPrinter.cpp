@@ -549,14 +549,14 @@ void BCHIRPrinter::DefinitionPrinter::PrintOP()
         case OpCode::INVOKE: {
             // number of args
             PrintAtIndex();
-            // name id
+            // name id, or invoke site after linking
             PrintAtIndex();
             return;
         }
         case OpCode::INVOKE_EXC: {
             // number of args
             PrintAtIndex();
-            // name id
+            // name id, or invoke site after linking
             PrintAtIndex();
             // jump target for when exception is raised
             PrintAtIndex();
@@ -644,6 +644,14 @@ void BCHIRPrinter::DefinitionPrinter::PrintOP()
         case OpCode::UNBOX_REF: {
             return;
         }
+        case OpCode::LVAR_LVAR:
+        case OpCode::LVAR_FIELD:
+        case OpCode::LVAR_BRANCH: {
+            // local variable, followed by the second operation of the superinstruction
+            PrintAtIndex();
+            PrintOP();
+            return;
+        }
         default: {
             CJC_ASSERT(false);
             Errorln("Printer not implemented.");
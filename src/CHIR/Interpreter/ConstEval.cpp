@@ -378,6 +378,9 @@ void ConstEvalPass::RunInterpreter(Package& package, std::vector<Bchir>& bchirPa
     Utils::ProfileRecorder::Start("Constant Evaluation", "Evaluate global vars");
     auto res = interpreter.Run(0, false);
     Utils::ProfileRecorder::Stop("Constant Evaluation", "Evaluate global vars");
+    if (opts.constEvalDebug) {
+        interpreter.PrintHeapStats();
+    }
     if (std::holds_alternative<INotRun>(res)) {
         onSuccess(package, interpreter, linker);
     } else if (std::holds_alternative<IException>(res)) {
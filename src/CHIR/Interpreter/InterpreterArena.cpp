@@ -0,0 +1,249 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+// The Cangjie API is in Beta. For details on its capabilities and limitations, please refer to the README file.
+
+/**
+ * @file
+ *
+ * This file implements the garbage collector of the interpreter arena.
+ */
+
+#include "cangjie/CHIR/Interpreter/InterpreterArena.h"
+
+#include <algorithm>
+#include <iostream>
+
+using namespace Cangjie::CHIR::Interpreter;
+
+namespace {
+const std::vector<IVal>* GetContent(const IVal& value)
+{
+    if (auto tuple = IValUtils::GetIf<ITuple>(&value)) {
+        return &tuple->content;
+    } else if (auto array = IValUtils::GetIf<IArray>(&value)) {
+        return &array->content;
+    } else if (auto object = IValUtils::GetIf<IObject>(&value)) {
+        return &object->content;
+    }
+    return nullptr;
+}
+} // namespace
+
+void Arena::BeginCollection()
+{
+    CJC_ASSERT(worklist.empty());
+    marks.resize(buckets.size());
+    bucketStarts.clear();
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        marks[i].assign(buckets[i]->size(), 0);
+        bucketStarts.emplace_back(buckets[i]->data(), i);
+    }
+    std::sort(bucketStarts.begin(), bucketStarts.end());
+    interiorPointers.clear();
+    unresolvedInteriors.clear();
+    contentRanges.clear();
+    contentRangesBuilt = false;
+}
+
+void Arena::MarkRoot(const IVal& root)
+{
+    TraceContent(root);
+    Drain();
+}
+
+void Arena::MarkRoot(const IValStack& root)
+{
+    std::visit(
+        [this](const auto& arg) {
+            using T = std::decay_t<decltype(arg)>;
+            if constexpr (std::is_same_v<T, IPointer>) {
+                Reach(arg.content);
+            } else if constexpr (std::is_same_v<T, ITuplePtr> || std::is_same_v<T, IArrayPtr> ||
+                std::is_same_v<T, IObjectPtr>) {
+                for (auto& elem : *arg.contentPtr) {
+                    worklist.emplace_back(&elem);
+                }
+            }
+        },
+        root);
+    Drain();
+}
+
+void Arena::FinishCollection()
+{
+    for (auto ptr : finalizingObjects) {
+        Reach(ptr);
+    }
+    Drain();
+    MarkOwnersOfInteriorPointers();
+    Sweep();
+    marks.clear();
+    bucketStarts.clear();
+    interiorPointers.clear();
+    unresolvedInteriors.clear();
+    contentRanges.clear();
+}
+
+bool Arena::MarkSlot(const IVal* ptr)
+{
+    // the last bucket starting at or before ptr is the only one which may contain it
+    auto it = std::upper_bound(bucketStarts.begin(), bucketStarts.end(), std::make_pair(ptr, buckets.size()));
+    if (it == bucketStarts.begin()) {
+        return false;
+    }
+    --it;
+    auto [start, bucketIdx] = *it;
+    auto slotIdx = static_cast<size_t>(ptr - start);
+    if (slotIdx >= marks[bucketIdx].size()) {
+        return false;
+    }
+    if (marks[bucketIdx][slotIdx] == 0) {
+        marks[bucketIdx][slotIdx] = 1;
+        worklist.emplace_back(ptr);
+    }
+    return true;
+}
+
+void Arena::Reach(const IVal* ptr)
+{
+    if (ptr == nullptr || MarkSlot(ptr)) {
+        return;
+    }
+    // Not a slot, the pointer points inside another value or to a variable of the environment.
+    if (interiorPointers.emplace(ptr).second) {
+        worklist.emplace_back(ptr);
+        unresolvedInteriors.emplace_back(ptr);
+    }
+}
+
+void Arena::TraceContent(const IVal& value)
+{
+    if (auto ptr = IValUtils::GetIf<IPointer>(&value)) {
+        Reach(ptr->content);
+        return;
+    }
+    if (auto content = GetContent(value)) {
+        for (auto& elem : *content) {
+            worklist.emplace_back(&elem);
+        }
+    }
+}
+
+void Arena::Drain()
+{
+    while (!worklist.empty()) {
+        auto value = worklist.back();
+        worklist.pop_back();
+        TraceContent(*value);
+    }
+}
+
+void Arena::AddContentRanges(const IVal& value, const IVal* owner)
+{
+    auto content = GetContent(value);
+    if (content == nullptr || content->empty()) {
+        return;
+    }
+    contentRanges.emplace_back(ContentRange{content->data(), content->data() + content->size(), owner});
+    for (auto& elem : *content) {
+        AddContentRanges(elem, owner);
+    }
+}
+
+void Arena::BuildContentRanges()
+{
+    for (auto& bucket : buckets) {
+        for (auto& slot : *bucket) {
+            AddContentRanges(slot, &slot);
+        }
+    }
+    // Content buffers are distinct allocations, so the ranges never overlap.
+    std::sort(contentRanges.begin(), contentRanges.end(),
+        [](const ContentRange& lhs, const ContentRange& rhs) { return lhs.begin < rhs.begin; });
+    contentRangesBuilt = true;
+}
+
+const IVal* Arena::FindOwner(const IVal* interior) const
+{
+    // the last range starting at or before the pointer is the only one which may contain it
+    auto it = std::upper_bound(contentRanges.begin(), contentRanges.end(), interior,
+        [](const IVal* ptr, const ContentRange& range) { return ptr < range.begin; });
+    if (it == contentRanges.begin()) {
+        return nullptr;
+    }
+    --it;
+    return interior < it->end ? it->owner : nullptr;
+}
+
+void Arena::MarkOwnersOfInteriorPointers()
+{
+    // The heap does not change during a collection, so the owners of all interior pointers, including the ones
+    // reached from newly marked owners, are looked up in one index of the content buffers.
+    while (!unresolvedInteriors.empty()) {
+        if (!contentRangesBuilt) {
+            BuildContentRanges();
+        }
+        auto interior = unresolvedInteriors.back();
+        unresolvedInteriors.pop_back();
+        // Pointers to variables of the environment have no owner in the arena.
+        if (auto owner = FindOwner(interior)) {
+            (void)MarkSlot(owner);
+            Drain();
+        }
+    }
+}
+
+void Arena::Sweep()
+{
+    size_t liveValues = 0;
+    size_t freedValues = 0;
+    std::vector<Bucket> keptBuckets;
+    keptBuckets.reserve(BUCKETS);
+    freeSlots.clear();
+    for (size_t b = 0; b < buckets.size(); ++b) {
+        auto& bucket = *buckets[b];
+        auto live = static_cast<size_t>(std::count(marks[b].begin(), marks[b].end(), 1));
+        liveValues += live;
+        // The last bucket is the one new values are appended to, so it is always kept.
+        if (live == 0 && b + 1 != buckets.size()) {
+            freedValues += static_cast<size_t>(std::count_if(bucket.begin(), bucket.end(),
+                [](const IVal& v) { return !std::holds_alternative<IInvalid>(v); }));
+            ++stats.releasedBuckets;
+            continue;
+        }
+        for (size_t i = 0; i < bucket.size(); ++i) {
+            if (marks[b][i] != 0) {
+                continue;
+            }
+            if (!std::holds_alternative<IInvalid>(bucket[i])) {
+                bucket[i] = IInvalid();
+                ++freedValues;
+            }
+            freeSlots.emplace_back(&bucket[i]);
+        }
+        keptBuckets.emplace_back(std::move(buckets[b]));
+    }
+    buckets = std::move(keptBuckets);
+    // Reuse the slots with the lowest addresses first.
+    std::reverse(freeSlots.begin(), freeSlots.end());
+
+    ++stats.collections;
+    stats.freedValues += freedValues;
+    stats.maxLiveValues = std::max(stats.maxLiveValues, liveValues);
+    allocatedSinceCollection = 0;
+    collectionThreshold = std::max(minCollectionThreshold, liveValues);
+}
+
+void Arena::PrintStats() const
+{
+    std::cout << "Number of buckets: " << buckets.size() << std::endl;
+    std::cout << "Number of collections: " << stats.collections << std::endl;
+    std::cout << "Number of freed values: " << stats.freedValues << std::endl;
+    std::cout << "Number of released buckets: " << stats.releasedBuckets << std::endl;
+    std::cout << "Max number of live values after a collection: " << stats.maxLiveValues << std::endl;
+    std::cout << "Allocated size: " << GetAllocatedSize() << std::endl;
+}
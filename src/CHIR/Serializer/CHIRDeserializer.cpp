@@ -21,6 +21,7 @@
 #include "cangjie/CHIR/Utils.h"
 #include "cangjie/Utils/FileUtil.h"
 #include "cangjie/Utils/ICEUtil.h"
+#include "cangjie/Utils/ReadOnlyBuffer.h"
 #include "cangjie/Basic/Version.h"
 #include "CHIRDeserializerImpl.h"
 #include "cangjie/CHIR/Serializer/CHIRDeserializer.h"
@@ -48,9 +49,10 @@ bool CHIRDeserializer::Deserialize(const std::string& fileName, Cangjie::CHIR::C
         return false;
     }
     CHIRDeserializerImpl deserializer(chirBuilder, compilePlatform);
-    std::vector<uint8_t> serializationInfo;
     std::string failedReason;
-    if (!FileUtil::ReadBinaryFileToBuffer(fileName, serializationInfo, failedReason)) {
+    // The package is deserialized in place from a read-only mapping of the file.
+    auto serializationInfo = Utils::ReadOnlyBuffer::FromFile(fileName, failedReason);
+    if (!serializationInfo) {
         Errorln(failedReason, ".");
         return false;
     }
@@ -58,13 +60,13 @@ bool CHIRDeserializer::Deserialize(const std::string& fileName, Cangjie::CHIR::C
     flatbuffers::Verifier::Options options;
     options.max_depth = std::numeric_limits<::flatbuffers::uoffset_t>::max();
     options.max_tables = std::numeric_limits<::flatbuffers::uoffset_t>::max();
-    flatbuffers::Verifier verifier(serializationInfo.data(), serializationInfo.size(), options);
+    flatbuffers::Verifier verifier(serializationInfo->Data(), serializationInfo->Size(), options);
     if (!verifier.VerifyBuffer<PackageFormat::CHIRPackage>()) {
         Errorln("validation of '", fileName, "' failed, please confirm it was created by compiler whose version is '",
             CANGJIE_VERSION, "'.");
         return false;
     }
-    const PackageFormat::CHIRPackage* package = PackageFormat::GetCHIRPackage(serializationInfo.data());
+    const PackageFormat::CHIRPackage* package = PackageFormat::GetCHIRPackage(serializationInfo->Data());
     deserializer.Run(package);
     phase = Cangjie::CHIR::ToCHIR::Phase(package->phase());
     return true;
@@ -0,0 +1,191 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+// The Cangjie API is in Beta. For details on its capabilities and limitations, please refer to the README file.
+
+#include "cangjie/CHIR/Transformation/AllocateSplitter.h"
+
+#include "cangjie/CHIR/CHIRCasting.h"
+
+using namespace Cangjie::CHIR;
+
+namespace {
+std::vector<uint64_t> DropFirstIndex(const std::vector<uint64_t>& path)
+{
+    return std::vector<uint64_t>(path.begin() + 1, path.end());
+}
+} // namespace
+
+namespace Cangjie::CHIR {
+bool IsOnlyReadAndWritten(const Value& ref, const BlockGroup& body, const EscapeAnalysis* escapeAnalysis)
+{
+    for (auto user : ref.GetUsers()) {
+        // The uses in nested BlockGroups, e.g. of lambdas, would not be replaced.
+        if (user->GetParentBlockGroup() != &body) {
+            return false;
+        }
+        switch (user->GetExprKind()) {
+            case ExprKind::DEBUGEXPR:
+            case ExprKind::LOAD:
+                break;
+            case ExprKind::STORE:
+                if (StaticCast<Store*>(user)->GetLocation() != &ref) {
+                    return false;
+                }
+                break;
+            case ExprKind::STORE_ELEMENT_REF:
+                if (StaticCast<StoreElementRef*>(user)->GetLocation() != &ref) {
+                    return false;
+                }
+                break;
+            case ExprKind::GET_ELEMENT_REF:
+                if (!IsOnlyReadAndWritten(*user->GetResult(), body, escapeAnalysis)) {
+                    return false;
+                }
+                break;
+            case ExprKind::APPLY:
+            case ExprKind::APPLY_WITH_EXCEPTION:
+                if (escapeAnalysis == nullptr || escapeAnalysis->IsEscapingThroughCall(*user, ref)) {
+                    return false;
+                }
+                break;
+            default:
+                return false;
+        }
+    }
+    return true;
+}
+
+bool IsElementPath(const std::vector<uint64_t>& path, const std::vector<Type*>& elementTys, const Type* resultTy)
+{
+    return !path.empty() && path[0] < elementTys.size() && (path.size() > 1 || resultTy == elementTys[path[0]]);
+}
+} // namespace Cangjie::CHIR
+
+AllocateSplitter::AllocateSplitter(
+    Allocate& allocate, std::vector<Type*> elementTys, const BlockGroup& body, CHIRBuilder& builder)
+    : allocate(allocate), elementTys(std::move(elementTys)), body(body), builder(builder)
+{
+}
+
+std::vector<Allocate*> AllocateSplitter::Run()
+{
+    for (auto user : allocate.GetResult()->GetUsers()) {
+        switch (user->GetExprKind()) {
+            case ExprKind::GET_ELEMENT_REF:
+                SplitGetElementRef(*StaticCast<GetElementRef*>(user));
+                break;
+            case ExprKind::STORE_ELEMENT_REF:
+                SplitStoreElementRef(*StaticCast<StoreElementRef*>(user));
+                break;
+            case ExprKind::STORE:
+                SplitStore(*StaticCast<Store*>(user));
+                break;
+            case ExprKind::LOAD:
+                SplitLoad(*StaticCast<Load*>(user));
+                break;
+            case ExprKind::DEBUGEXPR:
+                // Without -g, Debug only serves the unused variable warnings, which are already reported.
+                user->RemoveSelfFromBlock();
+                break;
+            default:
+                user->RemoveSelfFromBlock();
+                break;
+        }
+    }
+    allocate.RemoveSelfFromBlock();
+    return std::move(elementAllocs);
+}
+
+LocalVar* AllocateSplitter::GetElementAlloc(uint64_t index)
+{
+    auto& ref = elementRefs[index];
+    if (ref == nullptr) {
+        auto elementTy = elementTys[index];
+        auto elementAlloc = builder.CreateExpression<Allocate>(allocate.GetDebugLocation(),
+            builder.GetType<RefType>(elementTy), elementTy, allocate.GetParentBlock());
+        elementAlloc->MoveBefore(&allocate);
+        ref = elementAlloc->GetResult();
+        elementAllocs.emplace_back(elementAlloc);
+    }
+    return ref;
+}
+
+void AllocateSplitter::SplitGetElementRef(GetElementRef& user)
+{
+    auto& path = user.GetPath();
+    auto elementRef = GetElementAlloc(path[0]);
+    if (path.size() == 1) {
+        user.GetResult()->ReplaceWith(*elementRef, &body);
+        user.RemoveSelfFromBlock();
+    } else {
+        user.ReplaceWith(*builder.CreateExpression<GetElementRef>(user.GetDebugLocation(),
+            user.GetResult()->GetType(), elementRef, DropFirstIndex(path), user.GetParentBlock()));
+    }
+}
+
+void AllocateSplitter::SplitStoreElementRef(StoreElementRef& user)
+{
+    auto& path = user.GetPath();
+    auto elementRef = GetElementAlloc(path[0]);
+    if (path.size() == 1) {
+        user.ReplaceWith(*builder.CreateExpression<Store>(
+            user.GetDebugLocation(), builder.GetUnitTy(), user.GetValue(), elementRef, user.GetParentBlock()));
+    } else {
+        user.ReplaceWith(*builder.CreateExpression<StoreElementRef>(user.GetDebugLocation(), builder.GetUnitTy(),
+            user.GetValue(), elementRef, DropFirstIndex(path), user.GetParentBlock()));
+    }
+}
+
+void AllocateSplitter::SplitStore(Store& user)
+{
+    auto value = user.GetValue();
+    // The elements of a freshly built aggregate are stored directly, the aggregate may then become dead.
+    Expression* tuple = nullptr;
+    if (value->IsLocalVar() && StaticCast<LocalVar*>(value)->GetExpr()->GetExprKind() == ExprKind::TUPLE) {
+        tuple = StaticCast<LocalVar*>(value)->GetExpr();
+    }
+    for (uint64_t i = 0; i < elementTys.size(); ++i) {
+        Value* element = nullptr;
+        if (tuple != nullptr) {
+            element = tuple->GetOperand(i);
+        } else {
+            auto field = builder.CreateExpression<Field>(
+                user.GetDebugLocation(), elementTys[i], value, std::vector<uint64_t>{i}, user.GetParentBlock());
+            field->MoveBefore(&user);
+            element = field->GetResult();
+        }
+        auto store = builder.CreateExpression<Store>(
+            user.GetDebugLocation(), builder.GetUnitTy(), element, GetElementAlloc(i), user.GetParentBlock());
+        store->MoveBefore(&user);
+    }
+    user.RemoveSelfFromBlock();
+}
+
+void AllocateSplitter::SplitLoad(Load& user)
+{
+    // The elements are loaded where the aggregate was, later stores must not be observed.
+    std::unordered_map<uint64_t, LocalVar*> elements;
+    for (auto fieldUser : user.GetResult()->GetUsers()) {
+        auto field = StaticCast<Field*>(fieldUser);
+        auto path = field->GetPath();
+        auto& element = elements[path[0]];
+        if (element == nullptr) {
+            auto load = builder.CreateExpression<Load>(
+                user.GetDebugLocation(), elementTys[path[0]], GetElementAlloc(path[0]), user.GetParentBlock());
+            load->MoveBefore(&user);
+            element = load->GetResult();
+        }
+        if (path.size() == 1) {
+            field->GetResult()->ReplaceWith(*element, &body);
+            field->RemoveSelfFromBlock();
+        } else {
+            field->ReplaceWith(*builder.CreateExpression<Field>(field->GetDebugLocation(),
+                field->GetResult()->GetType(), element, DropFirstIndex(path), field->GetParentBlock()));
+        }
+    }
+    user.RemoveSelfFromBlock();
+}
@@ -0,0 +1,185 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+// The Cangjie API is in Beta. For details on its capabilities and limitations, please refer to the README file.
+
+/**
+ * @file
+ *
+ * This file implements the BottomUpInliner class.
+ */
+
+#include "cangjie/CHIR/Transformation/BottomUpInliner.h"
+
+#include <algorithm>
+
+#include "cangjie/Basic/StringConvertor.h"
+#include "cangjie/CHIR/Transformation/FunctionPassManager.h"
+#include "cangjie/CHIR/Transformation/MergeBlocks.h"
+
+using namespace Cangjie::CHIR;
+
+namespace {
+// The package may grow by the size of itself through inlining, and at least by this many expressions
+constexpr size_t GROWTH_BUDGET_PERCENT = 100;
+constexpr size_t MIN_GROWTH_BUDGET = 1000;
+constexpr size_t PERCENT = 100;
+
+bool IsSkipped(const Func& func)
+{
+    // 1. $toAny is a function needed by reflection, it's used by runtime and it mustn't be optimized
+    // 2. annotation factory functions mustn't be optimized
+    return func.GetSrcCodeIdentifier() == "$toAny" || func.GetFuncKind() == FuncKind::ANNOFACTORY_FUNC;
+}
+
+size_t GetSCCSize(const std::vector<Func*>& scc)
+{
+    size_t size = 0;
+    for (auto func : scc) {
+        size += FunctionInline::GetFuncSize(*func);
+    }
+    return size;
+}
+} // namespace
+
+BottomUpInliner::BottomUpInliner(
+    CHIRBuilder& builder, const GlobalOptions& opts, const PGOProfile* profile, AnalysisManager* analysisManager)
+    : builder(builder), opts(opts), profile(profile), analysisManager(analysisManager)
+{
+}
+
+void BottomUpInliner::Run(const Package& package, const CallGraphAnalysis& callGraph, bool recordRemarks)
+{
+    size_t packageSize = 0;
+    for (auto func : package.GetGlobalFuncs()) {
+        packageSize += FunctionInline::GetFuncSize(*func);
+        if (FunctionInline::IsOnlyCalledOnce(*func)) {
+            calledOnceFuncs.emplace(func);
+        }
+    }
+    remainingBudget = std::max(MIN_GROWTH_BUDGET, packageSize * GROWTH_BUDGET_PERCENT / PERCENT);
+
+    // The callees of an SCC come before it in post order, so its level is known when it is reached.
+    auto& sccs = callGraph.postOrderSCCs;
+    std::unordered_map<const Func*, size_t> sccIndexes;
+    std::vector<size_t> levels(sccs.size(), 0);
+    std::vector<std::vector<const std::vector<Func*>*>> sccsByLevel;
+    for (size_t idx = 0; idx < sccs.size(); ++idx) {
+        for (auto func : sccs[idx]) {
+            sccIndexes.emplace(func, idx);
+        }
+        for (auto func : sccs[idx]) {
+            auto callees = callGraph.directCallees.find(func);
+            if (callees == callGraph.directCallees.end()) {
+                continue;
+            }
+            for (auto callee : callees->second) {
+                auto calleeIdx = sccIndexes.find(callee);
+                if (calleeIdx != sccIndexes.end() && calleeIdx->second != idx) {
+                    levels[idx] = std::max(levels[idx], levels[calleeIdx->second] + 1);
+                }
+            }
+        }
+        if (sccsByLevel.size() <= levels[idx]) {
+            sccsByLevel.resize(levels[idx] + 1);
+        }
+        sccsByLevel[levels[idx]].emplace_back(&sccs[idx]);
+    }
+    for (auto& levelSCCs : sccsByLevel) {
+        RunOnLevel(levelSCCs, recordRemarks);
+    }
+}
+
+void BottomUpInliner::RunOnLevel(const std::vector<const std::vector<Func*>*>& sccs, bool recordRemarks)
+{
+    // The budget left by the former levels is split among the SCCs of this level in proportion to their sizes, so
+    // that the SCCs may be inlined into concurrently and the decisions don't depend on the number of threads.
+    std::vector<size_t> budgets;
+    size_t levelSize = 0;
+    for (auto scc : sccs) {
+        budgets.emplace_back(GetSCCSize(*scc));
+        levelSize += budgets.back();
+    }
+    for (auto& budget : budgets) {
+        budget = levelSize == 0 ? 0 : remainingBudget * budget / levelSize;
+    }
+    // Every SCC only changes itself and reads the finished levels.
+    std::vector<SCCResult> results(sccs.size());
+    ParallelFor(builder, opts.GetJobs(), sccs.size(),
+        [this, &sccs, &budgets, &results, recordRemarks](size_t idx, CHIRBuilder& subBuilder) {
+            RunOnSCC(*sccs[idx], subBuilder, budgets[idx], results[idx], recordRemarks);
+        });
+    for (auto& result : results) {
+        for (auto [func, size] : result.funcSizes) {
+            funcSizes.emplace(func, size);
+            // Every function of an SCC may have been inlined into or simplified.
+            if (analysisManager != nullptr) {
+                analysisManager->MarkChanged(*func);
+            }
+        }
+        growth += result.growth;
+        // mandatory inlines are charged even beyond the budget
+        remainingBudget -= std::min(remainingBudget, result.growth);
+        MergeEffectMap(result.effectMap, effectMap);
+        remarks.insert(remarks.end(), result.remarks.begin(), result.remarks.end());
+    }
+}
+
+void BottomUpInliner::RunOnSCC(const std::vector<Func*>& scc, CHIRBuilder& subBuilder, size_t budget,
+    SCCResult& result, bool recordRemarks) const
+{
+    auto pass = FunctionInline(subBuilder, opts.optimizationLevel, opts.chirDebugOptimizer, profile);
+    pass.SetPackageInfo(funcSizes, calledOnceFuncs);
+    pass.SetGrowthBudget(budget);
+    if (recordRemarks) {
+        pass.SetRemarks(&result.remarks);
+    }
+    for (auto func : scc) {
+        if (!IsSkipped(*func)) {
+            pass.Run(*func);
+        }
+    }
+    // Nothing is inlined into the SCC any more, so it is simplified before its callers inline it.
+    for (auto func : scc) {
+        if (!func->TestAttr(Attribute::SKIP_ANALYSIS)) {
+            MergeBlocks::RunOnFunc(*func->GetBody(), subBuilder, opts);
+        }
+        result.funcSizes.emplace_back(func, FunctionInline::GetFuncSize(*func));
+    }
+    result.growth = pass.GetGrowth();
+    result.effectMap = pass.GetEffectMap();
+}
+
+const OptEffectCHIRMap& BottomUpInliner::GetEffectMap() const
+{
+    return effectMap;
+}
+
+const std::vector<InlineRemark>& BottomUpInliner::GetRemarks() const
+{
+    return remarks;
+}
+
+size_t BottomUpInliner::GetGrowth() const
+{
+    return growth;
+}
+
+std::string BottomUpInliner::RemarksToJsonLines(const std::vector<InlineRemark>& remarks)
+{
+    auto quote = [](const std::string& str) { return "\"" + StringConvertor::EscapeToJsonString(str) + "\""; };
+    std::string lines;
+    for (auto& remark : remarks) {
+        auto [line, column] = remark.loc.GetBeginPos();
+        lines += "{\"pass\":\"inline\",\"caller\":" + quote(remark.caller->GetIdentifierWithoutPrefix()) +
+            ",\"callee\":" + quote(remark.callee->GetIdentifierWithoutPrefix()) +
+            ",\"file\":" + quote(remark.loc.GetAbsPath()) + ",\"line\":" + std::to_string(line) +
+            ",\"column\":" + std::to_string(column) + ",\"inlined\":" + (remark.inlined ? "true" : "false") +
+            ",\"reason\":" + quote(remark.reason) + ",\"calleeSize\":" + std::to_string(remark.calleeSize) +
+            ",\"threshold\":" + std::to_string(remark.threshold) + "}\n";
+    }
+    return lines;
+}
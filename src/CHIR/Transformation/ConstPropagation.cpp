@@ -35,6 +35,7 @@ void ConstPropagation::RunOnFunc(const Ptr<const Func>& func, bool isDebug, bool
     auto result = analysisWrapper->CheckFuncResult(func);
     CJC_ASSERT(result);
 
+    isSimplified = false;
     std::vector<RewriteInfo> toBeRewrited;
     const auto actionBeforeVisitExpr = [](const ConstDomain&, Expression*, size_t) {};
     const auto actionAfterVisitExpr = [this, &toBeRewrited, func, isDebug, isCJLint](
@@ -105,6 +106,9 @@ void ConstPropagation::RunOnFunc(const Ptr<const Func>& func, bool isDebug, bool
     if (!targetSuccMap.empty()) {
         funcsNeedRemoveBlocks.push_back(func.get());
     }
+    if (isSimplified || !toBeRewrited.empty() || !targetSuccMap.empty()) {
+        changedFuncs.push_back(func.get());
+    }
 }
 
 const OptEffectCHIRMap& ConstPropagation::GetEffectMap() const
@@ -116,6 +120,11 @@ const std::vector<const Func*>& ConstPropagation::GetFuncsNeedRemoveBlocks() con
 {
     return funcsNeedRemoveBlocks;
 }
+
+const std::vector<const Func*>& ConstPropagation::GetChangedFuncs() const
+{
+    return changedFuncs;
+}
 Ptr<LiteralValue> ConstPropagation::GenerateConstExpr(
     const Ptr<Type>& type, const Ptr<const ConstValue>& constVal, bool isCJLint)
 {
@@ -251,7 +260,7 @@ void ConstPropagation::RewriteToConstExpr(const RewriteInfo& rewriteInfo, bool i
     }
 }
 
-void ConstPropagation::TrySimplifyingUnaryExpr(const Ptr<UnaryExpression>& unary, bool isDebug) const
+void ConstPropagation::TrySimplifyingUnaryExpr(const Ptr<UnaryExpression>& unary, bool isDebug)
 {
     if (SkipCP(*unary, opts)) {
         return;
@@ -279,8 +288,9 @@ void ConstPropagation::TrySimplifyingUnaryExpr(const Ptr<UnaryExpression>& unary
 }
 
 void ConstPropagation::ReplaceUsageOfExprResult(
-    const Ptr<const Expression>& expr, const Ptr<Value>& newVal, bool isDebug) const
+    const Ptr<const Expression>& expr, const Ptr<Value>& newVal, bool isDebug)
 {
+    isSimplified = true;
     // note: The scope of rewriting should be revised when nested block groups occur.
     expr->GetResult()->ReplaceWith(*newVal, expr->GetParentBlockGroup());
 
@@ -12,27 +12,35 @@
 #include "cangjie/CHIR/Analysis/DevirtualizationInfo.h"
 #include "cangjie/CHIR/Analysis/Engine.h"
 #include "cangjie/CHIR/Analysis/Utils.h"
+#include "cangjie/CHIR/Expression/Terminator.h"
 #include "cangjie/CHIR/Type/Type.h"
 #include "cangjie/CHIR/UserDefinedType.h"
 #include "cangjie/CHIR/Utils.h"
 #include "cangjie/CHIR/Transformation/BlockGroupCopyHelper.h"
 #include "cangjie/Mangle/CHIRManglingUtils.h"
 namespace Cangjie::CHIR {
+// The least profiled calls to a target for which the guard of speculation pays off
+constexpr static uint64_t SPECULATION_MIN_COUNT = 1000;
+// The least percentage of the profiled calls of a method which go to the speculated target
+constexpr static uint64_t SPECULATION_MIN_PERCENT = 80;
+constexpr static uint64_t PERCENT = 100;
 
 Devirtualization::Devirtualization(
-    TypeAnalysisWrapper* typeAnalysisWrapper, DevirtualizationInfo& devirtFuncInfo)
-    : analysisWrapper(typeAnalysisWrapper), devirtFuncInfo(devirtFuncInfo)
+    TypeAnalysisWrapper* typeAnalysisWrapper, DevirtualizationInfo& devirtFuncInfo, const PGOProfile* profile)
+    : analysisWrapper(typeAnalysisWrapper), devirtFuncInfo(devirtFuncInfo), profile(profile)
 {
 }
 
 void Devirtualization::RunOnFuncs(const std::vector<Func*>& funcs, CHIRBuilder& builder, bool isDebug)
 {
     rewriteInfos.clear();
+    speculationCandidates.clear();
     for (auto func : funcs) {
         RunOnFunc(func, builder);
     }
     RewriteToApply(builder, rewriteInfos, isDebug);
     InstantiateFuncIfPossible(builder, rewriteInfos);
+    SpeculateByProfile(builder, isDebug);
 }
 
 void Devirtualization::RunOnFunc(const Func* func, CHIRBuilder& builder)
@@ -44,8 +52,14 @@ void Devirtualization::RunOnFunc(const Func* func, CHIRBuilder& builder)
     CJC_ASSERT(result);
 
     std::optional<std::unordered_set<const GenericType*>> visibleGenericTypes = std::nullopt;
-    const auto actionBeforeVisitExpr =
-        [this, &builder, &visibleGenericTypes, func](const TypeDomain& state, Expression* expr, size_t) {
+    // The profile of a function doesn't cover the lambdas in it.
+    const auto addSpeculationCandidate = [this, func](Invoke* invoke) {
+        if (profile != nullptr && invoke->GetParentBlockGroup() == func->GetBody()) {
+            speculationCandidates.emplace_back(func, invoke);
+        }
+    };
+    const auto actionBeforeVisitExpr = [this, &builder, &visibleGenericTypes, &addSpeculationCandidate, func](
+                                           const TypeDomain& state, Expression* expr, size_t) {
         if (expr->GetExprKind() != ExprKind::INVOKE) {
             return;
         }
@@ -55,6 +69,7 @@ void Devirtualization::RunOnFunc(const Func* func, CHIRBuilder& builder)
         // Obtains the state information of the invoke operation object.
         auto resVal = state.CheckAbstractValue(invokeAbsObject);
         if (!resVal) {
+            addSpeculationCandidate(invoke);
             return;
         }
         std::vector<Type*> paramTys;
@@ -65,6 +80,7 @@ void Devirtualization::RunOnFunc(const Func* func, CHIRBuilder& builder)
         auto [realCallee, thisType] = FindRealCallee(builder, resVal,
             {invoke->GetMethodName(), std::move(paramTys), invoke->GetInstantiatedTypeArgs()});
         if (!realCallee) {
+            addSpeculationCandidate(invoke);
             return;
         }
         if (thisType->IsGenericRelated()) {
@@ -268,6 +284,140 @@ void Devirtualization::AppendFrozenFuncState(const Func* func, std::unique_ptr<R
     frozenStates.emplace(func, std::move(analysisRes));
 }
 
+size_t Devirtualization::GetSpeculatedNum() const
+{
+    return speculatedNum;
+}
+
+std::pair<FuncBase*, ClassType*> Devirtualization::FindProfiledCallee(
+    CHIRBuilder& builder, const Func& caller, const Invoke& invoke) const
+{
+    // The indirect call sites of the profile can't be mapped to invokes, the targets of a caller are filtered by
+    // the implementations of the invoked method instead.
+    auto callerProfile = profile->GetFuncProfile(caller);
+    if (callerProfile == nullptr || callerProfile->callTargets.empty() ||
+        !invoke.GetInstantiatedTypeArgs().empty() || invoke.GetResultType()->IsNothing()) {
+        return {nullptr, nullptr};
+    }
+    auto staticType = DynamicCast<ClassType*>(invoke.GetObject()->GetType()->StripAllRefs());
+    if (staticType == nullptr || staticType->IsGenericRelated()) {
+        return {nullptr, nullptr};
+    }
+    std::vector<Type*> paramTys;
+    for (auto param : invoke.GetOperands()) {
+        paramTys.emplace_back(param->GetType());
+    }
+    FuncSig method{invoke.GetMethodName(), std::move(paramTys), {}};
+
+    // Parents are visited before their subclasses, so every target is guarded by the topmost class implementing it.
+    std::unordered_map<FuncBase*, ClassType*> targets;
+    std::vector<ClassType*> worklist{staticType};
+    std::unordered_set<const ClassDef*> visited;
+    auto& subtypeMap = devirtFuncInfo.GetSubtypeMap();
+    while (!worklist.empty()) {
+        auto specific = worklist.back();
+        worklist.pop_back();
+        auto specificDef = specific->GetClassDef();
+        if (!visited.emplace(specificDef).second) {
+            continue;
+        }
+        auto target = GetCandidateFromSpecificType(builder, *specific, method);
+        if (target != nullptr && !target->IsInGenericContext()) {
+            targets.emplace(target, specific);
+        }
+        if (auto it = subtypeMap.find(specificDef); it != subtypeMap.end()) {
+            for (auto& inheritInfo : it->second) {
+                auto subtype = DynamicCast<ClassType*>(inheritInfo.subType);
+                if (subtype != nullptr && !subtype->IsGenericRelated()) {
+                    worklist.emplace_back(subtype);
+                }
+            }
+        }
+    }
+
+    uint64_t totalCount = 0;
+    uint64_t hottestCount = 0;
+    std::pair<FuncBase*, ClassType*> hottest{nullptr, nullptr};
+    for (auto [target, specific] : targets) {
+        auto it = callerProfile->callTargets.find(target->GetIdentifierWithoutPrefix());
+        if (it == callerProfile->callTargets.end()) {
+            continue;
+        }
+        totalCount += it->second;
+        if (it->second > hottestCount) {
+            hottestCount = it->second;
+            hottest = {target, specific};
+        }
+    }
+    if (hottestCount < SPECULATION_MIN_COUNT || hottestCount * PERCENT < totalCount * SPECULATION_MIN_PERCENT) {
+        return {nullptr, nullptr};
+    }
+    // The guard holds for the subclasses too, none of which may override the target.
+    std::pair<FuncBase*, Type*> unique{nullptr, nullptr};
+    CollectCandidates(builder, hottest.second, unique, method);
+    if (unique.first != hottest.first) {
+        return {nullptr, nullptr};
+    }
+    return hottest;
+}
+
+Invoke* Devirtualization::GuardByInstanceOf(CHIRBuilder& builder, Invoke& invoke, ClassType& expected)
+{
+    auto block = invoke.GetParentBlock();
+    auto blockGroup = block->GetParentBlockGroup();
+    auto loc = invoke.GetDebugLocation();
+    // 1. the expressions after the invoke are moved to the block both paths join in
+    auto exprs = block->GetExpressions();
+    auto joinBlock = builder.CreateBlock(blockGroup);
+    for (auto it = std::find(exprs.begin(), exprs.end(), &invoke) + 1; it != exprs.end(); ++it) {
+        (*it)->MoveTo(*joinBlock);
+    }
+    // 2. the result of the invoke is passed to the join block by memory
+    auto resultTy = invoke.GetResultType();
+    auto slot = builder.CreateExpression<Allocate>(loc, builder.GetType<RefType>(resultTy), resultTy, block);
+    slot->MoveBefore(&invoke);
+    auto load = builder.CreateExpression<Load>(loc, resultTy, slot->GetResult(), joinBlock);
+    load->MoveBefore(joinBlock->GetExpressions().front());
+    invoke.GetResult()->ReplaceWith(*load->GetResult(), blockGroup);
+    // 3. the expected callee is called directly on the fast path, and virtually on the slow path
+    auto cond = builder.CreateExpression<InstanceOf>(
+        loc, builder.GetBoolTy(), invoke.GetObject(), builder.GetType<RefType>(&expected), block);
+    cond->MoveBefore(&invoke);
+    auto fastBlock = builder.CreateBlock(blockGroup);
+    auto slowBlock = builder.CreateBlock(blockGroup);
+    auto fastInvoke = StaticCast<Invoke*>(static_cast<const Expression&>(invoke).Clone(builder, *fastBlock));
+    fastInvoke->SetDebugLocation(loc);
+    invoke.MoveTo(*slowBlock);
+    for (auto [pathBlock, call] : {std::make_pair(fastBlock, fastInvoke), std::make_pair(slowBlock, &invoke)}) {
+        pathBlock->AppendExpression(builder.CreateExpression<Store>(
+            loc, builder.GetUnitTy(), call->GetResult(), slot->GetResult(), pathBlock));
+        pathBlock->AppendExpression(builder.CreateTerminator<GoTo>(loc, joinBlock, pathBlock));
+    }
+    block->AppendExpression(builder.CreateTerminator<Branch>(loc, cond->GetResult(), fastBlock, slowBlock, block));
+    return fastInvoke;
+}
+
+void Devirtualization::SpeculateByProfile(CHIRBuilder& builder, bool isDebug)
+{
+    std::vector<RewriteInfo> speculatedInfos;
+    for (auto [caller, invoke] : speculationCandidates) {
+        auto [callee, expected] = FindProfiledCallee(builder, *caller, *invoke);
+        if (callee == nullptr) {
+            continue;
+        }
+        if (isDebug) {
+            std::string message = "[Devirtualization] The function call to " + invoke->GetMethodName() +
+                ToPosInfo(invoke->GetDebugLocation()) + " was speculated to " + expected->ToString() +
+                " by the profile.";
+            std::cout << message << std::endl;
+        }
+        auto fastInvoke = GuardByInstanceOf(builder, *invoke, *expected);
+        speculatedInfos.emplace_back(RewriteInfo{fastInvoke, callee, expected, {}});
+    }
+    RewriteToApply(builder, speculatedInfos, isDebug);
+    speculatedNum += speculatedInfos.size();
+}
+
 static std::string CreateInstFuncMangleName(const std::string& oriIdentifer, const Apply& apply, CHIRBuilder& builder)
 {
     // 1. get type args
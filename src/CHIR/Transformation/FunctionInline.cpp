@@ -30,9 +30,6 @@ using namespace Cangjie::CHIR;
 constexpr static size_t INIT_INLINE_THRESHOLD = 20;
 // Set the threshold value of inlined call in one function to avoid code expandsion
 constexpr static size_t INLINED_COUNT_THRESHOLD = 20;
-// This is for efficiency and avoid overflowing on `size`, we will
-// terminate the counting if the size is already 3 times of the threshold
-constexpr static size_t SEARCH_THRESHOLD = INIT_INLINE_THRESHOLD * 3;
 
 // Increase the threshold value by 20%
 constexpr static size_t INCREASE_THRESHOLD = 5;
@@ -40,6 +37,12 @@ constexpr static size_t INCREASE_THRESHOLD = 5;
 // Step when the callee is with lambda parameter
 constexpr static size_t INCREASE_WHEN_CALLEE_WITH_LAMBDA_ARG = 2;
 
+// Step when both the caller and the callee are hot in the profile
+constexpr static size_t INCREASE_WHEN_PROFILED_HOT = 3;
+
+// Set the threshold value of inline for the callee which is never executed in the profile
+constexpr static size_t COLD_INLINE_THRESHOLD = INIT_INLINE_THRESHOLD / 4;
+
 // Set the threshold of CHIR in one block for inline
 constexpr static size_t INLINED_BLOCKSIZE_THRESHOLD = 10000;
 
@@ -158,10 +161,16 @@ static bool IsHotSpotCall(const Func& callee)
         return true;
     }
     // Case B: the call site is located in a loop
-    // note: currently unsupported
+    // note: currently unsupported, the profile is used instead, see `IsProfiledHotCall`
     return false;
 }
 
+/// The counters of the profile can't be mapped to call sites, so a call is hot if both its caller and callee are.
+static bool IsProfiledHotCall(const Func* caller, const Func& callee, const PGOProfile* profile)
+{
+    return profile != nullptr && caller != nullptr && profile->IsHot(*caller) && profile->IsHot(callee);
+}
+
 static bool FunctionWithLambdaArg(const Func& func)
 {
     for (auto arg : func.GetParams()) {
@@ -172,12 +181,16 @@ static bool FunctionWithLambdaArg(const Func& func)
     return false;
 }
 
-static size_t CalculateThreshold(const Value& callee, const Cangjie::GlobalOptions::OptimizationLevel& optLevel)
+static size_t CalculateThreshold(const Value& callee, const Func* caller, bool calledOnce,
+    const Cangjie::GlobalOptions::OptimizationLevel& optLevel, const PGOProfile* profile)
 {
     size_t realThreshold = INIT_INLINE_THRESHOLD;
     auto func = Cangjie::DynamicCast<const Func*>(&callee);
     CJC_NULLPTR_CHECK(func);
-    if (OnlyCalledOnce(*func)) {
+    if (profile != nullptr && profile->IsCold(*func)) {
+        return COLD_INLINE_THRESHOLD;
+    }
+    if (calledOnce) {
         // Increase the threshold value by 20%
         realThreshold += realThreshold / INCREASE_THRESHOLD;
     }
@@ -189,6 +202,9 @@ static size_t CalculateThreshold(const Value& callee, const Cangjie::GlobalOptio
         if (FunctionWithLambdaArg(*func)) {
             realThreshold = INIT_INLINE_THRESHOLD * INCREASE_WHEN_CALLEE_WITH_LAMBDA_ARG;
         }
+        if (IsProfiledHotCall(caller, *func, profile)) {
+            realThreshold = INIT_INLINE_THRESHOLD * INCREASE_WHEN_PROFILED_HOT;
+        }
     }
     return realThreshold;
 }
@@ -213,14 +229,63 @@ static size_t CountFuncSize(const Func& func)
     for (auto block : func.GetBody()->GetBlocks()) {
         for (auto e : block->GetExpressions()) {
             funcSize += GetExprSize(*e);
-            if (funcSize >= SEARCH_THRESHOLD) {
-                break;
-            }
         }
     }
     return funcSize;
 }
 
+size_t FunctionInline::GetFuncSize(const Func& func)
+{
+    return CountFuncSize(func);
+}
+
+bool FunctionInline::IsOnlyCalledOnce(const Func& func)
+{
+    return OnlyCalledOnce(func);
+}
+
+void FunctionInline::SetPackageInfo(
+    const std::unordered_map<const Func*, size_t>& funcSizes, const std::unordered_set<const Func*>& calledOnceFuncs)
+{
+    knownFuncSizes = &funcSizes;
+    this->calledOnceFuncs = &calledOnceFuncs;
+}
+
+size_t FunctionInline::GetCalleeSize(Func& callee)
+{
+    if (knownFuncSizes != nullptr) {
+        if (auto it = knownFuncSizes->find(&callee); it != knownFuncSizes->end()) {
+            return it->second;
+        }
+    }
+    // `res` is std::pair<iterator, bool>, so
+    // `res.second == true` means `callee` is emplaced successfully, then we must set correct function size
+    // `res.second == false` means `callee` has already been emplaced before, we can use its size directly
+    auto res = funcSizeMap.emplace(&callee, 0);
+    if (res.second) {
+        res.first->second = CountFuncSize(callee);
+    }
+    return res.first->second;
+}
+
+bool FunctionInline::IsCalledOnce(const Func& callee) const
+{
+    if (calledOnceFuncs != nullptr) {
+        return calledOnceFuncs->count(&callee) != 0;
+    }
+    return OnlyCalledOnce(callee);
+}
+
+bool FunctionInline::Decide(
+    const Apply& apply, bool inlined, const std::string& reason, size_t calleeSize, size_t threshold)
+{
+    if (remarks != nullptr) {
+        remarks->emplace_back(InlineRemark{globalFunc, VirtualCast<Func*>(apply.GetCallee()), apply.GetDebugLocation(),
+            inlined, reason, calleeSize, threshold});
+    }
+    return inlined;
+}
+
 bool FunctionInline::CheckCanRewrite(const Apply& apply)
 {
     auto callee = apply.GetCallee();
@@ -233,47 +298,60 @@ bool FunctionInline::CheckCanRewrite(const Apply& apply)
 
     // when the terminator of this block is RaiseException, do not inline this apply because it rarely happens
     if (auto block = apply.GetParentBlock(); Is<RaiseException>(block->GetTerminator())) {
-        return false;
+        return Decide(apply, false, "raise-block");
     }
 
     // Omit the function inline in block that exceed the Blocksize
     // threshold to avoid the huge time consume.
     auto block = apply.GetParentBlock();
     if (block->GetExpressions().size() >= INLINED_BLOCKSIZE_THRESHOLD) {
-        return false;
+        return Decide(apply, false, "block-size");
     }
 
     // recursive function doesn't need to inline
     // if you really want to inline it, yes, you can, it won't cause a problem
     if (callee == globalFunc) {
-        return false;
+        return Decide(apply, false, "recursive");
     }
     if (InBlackList(*func)) {
-        return false;
+        return Decide(apply, false, "black-list");
     }
+    // these are always inlined, they are only charged so that the budget of the other callees accounts for them
     if (InWhiteList(*func)) {
-        return true;
+        return ChargeGrowth(apply, "white-list", GetCalleeSize(*func), 0, true);
     }
     if (func->GetFuncKind() == FuncKind::INSTANCEVAR_INIT) {
-        return true;
+        return ChargeGrowth(apply, "instance-var-init", GetCalleeSize(*func), 0, true);
     }
     // Determine if we can inline by checking the size of callee exceed the threshold
-    if (inlinedCountMap[globalFunc] >= INLINED_COUNT_THRESHOLD) {
-        return false;
+    // hot functions in the profile are allowed to grow twice as much
+    size_t countThreshold = INLINED_COUNT_THRESHOLD;
+    if (profile != nullptr && globalFunc != nullptr && profile->IsHot(*globalFunc)) {
+        countThreshold *= 2;
     }
-    size_t realThreshold = CalculateThreshold(*callee, optLevel);
-    // `res` is std::pair<iterator, bool>, so
-    // `res.second == true` means `callee` is emplaced successfully, then we must set correct function size
-    // `res.second == false` means `callee` has already been emplaced before, we can use its size directly
-    auto res = funcSizeMap.emplace(func, 0);
-    if (res.second) {
-        res.first->second = CountFuncSize(*func);
+    if (inlinedCountMap[globalFunc] >= countThreshold) {
+        return Decide(apply, false, "caller-inlined-count");
     }
-    if (res.first->second <= realThreshold) {
-        inlinedCountMap[globalFunc]++;
-        return true;
+    size_t realThreshold = CalculateThreshold(*callee, globalFunc, IsCalledOnce(*func), optLevel, profile);
+    size_t calleeSize = GetCalleeSize(*func);
+    if (calleeSize > realThreshold) {
+        return Decide(apply, false, "size", calleeSize, realThreshold);
     }
-    return false;
+    if (!ChargeGrowth(apply, "size", calleeSize, realThreshold)) {
+        return false;
+    }
+    inlinedCountMap[globalFunc]++;
+    return true;
+}
+
+bool FunctionInline::ChargeGrowth(
+    const Apply& apply, const std::string& reason, size_t calleeSize, size_t threshold, bool mandatory)
+{
+    if (!mandatory && growth + calleeSize > growthBudget) {
+        return Decide(apply, false, "package-budget", calleeSize, threshold);
+    }
+    growth += calleeSize;
+    return Decide(apply, true, reason, calleeSize, threshold);
 }
 
 static std::vector<Block*> GetExitBlocks(const BlockGroup& blockGroup)
@@ -0,0 +1,80 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+// The Cangjie API is in Beta. For details on its capabilities and limitations, please refer to the README file.
+
+#include "cangjie/CHIR/Transformation/FunctionPassManager.h"
+
+#include <algorithm>
+#include <memory>
+
+#include "cangjie/Utils/TaskQueue.h"
+
+using namespace Cangjie::CHIR;
+
+namespace {
+// Items are distributed over more tasks than threads, so that a few large items do not leave threads idle.
+constexpr size_t TASKS_PER_THREAD = 4;
+} // namespace
+
+namespace Cangjie::CHIR {
+void ParallelFor(CHIRBuilder& builder, size_t threadNum, size_t num,
+    const std::function<void(size_t idx, CHIRBuilder& builder)>& task)
+{
+    if (threadNum <= 1 || num <= 1) {
+        for (size_t idx = 0; idx < num; ++idx) {
+            task(idx, builder);
+        }
+        return;
+    }
+    // Neither the order in which the tasks run nor the order in which the indexes of a task are visited may change
+    // the result, the callers only run independent items.
+    size_t taskNum = std::min(num, threadNum * TASKS_PER_THREAD);
+    std::vector<std::unique_ptr<CHIRBuilder>> builderList;
+    for (size_t i = 0; i < taskNum; ++i) {
+        builderList.emplace_back(std::make_unique<CHIRBuilder>(builder.GetChirContext(), i));
+    }
+    Utils::TaskQueue taskQueue(threadNum);
+    for (size_t i = 0; i < taskNum; ++i) {
+        taskQueue.AddTask<void>([&task, &subBuilder = *builderList[i], i, taskNum, num]() {
+            for (size_t idx = i; idx < num; idx += taskNum) {
+                task(idx, subBuilder);
+            }
+        });
+    }
+    taskQueue.RunAndWaitForAllTasksCompleted();
+    for (auto& subBuilder : builderList) {
+        subBuilder->MergeAllocatedInstance();
+    }
+    builder.GetChirContext().MergeTypes();
+}
+} // namespace Cangjie::CHIR
+
+FunctionPassManager::FunctionPassManager(
+    CHIRBuilder& builder, size_t threadNum, AnalysisManager* analysisManager)
+    : builder(builder), threadNum(threadNum), analysisManager(analysisManager)
+{
+}
+
+void FunctionPassManager::RunOnPackage(const Package& package, PassScope scope, const FunctionPass& pass) const
+{
+    auto funcs = package.GetGlobalFuncs();
+    // Not std::vector<bool>, whose elements cannot be written concurrently.
+    std::vector<uint8_t> changed(funcs.size(), 0);
+    // A function-local pass only changes the function it runs on, so the functions are independent.
+    ParallelFor(builder, scope == PassScope::MODULE ? 1 : threadNum, funcs.size(),
+        [&funcs, &pass, &changed](size_t idx, CHIRBuilder& subBuilder) {
+            changed[idx] = pass(*funcs[idx], subBuilder);
+        });
+    if (!analysisManager) {
+        return;
+    }
+    for (size_t idx = 0; idx < funcs.size(); ++idx) {
+        if (changed[idx]) {
+            analysisManager->MarkChanged(*funcs[idx]);
+        }
+    }
+}
@@ -0,0 +1,270 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+// The Cangjie API is in Beta. For details on its capabilities and limitations, please refer to the README file.
+
+#include "cangjie/CHIR/Transformation/LoopInvariantCodeMotion.h"
+
+#include <algorithm>
+
+#include "cangjie/CHIR/Analysis/Utils.h"
+#include "cangjie/CHIR/CHIRCasting.h"
+#include "cangjie/CHIR/Expression/Terminator.h"
+
+using namespace Cangjie::CHIR;
+
+namespace {
+/// The block of @p blockGroup which contains @p expr, maybe inside the nested BlockGroups of an expression.
+const Block* GetBlockIn(const Expression& expr, const BlockGroup& blockGroup)
+{
+    auto cur = &expr;
+    while (cur->GetParentBlockGroup() != &blockGroup) {
+        cur = cur->GetParentBlockGroup()->GetOwnerExpression();
+        if (cur == nullptr) {
+            return nullptr;
+        }
+    }
+    return cur->GetParentBlock();
+}
+
+bool IsDefinedInLoop(const Value& value, const NaturalLoop& loop)
+{
+    if (!value.IsLocalVar()) {
+        return false;
+    }
+    auto def = Cangjie::StaticCast<const LocalVar*>(&value)->GetExpr();
+    auto block = GetBlockIn(*def, *loop.header->GetParentBlockGroup());
+    return block == nullptr || loop.Contains(*block);
+}
+
+bool IsNumeric(const Type& type)
+{
+    return type.IsInteger() || type.IsFloat();
+}
+
+/// Integer overflow is only an exception with the throwing strategy.
+bool IsNonThrowingArithmetic(const Type& type, Cangjie::OverflowStrategy strategy)
+{
+    using Cangjie::OverflowStrategy;
+    return type.IsFloat() || strategy == OverflowStrategy::WRAPPING || strategy == OverflowStrategy::SATURATING ||
+        strategy == OverflowStrategy::CHECKED;
+}
+
+/// The value @p ref is derived from by GetElementRef, i.e. the allocation it points into.
+const Value* GetRootRef(const Value& ref)
+{
+    auto cur = &ref;
+    while (cur->IsLocalVar()) {
+        auto def = Cangjie::StaticCast<const LocalVar*>(cur)->GetExpr();
+        if (def->GetExprKind() != ExprKind::GET_ELEMENT_REF) {
+            break;
+        }
+        cur = Cangjie::StaticCast<const GetElementRef*>(def)->GetLocation();
+    }
+    return cur;
+}
+
+/// Make sure every loop header has a preheader, return whether any block is created.
+bool CreatePreheaders(const LoopForest& loops, BlockGroup& body, CHIRBuilder& builder)
+{
+    bool changed = false;
+    for (auto& loop : loops.GetLoops()) {
+        if (loop->GetPreheader() != nullptr || loop->header == body.GetEntryBlock()) {
+            continue;
+        }
+        std::vector<Block*> outsidePreds;
+        bool redirectable = true;
+        for (auto pred : loop->header->GetPredecessors()) {
+            if (loop->Contains(*pred) ||
+                std::find(outsidePreds.begin(), outsidePreds.end(), pred) != outsidePreds.end()) {
+                continue;
+            }
+            auto kind = pred->GetTerminator()->GetExprKind();
+            redirectable = redirectable &&
+                (kind == ExprKind::GOTO || kind == ExprKind::BRANCH || kind == ExprKind::MULTIBRANCH);
+            outsidePreds.emplace_back(pred);
+        }
+        if (!redirectable || outsidePreds.empty()) {
+            continue;
+        }
+        auto preheader = builder.CreateBlock(&body);
+        preheader->AppendExpression(builder.CreateTerminator<GoTo>(loop->header, preheader));
+        for (auto pred : outsidePreds) {
+            pred->GetTerminator()->ReplaceSuccessor(*loop->header, *preheader);
+        }
+        changed = true;
+    }
+    return changed;
+}
+} // namespace
+
+LoopInvariantCodeMotion::LoopInvariantCodeMotion(const EscapeAnalysis& escapeAnalysis)
+    : escapeAnalysis(escapeAnalysis)
+{
+}
+
+bool LoopInvariantCodeMotion::IsInvariantMemory(const Value& location, const NaturalLoop& loop) const
+{
+    auto root = GetRootRef(location);
+    if (!root->IsLocalVar() ||
+        Cangjie::StaticCast<const LocalVar*>(root)->GetExpr()->GetExprKind() != ExprKind::ALLOCATE ||
+        escapeAnalysis.IsEscaping(*root)) {
+        return false;
+    }
+    // The memory is not escaping, so it is only written through the references derived from the allocation.
+    auto& body = *loop.header->GetParentBlockGroup();
+    std::vector<const Value*> worklist{root};
+    while (!worklist.empty()) {
+        auto ref = worklist.back();
+        worklist.pop_back();
+        for (auto user : ref->GetUsers()) {
+            auto kind = user->GetExprKind();
+            if (kind == ExprKind::GET_ELEMENT_REF) {
+                worklist.emplace_back(user->GetResult());
+                continue;
+            }
+            if (kind == ExprKind::LOAD || kind == ExprKind::DEBUGEXPR) {
+                continue;
+            }
+            auto block = GetBlockIn(*user, body);
+            if (block == nullptr || loop.Contains(*block)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool LoopInvariantCodeMotion::IsHoistable(const Expression& expr, const NaturalLoop& loop, bool isGuaranteed) const
+{
+    for (auto operand : expr.GetOperands()) {
+        if (IsDefinedInLoop(*operand, loop)) {
+            return false;
+        }
+    }
+    switch (expr.GetExprKind()) {
+        case ExprKind::CONSTANT:
+        case ExprKind::NOT:
+        case ExprKind::BITNOT:
+        case ExprKind::BITAND:
+        case ExprKind::BITOR:
+        case ExprKind::BITXOR:
+        case ExprKind::LT:
+        case ExprKind::GT:
+        case ExprKind::LE:
+        case ExprKind::GE:
+        case ExprKind::EQUAL:
+        case ExprKind::NOTEQUAL:
+        case ExprKind::AND:
+        case ExprKind::OR:
+        case ExprKind::GET_ELEMENT_REF:
+        case ExprKind::TUPLE:
+            return true;
+        case ExprKind::FIELD: {
+            // The fields of class objects may be written in the loop.
+            auto baseTy = StaticCast<const Field*>(&expr)->GetBase()->GetType();
+            return baseTy->IsStruct() || baseTy->IsTuple();
+        }
+        case ExprKind::NEG: {
+            auto unary = StaticCast<const UnaryExpression*>(&expr);
+            return IsNonThrowingArithmetic(*expr.GetResult()->GetType(), unary->GetOverflowStrategy());
+        }
+        case ExprKind::ADD:
+        case ExprKind::SUB:
+        case ExprKind::MUL:
+        case ExprKind::EXP: {
+            auto binary = StaticCast<const BinaryExpression*>(&expr);
+            return IsNonThrowingArithmetic(*expr.GetResult()->GetType(), binary->GetOverflowStrategy());
+        }
+        case ExprKind::DIV:
+        case ExprKind::MOD:
+            // Integer division throws on zero divisor.
+            return expr.GetResult()->GetType()->IsFloat();
+        case ExprKind::TYPECAST: {
+            auto cast = StaticCast<const TypeCast*>(&expr);
+            auto strategy = cast->GetOverflowStrategy();
+            return IsNumeric(*cast->GetSourceTy()) && IsNumeric(*cast->GetTargetTy()) &&
+                (cast->GetTargetTy()->IsFloat() || strategy == OverflowStrategy::WRAPPING ||
+                    strategy == OverflowStrategy::SATURATING);
+        }
+        case ExprKind::LOAD:
+            return IsInvariantMemory(*StaticCast<const Load*>(&expr)->GetLocation(), loop);
+        case ExprKind::APPLY: {
+            auto apply = StaticCast<const Apply*>(&expr);
+            auto callee = DynamicCast<FuncBase*>(apply->GetCallee());
+            if (!isGuaranteed || callee == nullptr || !callee->TestAttr(Attribute::NO_SIDE_EFFECT)) {
+                return false;
+            }
+            for (auto arg : apply->GetArgs()) {
+                if (arg->GetType()->IsRef()) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+size_t LoopInvariantCodeMotion::HoistInvariants(
+    const NaturalLoop& loop, Block& preheader, const DominatorTree& domTree, bool isDebug) const
+{
+    // The blocks executed in every iteration which leaves the loop or goes back to the header.
+    std::vector<const Block*> exitingBlocks(loop.latches.begin(), loop.latches.end());
+    for (auto block : loop.blocks) {
+        for (auto succ : block->GetSuccessors()) {
+            if (!loop.Contains(*succ)) {
+                exitingBlocks.emplace_back(block);
+                break;
+            }
+        }
+    }
+    auto insertPoint = preheader.GetTerminator();
+    size_t hoisted = 0;
+    for (auto block : domTree.GetReversePostOrder()) {
+        if (!loop.Contains(*block)) {
+            continue;
+        }
+        bool isGuaranteed = std::all_of(exitingBlocks.begin(), exitingBlocks.end(),
+            [&domTree, block](const Block* exiting) { return domTree.Dominates(*block, *exiting); });
+        for (auto expr : block->GetExpressions()) {
+            if (expr->IsTerminator() || !IsHoistable(*expr, loop, isGuaranteed)) {
+                continue;
+            }
+            expr->MoveBefore(insertPoint);
+            ++hoisted;
+            if (isDebug && !expr->GetDebugLocation().GetBeginPos().IsZero()) {
+                std::string message = "[LoopInvariantCodeMotion] " + expr->GetExprKindName() +
+                    ToPosInfo(expr->GetDebugLocation()) + " has been hoisted out of the loop\n";
+                std::cout << message;
+            }
+        }
+    }
+    return hoisted;
+}
+
+size_t LoopInvariantCodeMotion::RunOnFunc(const Func& func, CHIRBuilder& builder, bool isDebug) const
+{
+    auto body = func.GetBody();
+    auto domTree = std::make_unique<DominatorTree>(*body);
+    auto loops = std::make_unique<LoopForest>(*domTree);
+    if (loops->GetLoops().empty()) {
+        return 0;
+    }
+    if (CreatePreheaders(*loops, *body, builder)) {
+        domTree = std::make_unique<DominatorTree>(*body);
+        loops = std::make_unique<LoopForest>(*domTree);
+    }
+    size_t hoisted = 0;
+    // Inner loops go first, so what is hoisted into the preheader of an inner loop may be hoisted again.
+    for (auto& loop : loops->GetLoops()) {
+        if (auto preheader = loop->GetPreheader()) {
+            hoisted += HoistInvariants(*loop, *preheader, *domTree, isDebug);
+        }
+    }
+    return hoisted;
+}
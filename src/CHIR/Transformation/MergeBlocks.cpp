@@ -137,7 +137,7 @@ static bool SkipMergeBlock(const Block& bl, const GlobalOptions& opts)
     return term && !term->GetDebugLocation().IsInvalidPos();
 }
 
-void MergeBlocks::RunOnFunc(const BlockGroup& body, CHIRBuilder& builder, const GlobalOptions& opts)
+bool MergeBlocks::RunOnFunc(const BlockGroup& body, CHIRBuilder& builder, const GlobalOptions& opts)
 {
     auto checkSingleEntrySingleExit = [](const Block& block, const GlobalOptions& opts) {
         if (SkipMergeBlock(block, opts)) {
@@ -188,13 +188,14 @@ void MergeBlocks::RunOnFunc(const BlockGroup& body, CHIRBuilder& builder, const
         }
         return true;
     };
+    bool changed = false;
     bool isStable;
     do {
         isStable = true;
         for (auto block : body.GetBlocks()) {
             for (auto expr : block->GetExpressions()) {
                 if (expr->GetExprKind() == ExprKind::LAMBDA) {
-                    RunOnFunc(*StaticCast<const Lambda*>(expr)->GetBody(), builder, opts);
+                    changed = RunOnFunc(*StaticCast<const Lambda*>(expr)->GetBody(), builder, opts) || changed;
                 }
             }
             if (block->Get<GeneratedFromForIn>()) {
@@ -208,5 +209,7 @@ void MergeBlocks::RunOnFunc(const BlockGroup& body, CHIRBuilder& builder, const
                 MergeGotoOnlyBlock(*block);
             }
         }
+        changed = changed || !isStable;
     } while (!isStable);
+    return changed;
 }
@@ -0,0 +1,96 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+// The Cangjie API is in Beta. For details on its capabilities and limitations, please refer to the README file.
+
+#include "cangjie/CHIR/Transformation/NonEscapingAllocateElimination.h"
+
+#include "cangjie/CHIR/Analysis/Utils.h"
+#include "cangjie/CHIR/CHIRCasting.h"
+#include "cangjie/CHIR/Transformation/AllocateSplitter.h"
+#include "cangjie/CHIR/Type/ClassDef.h"
+
+using namespace Cangjie::CHIR;
+
+NonEscapingAllocateElimination::NonEscapingAllocateElimination(const EscapeAnalysis& escapeAnalysis)
+    : escapeAnalysis(escapeAnalysis)
+{
+}
+
+bool NonEscapingAllocateElimination::IsReplaceable(
+    const Allocate& allocate, const Func& func, CHIRBuilder& builder, bool enableCompileDebug) const
+{
+    auto classTy = DynamicCast<ClassType*>(allocate.GetType());
+    // The environments of closures are called through their vtables.
+    if (classTy == nullptr || classTy->IsAutoEnv() || classTy->GetClassDef()->GetFinalizer() != nullptr) {
+        return false;
+    }
+    auto obj = allocate.GetResult();
+    if (func.GetReturnValue() == obj || escapeAnalysis.IsEscaping(*obj)) {
+        return false;
+    }
+    auto memberTys = classTy->GetInstantiatedMemberTys(builder);
+    auto body = func.GetBody();
+    for (auto user : obj->GetUsers()) {
+        if (user->GetParentBlockGroup() != body) {
+            return false;
+        }
+        if (user->GetExprKind() == ExprKind::DEBUGEXPR) {
+            // The debug information describes the variable as an object.
+            if (enableCompileDebug) {
+                return false;
+            }
+            continue;
+        }
+        if (user->GetExprKind() == ExprKind::GET_ELEMENT_REF) {
+            // The reference to a member variable is replaced by the local allocation of the same type.
+            auto refTy = DynamicCast<RefType*>(user->GetResult()->GetType());
+            if (refTy == nullptr ||
+                !IsElementPath(StaticCast<GetElementRef*>(user)->GetPath(), memberTys, refTy->GetBaseType()) ||
+                !IsOnlyReadAndWritten(*user->GetResult(), *body, &escapeAnalysis)) {
+                return false;
+            }
+            continue;
+        }
+        if (user->GetExprKind() == ExprKind::STORE_ELEMENT_REF) {
+            auto store = StaticCast<StoreElementRef*>(user);
+            if (store->GetLocation() != obj ||
+                !IsElementPath(store->GetPath(), memberTys, store->GetValue()->GetType())) {
+                return false;
+            }
+            continue;
+        }
+        // The object itself cannot be passed to a callee, which expects it in one piece.
+        return false;
+    }
+    return true;
+}
+
+size_t NonEscapingAllocateElimination::RunOnFunc(
+    const Func& func, CHIRBuilder& builder, bool isDebug, bool enableCompileDebug) const
+{
+    size_t eliminated = 0;
+    for (auto block : func.GetBody()->GetBlocks()) {
+        for (auto expr : block->GetExpressions()) {
+            if (expr->GetExprKind() != ExprKind::ALLOCATE) {
+                continue;
+            }
+            auto allocate = StaticCast<Allocate*>(expr);
+            if (!IsReplaceable(*allocate, func, builder, enableCompileDebug)) {
+                continue;
+            }
+            auto memberTys = StaticCast<ClassType*>(allocate->GetType())->GetInstantiatedMemberTys(builder);
+            (void)AllocateSplitter(*allocate, std::move(memberTys), *func.GetBody(), builder).Run();
+            ++eliminated;
+            if (isDebug && !allocate->GetDebugLocation().GetBeginPos().IsZero()) {
+                std::string message = "[NonEscapingAllocateElimination] Allocate" +
+                    ToPosInfo(allocate->GetDebugLocation()) + " has been replaced by its member variables\n";
+                std::cout << message;
+            }
+        }
+    }
+    return eliminated;
+}
@@ -25,14 +25,16 @@ void RedundantGetOrThrowElimination::RunOnPackage(const Ptr<const Package>& pack
     }
 }
 
-void RedundantGetOrThrowElimination::RunOnFunc(const Ptr<const Func>& func, bool isDebug) const
+bool RedundantGetOrThrowElimination::RunOnFunc(const Ptr<const Func>& func, bool isDebug) const
 {
     auto analysis = std::make_unique<GetOrThrowResultAnalysis>(func, isDebug);
     auto engine = Engine<GetOrThrowResultDomain>(func, std::move(analysis));
     auto result = engine.IterateToFixpoint();
     CJC_NULLPTR_CHECK(result);
 
-    const auto actionBeforeVisitExpr = [func, isDebug](const GetOrThrowResultDomain& state, Expression* expr, size_t) {
+    bool changed = false;
+    const auto actionBeforeVisitExpr = [func, isDebug, &changed](
+                                           const GetOrThrowResultDomain& state, Expression* expr, size_t) {
         if (!IsGetOrThrowFunction(*expr)) {
             return;
         }
@@ -40,6 +42,7 @@ void RedundantGetOrThrowElimination::RunOnFunc(const Ptr<const Func>& func, bool
         auto arg = apply->GetArgs()[0];
         if (auto result = state.CheckGetOrThrowResult(arg); result) {
             apply->GetResult()->ReplaceWith(*result->GetResult(), func->GetBody());
+            changed = true;
             if (isDebug) {
                 std::string message = "[RGetOtThrowE] The usages of the result of getOrThrow" +
                     ToPosInfo(apply->GetDebugLocation()) + " have been replaced by the value" +
@@ -54,4 +57,5 @@ void RedundantGetOrThrowElimination::RunOnFunc(const Ptr<const Func>& func, bool
     const auto actionOnTerminator = [](const GetOrThrowResultDomain&, Terminator*, std::optional<Block*>) {};
 
     result->VisitWith(actionBeforeVisitExpr, actionAfterVisitExpr, actionOnTerminator);
+    return changed;
 }
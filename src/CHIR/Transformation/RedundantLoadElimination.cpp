@@ -50,10 +50,10 @@ static void ModifyApplyCalleeInfo(const LocalVar& loadResult, Value& storeValue)
     }
 }
 
-void RedundantLoadElimination::RunOnFunc(const Ptr<const Func>& func, bool isDebug) const
+bool RedundantLoadElimination::RunOnFunc(const Ptr<const Func>& func, bool isDebug) const
 {
     if (func->TestAttr(Attribute::SKIP_ANALYSIS)) {
-        return;
+        return false;
     }
     auto analysis = std::make_unique<ReachingDefinitionAnalysis>(func);
     auto engine = Engine<ReachingDefinitionDomain>(func, std::move(analysis));
@@ -120,5 +120,6 @@ void RedundantLoadElimination::RunOnFunc(const Ptr<const Func>& func, bool isDeb
             e->RemoveSelfFromBlock();
         }
     }
+    return !toBeRemoved.empty();
 }
 }
@@ -0,0 +1,119 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+// The Cangjie API is in Beta. For details on its capabilities and limitations, please refer to the README file.
+
+#include "cangjie/CHIR/Transformation/ScalarReplacementOfAggregates.h"
+
+#include "cangjie/CHIR/Analysis/Utils.h"
+#include "cangjie/CHIR/CHIRCasting.h"
+#include "cangjie/CHIR/Transformation/AllocateSplitter.h"
+
+using namespace Cangjie::CHIR;
+
+namespace {
+std::vector<Type*> GetElementTys(Type& type, CHIRBuilder& builder)
+{
+    if (type.IsStruct()) {
+        return Cangjie::StaticCast<StructType*>(&type)->GetInstantiatedMemberTys(builder);
+    }
+    if (type.IsTuple()) {
+        return Cangjie::StaticCast<TupleType*>(&type)->GetElementTypes();
+    }
+    return {};
+}
+
+bool IsSplittable(const Allocate& allocate, const Func& func, CHIRBuilder& builder, bool enableCompileDebug)
+{
+    auto elementTys = GetElementTys(*allocate.GetType(), builder);
+    auto obj = allocate.GetResult();
+    if (elementTys.empty() || func.GetReturnValue() == obj) {
+        return false;
+    }
+    auto body = func.GetBody();
+    for (auto user : obj->GetUsers()) {
+        if (user->GetParentBlockGroup() != body) {
+            return false;
+        }
+        switch (user->GetExprKind()) {
+            case ExprKind::DEBUGEXPR:
+                // The debug information describes the variable as a whole.
+                if (enableCompileDebug) {
+                    return false;
+                }
+                break;
+            case ExprKind::GET_ELEMENT_REF: {
+                auto refTy = Cangjie::DynamicCast<RefType*>(user->GetResult()->GetType());
+                auto& path = Cangjie::StaticCast<GetElementRef*>(user)->GetPath();
+                if (refTy == nullptr || !IsElementPath(path, elementTys, refTy->GetBaseType()) ||
+                    !IsOnlyReadAndWritten(*user->GetResult(), *body)) {
+                    return false;
+                }
+                break;
+            }
+            case ExprKind::STORE_ELEMENT_REF: {
+                auto store = Cangjie::StaticCast<StoreElementRef*>(user);
+                if (store->GetLocation() != obj ||
+                    !IsElementPath(store->GetPath(), elementTys, store->GetValue()->GetType())) {
+                    return false;
+                }
+                break;
+            }
+            case ExprKind::STORE:
+                if (Cangjie::StaticCast<Store*>(user)->GetLocation() != obj) {
+                    return false;
+                }
+                break;
+            case ExprKind::LOAD:
+                // The loaded aggregate is never built, so only its elements may be used.
+                for (auto fieldUser : user->GetResult()->GetUsers()) {
+                    if (fieldUser->GetExprKind() != ExprKind::FIELD || fieldUser->GetParentBlockGroup() != body ||
+                        !IsElementPath(Cangjie::StaticCast<Field*>(fieldUser)->GetPath(), elementTys,
+                            fieldUser->GetResult()->GetType())) {
+                        return false;
+                    }
+                }
+                break;
+            default:
+                return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+size_t ScalarReplacementOfAggregates::RunOnFunc(
+    const Func& func, CHIRBuilder& builder, bool isDebug, bool enableCompileDebug)
+{
+    std::vector<Allocate*> worklist;
+    for (auto block : func.GetBody()->GetBlocks()) {
+        for (auto expr : block->GetExpressions()) {
+            if (expr->GetExprKind() == ExprKind::ALLOCATE) {
+                worklist.emplace_back(StaticCast<Allocate*>(expr));
+            }
+        }
+    }
+    size_t split = 0;
+    while (!worklist.empty()) {
+        auto allocate = worklist.back();
+        worklist.pop_back();
+        if (!IsSplittable(*allocate, func, builder, enableCompileDebug)) {
+            continue;
+        }
+        auto elementAllocs =
+            AllocateSplitter(*allocate, GetElementTys(*allocate->GetType(), builder), *func.GetBody(), builder).Run();
+        // Nested aggregates are split in turn.
+        worklist.insert(worklist.end(), elementAllocs.begin(), elementAllocs.end());
+        ++split;
+        if (isDebug && !allocate->GetDebugLocation().GetBeginPos().IsZero()) {
+            std::string message = "[ScalarReplacementOfAggregates] Allocate" +
+                ToPosInfo(allocate->GetDebugLocation()) + " has been split into its elements\n";
+            std::cout << message;
+        }
+    }
+    return split;
+}
@@ -45,8 +45,9 @@ void UnitUnify::RunOnPackage(const Ptr<const Package>& package, bool isDebug)
     }
 }
 
-void UnitUnify::RunOnFunc(const Ptr<Func>& func, bool isDebug)
+bool UnitUnify::RunOnFunc(const Ptr<Func>& func, bool isDebug)
 {
+    // The unit constant is only created when a unit is unified.
     Ptr<Constant> optUnit;
     auto preAcation = [this, isDebug, &optUnit](Expression& expr) {
         if (Is<GetRTTI>(expr) || Is<GetRTTIStatic>(expr)) {
@@ -62,6 +63,7 @@ void UnitUnify::RunOnFunc(const Ptr<Func>& func, bool isDebug)
         return VisitResult::CONTINUE;
     };
     Visitor::Visit(*func, preAcation);
+    return optUnit != nullptr;
 }
 
 void UnitUnify::LoadOrCreateUnit(Ptr<Constant>& constant, const Ptr<BlockGroup>& group)
@@ -21,8 +21,9 @@ void UselessAllocateElimination::RunOnPackage(const Package& package, bool isDeb
     }
 }
 
-void UselessAllocateElimination::RunOnFunc(const Func& func, bool isDebug)
+bool UselessAllocateElimination::RunOnFunc(const Func& func, bool isDebug)
 {
+    bool changed = false;
     for (auto block : func.GetBody()->GetBlocks()) {
         for (auto expr : block->GetExpressions()) {
             if (expr->GetExprKind() != ExprKind::ALLOCATE) {
@@ -45,6 +46,7 @@ void UselessAllocateElimination::RunOnFunc(const Func& func, bool isDebug)
                     e->GetExprKind() == ExprKind::DEBUGEXPR;
             });
             if (onlyBeenWritten) {
+                changed = true;
                 allocate->RemoveSelfFromBlock();
                 for (auto user : users) {
                     user->RemoveSelfFromBlock();
@@ -57,4 +59,5 @@ void UselessAllocateElimination::RunOnFunc(const Func& func, bool isDebug)
             }
         }
     }
+    return changed;
 }
\ No newline at end of file
@@ -55,6 +55,7 @@ void CGContext::Clear()
     callBasesToInline.clear();
     callBasesToReplace.clear();
     debugLocOfRetExpr.clear();
+    localizedSymbols.clear();
 #endif
 }
 
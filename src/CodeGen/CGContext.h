@@ -191,6 +191,13 @@ public:
     void AddLocalizedSymbol(const std::string& symName)
     {
         cgPkgContext.AddLocalizedSymbol(symName);
+        localizedSymbols.emplace_back(symName);
+    }
+
+    // The localized symbols defined by this module, they are recorded with its object file in the object cache.
+    const std::vector<std::string>& GetLocalizedSymbols() const
+    {
+        return localizedSymbols;
     }
 #endif
 
@@ -402,6 +409,7 @@ private:
     std::unordered_map<const CHIR::EnumDef*, std::vector<llvm::Constant*>> enumInfoCache;
 #ifdef CANGJIE_CODEGEN_CJNATIVE_BACKEND
     std::map<llvm::Function*, std::vector<CHIR::DebugLocation>> debugLocOfRetExpr;
+    std::vector<std::string> localizedSymbols;
     // Key: boxed ref value; Value: original non-ref value
     std::unordered_map<llvm::Value*, llvm::Value*> nonRefBox2RefMap;
 #endif
@@ -14,7 +14,10 @@
 
 #include "CJNative/CHIRSplitter.h"
 
+#include <numeric>
+#include <optional>
 #include <queue>
+#include <unordered_set>
 
 #include "llvm/IR/Module.h"
 #include "llvm/IRReader/IRReader.h"
@@ -24,6 +27,7 @@
 #include "CGPkgContext.h"
 #include "Utils/CGUtils.h"
 #include "cangjie/Basic/StringConvertor.h"
+#include "cangjie/CHIR/Analysis/CallGraphAnalysis.h"
 #include "cangjie/CHIR/CHIRCasting.h"
 #include "cangjie/CHIR/Package.h"
 #include "cangjie/CHIR/Type/EnumDef.h"
@@ -34,14 +38,6 @@
 
 namespace Cangjie {
 namespace CodeGen {
-namespace {
-std::size_t GetSubCHIRPackageIdx(std::size_t splitNum)
-{
-    static std::size_t counter = 0;
-    return counter++ % splitNum;
-}
-} // namespace
-
 bool ChirTypeDefCmp::operator()(const CHIR::CustomTypeDef* lhs, const CHIR::CustomTypeDef* rhs) const
 {
     return lhs->GetIdentifierWithoutPrefix() < rhs->GetIdentifierWithoutPrefix();
@@ -52,8 +48,8 @@ bool ChirValueCmp::operator()(const CHIR::Value* lhs, const CHIR::Value* rhs) co
     return lhs->GetIdentifierWithoutPrefix() < rhs->GetIdentifierWithoutPrefix();
 }
 
-SubCHIRPackage::SubCHIRPackage(std::size_t splitNum)
-    : mainModule(false), subCHIRPackageIdx(GetSubCHIRPackageIdx(splitNum)), exprNumInChirFuncs(0), splitNum(splitNum)
+SubCHIRPackage::SubCHIRPackage(std::size_t subCHIRPackageIdx, std::size_t splitNum)
+    : mainModule(false), subCHIRPackageIdx(subCHIRPackageIdx), backendCost(0), splitNum(splitNum)
 {
 }
 
@@ -98,7 +94,7 @@ std::vector<SubCHIRPackage> CHIRSplitter::SplitCHIRPackage()
     std::vector<SubCHIRPackage> subCHIRPackages;
     subCHIRPackages.reserve(splitNum);
     for (std::size_t idx = 0; idx < splitNum; ++idx) {
-        subCHIRPackages.emplace_back(SubCHIRPackage(splitNum));
+        subCHIRPackages.emplace_back(SubCHIRPackage(idx, splitNum));
     }
     SplitCHIRFuncs(subCHIRPackages);
     SplitCHIRClasses(subCHIRPackages);
@@ -112,29 +108,43 @@ std::vector<SubCHIRPackage> CHIRSplitter::SplitCHIRPackage()
 }
 
 namespace {
-struct SubCHIRPackageCmp {
-    bool operator()(const SubCHIRPackage& lhs, const SubCHIRPackage& rhs) const
-    {
-        return lhs.exprNumInChirFuncs == rhs.exprNumInChirFuncs ? lhs.subCHIRPackageIdx < rhs.subCHIRPackageIdx
-                                                                : lhs.exprNumInChirFuncs < rhs.exprNumInChirFuncs;
-    }
-};
+// Weights of the backend cost model. Besides the work proportional to its expressions, every function has a fixed
+// cost (symbol, prologue, debug and reflection metadata), and every call is a candidate for inlining. These are
+// heuristic estimates, not measured against backend compile times.
+constexpr std::size_t FUNC_BASE_COST = 16;
+constexpr std::size_t CALL_COST = 4;
+// Callees up to this cost are likely to be inlined by LLVM, so they are kept in the module of a caller.
+constexpr std::size_t SMALL_CALLEE_COST = 64;
+
+std::size_t EstimateBackendCost(const CHIR::Func& func, std::size_t callNum)
+{
+    return FUNC_BASE_COST + func.GetExpressionsNum() + CALL_COST * callNum;
+}
 
-auto FindTargetSubCHIRPackage(const CHIR::Value& chirValue,
-    const std::set<SubCHIRPackage, SubCHIRPackageCmp>& subCHIRPackagesSet,
-    const std::map<std::string, std::size_t>& cache)
+// The cached sub-package may no longer exist, e.g. when the number of sub-packages has decreased, then end() is
+// returned.
+SubCHIRPackageSet::const_iterator FindCachedSubCHIRPackage(const std::string& identifier,
+    const SubCHIRPackageSet& subCHIRPackagesSet, const std::map<std::string, std::size_t>& cache)
 {
-    auto target = subCHIRPackagesSet.begin();
-    if (auto iterOfCache = cache.find(chirValue.GetIdentifierWithoutPrefix()); iterOfCache != cache.end()) {
-        auto idxInCache = iterOfCache->second;
-        target = std::find_if(subCHIRPackagesSet.begin(), subCHIRPackagesSet.end(),
-            [idxInCache](const SubCHIRPackage& sub) { return sub.subCHIRPackageIdx == idxInCache; });
+    auto iterOfCache = cache.find(identifier);
+    if (iterOfCache == cache.end()) {
+        return subCHIRPackagesSet.end();
     }
-    return target;
-};
+    auto idxInCache = iterOfCache->second;
+    return std::find_if(subCHIRPackagesSet.begin(), subCHIRPackagesSet.end(),
+        [idxInCache](const SubCHIRPackage& sub) { return sub.subCHIRPackageIdx == idxInCache; });
+}
+
+// The cached sub-package of @p chirValue if it still exists, otherwise the least loaded one.
+SubCHIRPackageSet::const_iterator FindTargetSubCHIRPackage(const CHIR::Value& chirValue,
+    const SubCHIRPackageSet& subCHIRPackagesSet, const std::map<std::string, std::size_t>& cache)
+{
+    auto target = FindCachedSubCHIRPackage(chirValue.GetIdentifierWithoutPrefix(), subCHIRPackagesSet, cache);
+    return target == subCHIRPackagesSet.end() ? subCHIRPackagesSet.begin() : target;
+}
 
 void SplitSpecialFuncs(CHIR::Func& globalInitFunc, CHIR::Func& globalInitLiteralFunc,
-    const std::vector<CHIR::Func*>& toAnyFuncs, std::set<SubCHIRPackage, SubCHIRPackageCmp>& subCHIRPackagesSet,
+    const std::vector<CHIR::Func*>& toAnyFuncs, SubCHIRPackageSet& subCHIRPackagesSet,
     std::map<std::string, std::size_t>& cache)
 {
     auto target = FindTargetSubCHIRPackage(globalInitFunc, subCHIRPackagesSet, cache);
@@ -143,34 +153,131 @@ void SplitSpecialFuncs(CHIR::Func& globalInitFunc, CHIR::Func& globalInitLiteral
     subCHIRPackage.mainModule = true;
     subCHIRPackage.chirFuncs.emplace(&globalInitFunc);
     subCHIRPackage.chirFuncs.emplace(&globalInitLiteralFunc);
-    subCHIRPackage.exprNumInChirFuncs += globalInitFunc.GetExpressionsNum() + globalInitLiteralFunc.GetExpressionsNum();
-    cache.emplace(globalInitFunc.GetIdentifierWithoutPrefix(), subCHIRPackage.subCHIRPackageIdx);
-    cache.emplace(globalInitLiteralFunc.GetIdentifierWithoutPrefix(), subCHIRPackage.subCHIRPackageIdx);
+    subCHIRPackage.backendCost +=
+        EstimateBackendCost(globalInitFunc, 0) + EstimateBackendCost(globalInitLiteralFunc, 0);
+    cache.insert_or_assign(globalInitFunc.GetIdentifierWithoutPrefix(), subCHIRPackage.subCHIRPackageIdx);
+    cache.insert_or_assign(globalInitLiteralFunc.GetIdentifierWithoutPrefix(), subCHIRPackage.subCHIRPackageIdx);
     for (auto toAny : toAnyFuncs) {
         subCHIRPackage.chirFuncs.emplace(toAny);
-        subCHIRPackage.exprNumInChirFuncs += toAny->GetExpressionsNum();
-        cache.emplace(toAny->GetIdentifierWithoutPrefix(), subCHIRPackage.subCHIRPackageIdx);
+        subCHIRPackage.backendCost += EstimateBackendCost(*toAny, 0);
+        cache.insert_or_assign(toAny->GetIdentifierWithoutPrefix(), subCHIRPackage.subCHIRPackageIdx);
     }
     subCHIRPackagesSet.insert(std::move(targetSubCHIRPackage));
 }
 
-void SplitNormalFunc(const std::multimap<std::size_t, CHIR::Func*>& sortedChirFuncs,
-    std::set<SubCHIRPackage, SubCHIRPackageCmp>& subCHIRPackagesSet, std::map<std::string, std::size_t>& cache)
-{
-    for (auto iter = sortedChirFuncs.rbegin(); iter != sortedChirFuncs.rend(); iter++) {
-        auto func = iter->second;
-        auto target = FindTargetSubCHIRPackage(*func, subCHIRPackagesSet, cache);
-        auto targetSubCHIRPackage = subCHIRPackagesSet.extract(target);
-        auto& subCHIRPackage = targetSubCHIRPackage.value();
-        subCHIRPackage.chirFuncs.emplace(func);
-        subCHIRPackage.exprNumInChirFuncs += iter->first;
-        cache.emplace(func->GetIdentifierWithoutPrefix(), subCHIRPackage.subCHIRPackageIdx);
-        subCHIRPackagesSet.insert(std::move(targetSubCHIRPackage));
+class FuncClusterBuilder {
+public:
+    FuncClusterBuilder(const CHIR::Package& chirPkg, const GlobalOptions& options) : chirPkg(chirPkg), options(options)
+    {
     }
-}
 
-void SplitForeign(const CHIR::Package& chirPkg, std::set<SubCHIRPackage, SubCHIRPackageCmp>& subCHIRPackagesSet,
-    std::map<std::string, std::size_t>& cache)
+    // Build the clusters of all global functions except @p excluded. No cluster exceeds the average cost of a module
+    // unless it is a single SCC.
+    std::vector<FuncCluster> Build(const std::unordered_set<const CHIR::Func*>& excluded, std::size_t splitNum)
+    {
+        // Devirtualization information is only needed for virtual edges, which are not used here.
+        CHIR::DevirtualizationInfo devirtInfo(&chirPkg, options);
+        CHIR::CallGraphAnalysis callGraphAnalysis(&chirPkg, devirtInfo);
+        callGraphAnalysis.DoCallGraphAnalysis(false);
+        for (auto& scc : callGraphAnalysis.postOrderSCCs) {
+            AddSCC(scc, excluded, callGraphAnalysis.directCallees);
+        }
+        // Functions which are not reachable from the entries of the call graph form clusters of their own.
+        for (auto func : chirPkg.GetGlobalFuncs()) {
+            if (excluded.count(func) == 0 && sccOf.count(func) == 0) {
+                AddSCC({func}, excluded, callGraphAnalysis.directCallees);
+            }
+        }
+        MergeSmallCallees(splitNum, callGraphAnalysis.directCallees);
+        std::vector<FuncCluster> clusters;
+        std::unordered_map<std::size_t, std::size_t> clusterOfRoot;
+        for (std::size_t i = 0; i < sccs.size(); ++i) {
+            auto root = FindRoot(i);
+            auto [iter, inserted] = clusterOfRoot.emplace(root, clusters.size());
+            if (inserted) {
+                clusters.emplace_back(FuncCluster{{}, mergedCosts[root]});
+            }
+            auto& funcs = clusters[iter->second].funcs;
+            funcs.insert(funcs.end(), sccs[i].funcs.begin(), sccs[i].funcs.end());
+        }
+        return clusters;
+    }
+
+private:
+    using CalleeMap = std::unordered_map<const CHIR::Func*, std::vector<CHIR::Func*>>;
+
+    void AddSCC(const std::vector<CHIR::Func*>& scc, const std::unordered_set<const CHIR::Func*>& excluded,
+        const CalleeMap& directCallees)
+    {
+        FuncCluster cluster;
+        for (auto func : scc) {
+            if (excluded.count(func) != 0) {
+                continue;
+            }
+            auto callees = directCallees.find(func);
+            cluster.cost += EstimateBackendCost(*func, callees == directCallees.end() ? 0 : callees->second.size());
+            cluster.funcs.emplace_back(func);
+            sccOf.emplace(func, sccs.size());
+        }
+        if (!cluster.funcs.empty()) {
+            parents.emplace_back(sccs.size());
+            mergedCosts.emplace_back(cluster.cost);
+            sccs.emplace_back(std::move(cluster));
+        }
+    }
+
+    // Callers come after their callees in post-order, so visiting the SCCs backwards moves every small callee to the
+    // module of its first caller, and the callees of a merged callee follow it.
+    void MergeSmallCallees(std::size_t splitNum, const CalleeMap& directCallees)
+    {
+        std::size_t totalCost = std::accumulate(mergedCosts.begin(), mergedCosts.end(), std::size_t{0});
+        std::size_t maxCost = std::max(totalCost / std::max(splitNum, std::size_t{1}), SMALL_CALLEE_COST);
+        for (std::size_t i = sccs.size(); i > 0; --i) {
+            for (auto func : sccs[i - 1].funcs) {
+                auto callees = directCallees.find(func);
+                if (callees == directCallees.end()) {
+                    continue;
+                }
+                for (auto callee : callees->second) {
+                    auto calleeSCC = sccOf.find(callee);
+                    if (calleeSCC == sccOf.end()) {
+                        continue;
+                    }
+                    auto root = FindRoot(i - 1);
+                    auto calleeRoot = calleeSCC->second;
+                    // Only SCCs which have not been merged into another caller yet can be moved.
+                    if (parents[calleeRoot] != calleeRoot || calleeRoot == root ||
+                        sccs[calleeRoot].cost > SMALL_CALLEE_COST ||
+                        mergedCosts[root] + mergedCosts[calleeRoot] > maxCost) {
+                        continue;
+                    }
+                    parents[calleeRoot] = root;
+                    mergedCosts[root] += mergedCosts[calleeRoot];
+                }
+            }
+        }
+    }
+
+    std::size_t FindRoot(std::size_t idx)
+    {
+        while (parents[idx] != idx) {
+            parents[idx] = parents[parents[idx]];
+            idx = parents[idx];
+        }
+        return idx;
+    }
+
+    const CHIR::Package& chirPkg;
+    const GlobalOptions& options;
+    std::vector<FuncCluster> sccs;
+    std::unordered_map<const CHIR::Func*, std::size_t> sccOf;
+    // Union-find forest over sccs, with the total cost of each tree at its root.
+    std::vector<std::size_t> parents;
+    std::vector<std::size_t> mergedCosts;
+};
+
+void SplitForeign(
+    const CHIR::Package& chirPkg, SubCHIRPackageSet& subCHIRPackagesSet, std::map<std::string, std::size_t>& cache)
 {
     for (auto importedValue : chirPkg.GetImportedVarAndFuncs()) {
         if (!importedValue->TestAttr(CHIR::Attribute::FOREIGN) ||
@@ -183,42 +290,79 @@ void SplitForeign(const CHIR::Package& chirPkg, std::set<SubCHIRPackage, SubCHIR
         auto targetSubCHIRPackage = subCHIRPackagesSet.extract(target);
         auto& subCHIRPackage = targetSubCHIRPackage.value();
         subCHIRPackage.chirForeigns.emplace(foreign);
-        subCHIRPackage.exprNumInChirFuncs += 1;
-        cache.emplace(foreign->GetIdentifierWithoutPrefix(), subCHIRPackage.subCHIRPackageIdx);
+        subCHIRPackage.backendCost += 1;
+        cache.insert_or_assign(foreign->GetIdentifierWithoutPrefix(), subCHIRPackage.subCHIRPackageIdx);
         subCHIRPackagesSet.insert(std::move(targetSubCHIRPackage));
     }
 }
 }; // namespace
 
-// Split chirPkg.GetGlobalFuncs evenly into splitNum subCHIRPackages,
-// so that the total number of expressions of all functions in each subCHIRPackage is close to.
+bool SubCHIRPackageCmp::operator()(const SubCHIRPackage& lhs, const SubCHIRPackage& rhs) const
+{
+    return lhs.backendCost == rhs.backendCost ? lhs.subCHIRPackageIdx < rhs.subCHIRPackageIdx
+                                              : lhs.backendCost < rhs.backendCost;
+}
+
+// Functions assigned to a sub-package by a previous incremental compilation stay there, and the new functions of their
+// cluster follow them. All functions of a cluster go to the same sub-package, even if the cache had scattered them.
+void SplitFuncClusters(std::vector<FuncCluster>& clusters, SubCHIRPackageSet& subCHIRPackagesSet,
+    std::map<std::string, std::size_t>& cache)
+{
+    std::stable_sort(clusters.begin(), clusters.end(),
+        [](const FuncCluster& lhs, const FuncCluster& rhs) { return lhs.cost > rhs.cost; });
+    for (auto& cluster : clusters) {
+        auto target = subCHIRPackagesSet.end();
+        for (auto func : cluster.funcs) {
+            target = FindCachedSubCHIRPackage(func->GetIdentifierWithoutPrefix(), subCHIRPackagesSet, cache);
+            if (target != subCHIRPackagesSet.end()) {
+                break;
+            }
+        }
+        if (target == subCHIRPackagesSet.end()) {
+            target = subCHIRPackagesSet.begin();
+        }
+        auto targetSubCHIRPackage = subCHIRPackagesSet.extract(target);
+        auto& subCHIRPackage = targetSubCHIRPackage.value();
+        for (auto func : cluster.funcs) {
+            subCHIRPackage.chirFuncs.emplace(func);
+            cache.insert_or_assign(func->GetIdentifierWithoutPrefix(), subCHIRPackage.subCHIRPackageIdx);
+        }
+        subCHIRPackage.backendCost += cluster.cost;
+        subCHIRPackagesSet.insert(std::move(targetSubCHIRPackage));
+    }
+}
+
+// Split chirPkg.GetGlobalFuncs into splitNum subCHIRPackages, so that the estimated backend cost of each
+// subCHIRPackage is close to, while functions which call each other are emitted in the same module where LLVM can
+// inline them.
 void CHIRSplitter::SplitCHIRFuncs(std::vector<SubCHIRPackage>& subCHIRPackages)
 {
-    std::set<SubCHIRPackage, SubCHIRPackageCmp> subCHIRPackagesSet;
+    SubCHIRPackageSet subCHIRPackagesSet;
     for (auto subCHIRPackage : subCHIRPackages) {
         subCHIRPackagesSet.emplace(subCHIRPackage);
     }
 
     auto& chirPkg = cgPkgCtx.GetCHIRPackage();
-    // 1. Sorts chirFuncs based on the number of expressions in a chirFunc.
+    // 1. Collects the chirFuncs which are placed regardless of the call graph.
     auto globalInitFunc = chirPkg.GetPackageInitFunc();
     std::string globalInitFuncName = globalInitFunc->GetIdentifierWithoutPrefix();
     // init func must have suffix iiHv, index 4 is the start of ii. 2 is the length of il.
     auto globalInitLiteralFunc = VirtualCast<CHIR::Func*>(const_cast<CGPkgContext&>(cgPkgCtx).FindCHIRGlobalValue(
         globalInitFuncName.replace(globalInitFuncName.size() - 4, 2, "il")));
     std::vector<CHIR::Func*> toAnyFuncs{};
-    std::multimap<std::size_t, CHIR::Func*> sortedChirFuncs{};
+    std::unordered_set<const CHIR::Func*> specialFuncs{globalInitFunc, globalInitLiteralFunc};
     for (auto chirFunc : chirPkg.GetGlobalFuncs()) {
         if (chirPkg.GetName() == REFLECT_PACKAGE_NAME && chirFunc->GetSrcCodeIdentifier() == "toAny") {
             toAnyFuncs.emplace_back(chirFunc);
-        } else if (chirFunc != globalInitFunc && chirFunc != globalInitLiteralFunc) {
-            sortedChirFuncs.emplace(chirFunc->GetExpressionsNum(), chirFunc);
+            specialFuncs.emplace(chirFunc);
         }
     }
-    // 2. Add the chirFunc with the most expressions to the subCHIRPackage with the least exprNumInChirFuncs.
+    // 2. Clusters the other chirFuncs by the call graph, and adds the most expensive cluster to the subCHIRPackage
+    // with the least backendCost.
     SplitSpecialFuncs(
         *globalInitFunc, *globalInitLiteralFunc, toAnyFuncs, subCHIRPackagesSet, subCHIRPackagesCache.funcsCache);
-    SplitNormalFunc(sortedChirFuncs, subCHIRPackagesSet, subCHIRPackagesCache.funcsCache);
+    auto clusters = FuncClusterBuilder(chirPkg, cgPkgCtx.GetGlobalOptions()).Build(specialFuncs, splitNum);
+    SplitFuncClusters(clusters, subCHIRPackagesSet, subCHIRPackagesCache.funcsCache);
     SplitForeign(chirPkg, subCHIRPackagesSet, subCHIRPackagesCache.foreignsCache);
 
     for (auto subCHIRPackage : subCHIRPackagesSet) {
@@ -42,7 +42,7 @@ struct ChirValueCmp {
 struct SubCHIRPackage {
     bool mainModule = false;
     std::size_t subCHIRPackageIdx;
-    std::size_t exprNumInChirFuncs;
+    std::size_t backendCost; // Estimated cost of optimizing and emitting chirFuncs, see CHIRSplitter::SplitCHIRFuncs.
     std::size_t splitNum;
     std::set<CHIR::CustomTypeDef*, ChirTypeDefCmp> chirCustomDefs;
     std::set<CHIR::GlobalVar*, ChirValueCmp> chirGVs;
@@ -50,10 +50,31 @@ struct SubCHIRPackage {
     std::set<CHIR::ImportedFunc*, ChirValueCmp> chirForeigns;
     std::set<CHIR::ImportedFunc*, ChirValueCmp> chirImportedCFuncs;
 
-    explicit SubCHIRPackage(std::size_t splitNum);
+    SubCHIRPackage(std::size_t subCHIRPackageIdx, std::size_t splitNum);
     void Clear();
 };
 
+// Orders sub-packages by their estimated backend cost, the least loaded first.
+struct SubCHIRPackageCmp {
+    bool operator()(const SubCHIRPackage& lhs, const SubCHIRPackage& rhs) const;
+};
+using SubCHIRPackageSet = std::set<SubCHIRPackage, SubCHIRPackageCmp>;
+
+// Functions which should end up in the same module: a strongly connected component of the call graph, together with
+// small callees merged into it.
+struct FuncCluster {
+    std::vector<CHIR::Func*> funcs;
+    std::size_t cost{0};
+};
+
+/**
+ * Assign @p clusters to the sub-packages of @p subCHIRPackagesSet, the most expensive first, each to the least loaded
+ * sub-package. A cluster follows its functions to the sub-package recorded in @p cache by a previous incremental
+ * compilation if that sub-package still exists. @p cache is updated to the new assignment.
+ */
+void SplitFuncClusters(std::vector<FuncCluster>& clusters, SubCHIRPackageSet& subCHIRPackagesSet,
+    std::map<std::string, std::size_t>& cache);
+
 class CHIRSplitter {
 public:
     explicit CHIRSplitter(const CGPkgContext& cgPkgCtx);
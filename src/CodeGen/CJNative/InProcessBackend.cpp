@@ -0,0 +1,211 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+// The Cangjie API is in Beta. For details on its capabilities and limitations, please refer to the README file.
+
+/**
+ * @file
+ *
+ * This file implements the in-process backend. It is only available if cjc is built with
+ * CANGJIE_ENABLE_INPROCESS_BACKEND, which links the LLVM optimizer and code generators into cjc.
+ */
+
+#include "cangjie/CodeGen/InProcessBackend.h"
+
+#include "cangjie/Utils/CheckUtils.h"
+
+#ifdef CANGJIE_ENABLE_INPROCESS_BACKEND
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+#include "llvm/CodeGen/CommandFlags.h"
+#include "llvm/IR/LegacyPassManager.h"
+#include "llvm/IR/Verifier.h"
+#include "llvm/MC/TargetRegistry.h"
+#include "llvm/Passes/PassBuilder.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Host.h"
+#include "llvm/Support/TargetSelect.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Target/TargetMachine.h"
+
+#include "cangjie/Basic/Print.h"
+#include "cangjie/Basic/StringConvertor.h"
+#endif
+
+using namespace Cangjie;
+
+#ifdef CANGJIE_ENABLE_INPROCESS_BACKEND
+namespace {
+// Register the code generation options of 'llc', e.g. -mtriple, -mcpu and -relocation-model.
+llvm::codegen::RegisterCodeGenFlags g_codeGenFlags;
+
+const std::string PASSES_PREFIX = "-passes=";
+// 'opt' verifies its output when given this option.
+const std::string VERIFY_OUTPUT_OPTION = "--only-verify-out";
+
+struct BackendConfig {
+    std::vector<std::string> args; /**< The arguments the configuration has been parsed from. */
+    std::string passes;
+    llvm::CodeGenOpt::Level codeGenOptLevel{llvm::CodeGenOpt::Default};
+    bool verifyOutput{false};
+    bool valid{false};
+};
+
+std::mutex g_configMutex;
+std::optional<BackendConfig> g_config;
+
+std::optional<llvm::CodeGenOpt::Level> GetCodeGenOptLevel(const std::string& arg)
+{
+    static const std::unordered_map<std::string, llvm::CodeGenOpt::Level> levels = {
+        {"-O0", llvm::CodeGenOpt::None}, {"-O1", llvm::CodeGenOpt::Less}, {"-O2", llvm::CodeGenOpt::Default},
+        {"-O3", llvm::CodeGenOpt::Aggressive}};
+    auto found = levels.find(arg);
+    return found == levels.end() ? std::nullopt : std::make_optional(found->second);
+}
+
+// Options which are handled by the 'opt' and 'llc' tools themselves are applied here, all others are options of the
+// LLVM libraries and are set through LLVM's command line parser.
+bool ParseBackendConfig(BackendConfig& config)
+{
+    std::vector<const char*> argv{"cjc"};
+    for (auto& arg : config.args) {
+        if (arg.rfind(PASSES_PREFIX, 0) == 0) {
+            config.passes = arg.substr(PASSES_PREFIX.size());
+        } else if (auto level = GetCodeGenOptLevel(arg)) {
+            config.codeGenOptLevel = *level;
+        } else if (arg == VERIFY_OUTPUT_OPTION) {
+            config.verifyOutput = true;
+        } else {
+            argv.emplace_back(arg.c_str());
+        }
+    }
+    std::string errors;
+    llvm::raw_string_ostream errorStream(errors);
+    if (!llvm::cl::ParseCommandLineOptions(static_cast<int>(argv.size()), argv.data(), "", &errorStream)) {
+        return false;
+    }
+    llvm::InitializeAllTargetInfos();
+    llvm::InitializeAllTargets();
+    llvm::InitializeAllTargetMCs();
+    llvm::InitializeAllAsmPrinters();
+    llvm::InitializeAllAsmParsers();
+    return true;
+}
+
+std::unique_ptr<llvm::TargetMachine> CreateTargetMachine(llvm::Module& module, const BackendConfig& config)
+{
+    std::string tripleName = llvm::codegen::getMTriple();
+    if (tripleName.empty()) {
+        tripleName = module.getTargetTriple().empty() ? llvm::sys::getDefaultTargetTriple() : module.getTargetTriple();
+    }
+    llvm::Triple triple(llvm::Triple::normalize(tripleName));
+    std::string error;
+    auto target = llvm::TargetRegistry::lookupTarget(llvm::codegen::getMArch(), triple, error);
+    if (!target) {
+        Errorln("Failed to find the target ", triple.getTriple(), ": ", error);
+        return nullptr;
+    }
+    auto targetOptions = llvm::codegen::InitTargetOptionsFromCodeGenFlags(triple);
+    return std::unique_ptr<llvm::TargetMachine>(target->createTargetMachine(triple.getTriple(),
+        llvm::codegen::getCPUStr(), llvm::codegen::getFeaturesStr(), targetOptions,
+        llvm::codegen::getExplicitRelocModel(), llvm::codegen::getExplicitCodeModel(), config.codeGenOptLevel));
+}
+
+// The work of 'opt'.
+bool Optimize(llvm::Module& module, llvm::TargetMachine& targetMachine, const BackendConfig& config)
+{
+    llvm::LoopAnalysisManager loopAnalyses;
+    llvm::FunctionAnalysisManager functionAnalyses;
+    llvm::CGSCCAnalysisManager cgsccAnalyses;
+    llvm::ModuleAnalysisManager moduleAnalyses;
+    llvm::PassBuilder passBuilder(&targetMachine);
+    passBuilder.registerModuleAnalyses(moduleAnalyses);
+    passBuilder.registerCGSCCAnalyses(cgsccAnalyses);
+    passBuilder.registerFunctionAnalyses(functionAnalyses);
+    passBuilder.registerLoopAnalyses(loopAnalyses);
+    passBuilder.crossRegisterProxies(loopAnalyses, functionAnalyses, cgsccAnalyses, moduleAnalyses);
+
+    llvm::ModulePassManager passes;
+    if (auto err = passBuilder.parsePassPipeline(passes, config.passes)) {
+        Errorln("Failed to parse the pass pipeline: ", llvm::toString(std::move(err)));
+        return false;
+    }
+    if (config.verifyOutput) {
+        passes.addPass(llvm::VerifierPass());
+    }
+    passes.run(module, moduleAnalyses);
+    return true;
+}
+
+// The work of 'llc'.
+bool EmitObject(llvm::Module& module, llvm::TargetMachine& targetMachine, const std::string& objFilePath)
+{
+    std::error_code errorCode;
+#ifdef _WIN32
+    std::optional<std::string> tempPath = StringConvertor::NormalizeStringToUTF8(objFilePath);
+    CJC_ASSERT(tempPath.has_value() && "Incorrect file name encoding.");
+    llvm::raw_fd_ostream os(tempPath.value(), errorCode, llvm::sys::fs::OF_None);
+#else
+    llvm::raw_fd_ostream os(objFilePath, errorCode, llvm::sys::fs::OF_None);
+#endif
+    if (errorCode) {
+        Errorln("Failed to open the object file: ", errorCode.message());
+        return false;
+    }
+    llvm::legacy::PassManager codeGenPasses;
+    if (targetMachine.addPassesToEmitFile(codeGenPasses, os, nullptr, llvm::CGFT_ObjectFile)) {
+        Errorln("The target does not support emitting object files.");
+        return false;
+    }
+    codeGenPasses.run(module);
+    os.close();
+    if (os.has_error()) {
+        Errorln("Failed to write the object file: ", os.error().message());
+        os.clear_error();
+        return false;
+    }
+    return true;
+}
+} // namespace
+#endif
+
+bool CodeGen::InitInProcessBackend([[maybe_unused]] const std::vector<std::string>& args)
+{
+#ifdef CANGJIE_ENABLE_INPROCESS_BACKEND
+    std::lock_guard<std::mutex> lock(g_configMutex);
+    if (!g_config) {
+        g_config = BackendConfig{args};
+        g_config->valid = ParseBackendConfig(*g_config);
+    }
+    return g_config->valid && g_config->args == args;
+#else
+    return false;
+#endif
+}
+
+bool CodeGen::EmitObjectFile([[maybe_unused]] llvm::Module& module, [[maybe_unused]] const std::string& objFilePath)
+{
+#ifdef CANGJIE_ENABLE_INPROCESS_BACKEND
+    CJC_ASSERT(g_config && g_config->valid);
+    const BackendConfig& config = *g_config;
+    auto targetMachine = CreateTargetMachine(module, config);
+    if (!targetMachine) {
+        return false;
+    }
+    module.setTargetTriple(targetMachine->getTargetTriple().getTriple());
+    module.setDataLayout(targetMachine->createDataLayout());
+    // Attributes such as the frame pointer kind are given to 'llc' as options and applied to every function.
+    llvm::codegen::setFunctionAttributes(
+        targetMachine->getTargetCPU(), targetMachine->getTargetFeatureString(), module);
+    return Optimize(module, *targetMachine, config) && EmitObject(module, *targetMachine, objFilePath);
+#else
+    CJC_ASSERT(false && "cjc is built without the in-process backend");
+    return false;
+#endif
+}
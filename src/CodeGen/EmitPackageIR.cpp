@@ -30,7 +30,9 @@
 #include "cangjie/CHIR/Value.h"
 #include "cangjie/Frontend/CompilerInstance.h"
 #include "cangjie/FrontendTool/IncrementalCompilerInstance.h"
+#include "cangjie/Utils/FileUtil.h"
 #include "cangjie/Utils/ProfileRecorder.h"
+#include "cangjie/Utils/SipHash.h"
 #include "cangjie/Utils/TaskQueue.h"
 
 namespace Cangjie::CodeGen {
@@ -412,6 +414,106 @@ void GenSubCHIRPackage(CGModule& cgMod)
     }
     RecordCodeInfoInCodeGen("CodeGen stage", cgMod);
     }
+
+// Accumulates the hashes of the parts of an object cache key.
+class CacheKeyHasher {
+public:
+    void Add(const std::string& part)
+    {
+        hashes.emplace_back(Utils::SipHash::GetHashValue(part));
+    }
+
+    // Add parts whose order is not stable between compilations.
+    void AddUnordered(std::vector<std::string>&& parts)
+    {
+        std::sort(parts.begin(), parts.end());
+        for (auto& part : parts) {
+            Add(part);
+        }
+    }
+
+    std::string GetKey() const
+    {
+        return Utils::PersistentCache::HashToKey(Utils::SipHash::GetHashValue(
+            reinterpret_cast<const uint8_t*>(hashes.data()), hashes.size() * sizeof(uint64_t)));
+    }
+
+private:
+    std::vector<uint64_t> hashes;
+};
+
+template <typename T> void CollectToStrings(const std::vector<T*>& values, std::vector<std::string>& strings)
+{
+    for (auto value : values) {
+        strings.emplace_back(value->ToString());
+    }
+}
+
+// Everything in the package a sub-module may depend on besides its own content: the options, the type definitions of
+// the package and its imports, and the signatures of all global values.
+std::string GetPackageCacheKey(const CGPkgContext& cgPkgCtx)
+{
+    CacheKeyHasher hasher;
+    auto& options = cgPkgCtx.GetGlobalOptions();
+    hasher.Add(CANGJIE_SDK_VERSION);
+    for (auto& arg : SerializeCodeGenOptions(options)) {
+        hasher.Add(arg);
+    }
+    if (cgPkgCtx.IsLineInfoEnabled()) {
+        // Debug information refers to the source files by their absolute paths.
+        hasher.Add(FileUtil::GetAbsPath(".").value_or(""));
+        hasher.AddUnordered(std::vector<std::string>(options.srcFiles));
+        hasher.AddUnordered(std::vector<std::string>(options.packagePaths));
+    }
+    auto& chirPkg = cgPkgCtx.GetCHIRPackage();
+    hasher.Add(chirPkg.GetName());
+    std::vector<std::string> defs;
+    CollectToStrings(chirPkg.GetClasses(), defs);
+    CollectToStrings(chirPkg.GetImportedClasses(), defs);
+    CollectToStrings(chirPkg.GetStructs(), defs);
+    CollectToStrings(chirPkg.GetImportedStructs(), defs);
+    CollectToStrings(chirPkg.GetEnums(), defs);
+    CollectToStrings(chirPkg.GetImportedEnums(), defs);
+    CollectToStrings(chirPkg.GetExtends(), defs);
+    CollectToStrings(chirPkg.GetImportedExtends(), defs);
+    hasher.AddUnordered(std::move(defs));
+    std::vector<std::string> signatures;
+    for (auto gv : chirPkg.GetGlobalVars()) {
+        signatures.emplace_back(gv->GetAttributeInfo().ToString() + gv->GetIdentifier() + gv->GetType()->ToString());
+    }
+    for (auto func : chirPkg.GetGlobalFuncs()) {
+        signatures.emplace_back(
+            func->GetAttributeInfo().ToString() + func->GetIdentifier() + func->GetType()->ToString());
+    }
+    CollectToStrings(chirPkg.GetImportedVarAndFuncs(), signatures);
+    hasher.AddUnordered(std::move(signatures));
+    return hasher.GetKey();
+}
+
+std::string GetSubCHIRPackageCacheKey(const SubCHIRPackage& subCHIRPkg, const std::string& packageKey)
+{
+    CacheKeyHasher hasher;
+    hasher.Add(packageKey);
+    hasher.Add(std::to_string(subCHIRPkg.subCHIRPackageIdx) + "/" + std::to_string(subCHIRPkg.splitNum));
+    hasher.Add(subCHIRPkg.mainModule ? "main" : "");
+    // The sets are ordered by identifier, so their order is stable.
+    for (auto def : subCHIRPkg.chirCustomDefs) {
+        hasher.Add(def->GetIdentifier());
+    }
+    for (auto gv : subCHIRPkg.chirGVs) {
+        hasher.Add(gv->ToString());
+    }
+    for (auto func : subCHIRPkg.chirFuncs) {
+        hasher.Add(func->ToString());
+    }
+    for (auto foreign : subCHIRPkg.chirForeigns) {
+        hasher.Add(foreign->ToString());
+    }
+    for (auto cFunc : subCHIRPkg.chirImportedCFuncs) {
+        hasher.Add(cFunc->ToString());
+    }
+    return hasher.GetKey() + packageKey;
+}
 #endif
 } // namespace
 
@@ -423,6 +525,13 @@ public:
     {
     }
 
+#ifdef CANGJIE_CODEGEN_CJNATIVE_BACKEND
+    void SetObjectCache(ObjectCacheSession* session)
+    {
+        objectCache = session;
+    }
+#endif
+
     void EmitIR() override;
 
     std::vector<std::unique_ptr<llvm::Module>> ReleaseLLVMModules()
@@ -489,6 +598,25 @@ private:
         }
         Utils::ProfileRecorder::Stop("EmitIR", "GenSubCHIRPackages");
     }
+
+    // Returns true if the object file of @p subCHIRPkg is taken from the object cache, it is not generated then.
+    bool ReuseCachedObject(const SubCHIRPackage& subCHIRPkg, size_t index, const std::string& packageKey)
+    {
+        ObjectCacheSession::Entry entry{GetSubCHIRPackageCacheKey(subCHIRPkg, packageKey), index, {}, {}};
+        std::string metadata;
+        if (!objectCache->cache.Lookup(entry.key, entry.object, metadata)) {
+            objectCache->generated.emplace_back(std::move(entry));
+            return false;
+        }
+        entry.localizedSymbols = FileUtil::SplitStr(metadata, '\n');
+        for (auto& symbol : entry.localizedSymbols) {
+            cgPkgCtx.AddLocalizedSymbol(symbol);
+        }
+        objectCache->reused.emplace_back(std::move(entry));
+        return true;
+    }
+
+    ObjectCacheSession* objectCache{nullptr};
 #endif
 
 private:
@@ -567,18 +695,37 @@ void PackageGeneratorImpl::EmitIR()
     // Splitting CHIRPackage into n subCHIRPackages and Construct cgMods.
     CHIRSplitter chirSplitter(cgPkgCtx);
     auto subCHIRPkgs = chirSplitter.SplitCHIRPackage();
-    for (auto& subCHIRPkg : subCHIRPkgs) {
+    std::string packageKey;
+    if (objectCache) {
+        Utils::ProfileRecorder cacheRecorder("EmitIR", "LookupObjectCache");
+        packageKey = GetPackageCacheKey(cgPkgCtx);
+    }
+    for (size_t i = 0; i < subCHIRPkgs.size(); ++i) {
+        auto& subCHIRPkg = subCHIRPkgs[i];
+        if (objectCache && ReuseCachedObject(subCHIRPkg, i, packageKey)) {
+            continue;
+        }
         auto cgMod = std::make_unique<CGModule>(subCHIRPkg, cgPkgCtx);
         cgPkgCtx.AddCGModule(cgMod);
     }
 
-    // Reads the buffered bitcode.
-    if (!InitIncrementalGen()) {
-        return;
+    if (!cgPkgCtx.GetCGModules().empty()) {
+        // Reads the buffered bitcode.
+        if (!InitIncrementalGen()) {
+            return;
+        }
+
+        // Translate CHIR to LLVM IR
+        GenSubCHIRPackages();
     }
 
-    // Translate CHIR to LLVM IR
-    GenSubCHIRPackages();
+    if (objectCache) {
+        auto& cgMods = cgPkgCtx.GetCGModules();
+        CJC_ASSERT(cgMods.size() == objectCache->generated.size());
+        for (size_t i = 0; i < cgMods.size(); ++i) {
+            objectCache->generated[i].localizedSymbols = cgMods[i]->GetCGContext().GetLocalizedSymbols();
+        }
+    }
 
     auto localizedSymbols = cgPkgCtx.GetLocalizedSymbols();
     const_cast<GlobalOptions&>(cgPkgCtx.GetGlobalOptions()).symbolsNeedLocalized =
@@ -589,14 +736,32 @@ void PackageGeneratorImpl::EmitIR()
 #endif
 
 #ifdef CANGJIE_CODEGEN_CJNATIVE_BACKEND
+std::vector<std::string> SerializeCodeGenOptions(const GlobalOptions& options)
+{
+    auto result = options.ToSerialized();
+    auto boolToString = [](bool value) { return value ? "true" : "false"; };
+    result.emplace_back(std::to_string(static_cast<uint8_t>(options.mock)));
+    result.emplace_back(boolToString(options.compileTestsOnly));
+    result.emplace_back(boolToString(options.disableInstantiation));
+    result.emplace_back(boolToString(options.disableReflection));
+    result.emplace_back(boolToString(options.enableOpaque));
+    result.emplace_back(boolToString(options.cjdbMode));
+    result.emplace_back(
+        options.aggressiveParallelCompile ? std::to_string(*options.aggressiveParallelCompile) : std::string());
+    result.insert(result.end(), options.inProcessBackendArgs.begin(), options.inProcessBackendArgs.end());
+    return result;
+}
+
 std::vector<std::unique_ptr<llvm::Module>> GenPackageModules(CHIR::CHIRBuilder& chirBuilder, const CHIRData& chirData,
-    const GlobalOptions& options, DefaultCompilerInstance& compilerInstance, bool enableIncrement)
+    const GlobalOptions& options, DefaultCompilerInstance& compilerInstance, bool enableIncrement,
+    ObjectCacheSession* objectCache)
 {
     CachedMangleMap cachedMangleMap;
     if (enableIncrement) {
         cachedMangleMap = StaticCast<Cangjie::IncrementalCompilerInstance&>(compilerInstance).cacheMangles;
     }
     auto temp = PackageGeneratorImpl(chirBuilder, chirData, options, enableIncrement, cachedMangleMap);
+    temp.SetObjectCache(objectCache);
     temp.EmitIR();
     return temp.ReleaseLLVMModules();
 }
@@ -14,6 +14,8 @@
 
 #include "cangjie/Driver/Backend/CJNATIVEBackend.h"
 
+#include <algorithm>
+
 #include "Job.h"
 #include "cangjie/Driver/TempFileManager.h"
 #include "cangjie/Driver/ToolOptions.h"
@@ -167,11 +169,20 @@ bool CJNATIVEBackend::ProcessGenerationOfNormalCompile(const std::vector<TempFil
         return TC->ProcessGeneration(preprocessedFiles);
     }
 
-    auto preprocessedFiles = GeneratePreprocessTools(bitCodeFiles);
-    if (driverOptions.saveTemps) {
-        (void)GenerateCompileTool(preprocessedFiles, true);
+    // Objects which the frontend has emitted with the in-process backend are linked directly.
+    std::vector<TempFileInfo> objFiles;
+    std::vector<TempFileInfo> backendInputs;
+    for (auto& fileInfo : bitCodeFiles) {
+        (fileInfo.isObject ? objFiles : backendInputs).emplace_back(fileInfo);
+    }
+    if (!backendInputs.empty()) {
+        auto preprocessedFiles = GeneratePreprocessTools(backendInputs);
+        if (driverOptions.saveTemps) {
+            (void)GenerateCompileTool(preprocessedFiles, true);
+        }
+        auto compiledFiles = GenerateCompileTool(preprocessedFiles);
+        objFiles.insert(objFiles.end(), compiledFiles.begin(), compiledFiles.end());
     }
-    auto objFiles = GenerateCompileTool(preprocessedFiles);
     // copy each obj file from temporary directory to cache directory in normal compile case
     ToolBatch batch{};
     for (auto& objFile : objFiles) {
@@ -243,7 +254,7 @@ bool CJNATIVEBackend::ProcessGenerationOfIncrementalNoChangeCompile(const std::v
     return TC->ProcessGeneration(tempBitCodeFiles);
 }
 
-void CJNATIVEBackend::PreprocessOfNewPassManager(Tool& tool)
+std::string CJNATIVEBackend::GetNewPassManagerPipeline(const DriverOptions& driverOptions)
 {
     std::string passesCollector = "-passes=";
     std::vector<std::string> passItems;
@@ -264,13 +275,75 @@ void CJNATIVEBackend::PreprocessOfNewPassManager(Tool& tool)
             passesCollector += ",";
         }
     }
-    tool.AppendArg(passesCollector);
+    return passesCollector;
+}
+
+void CJNATIVEBackend::PreprocessOfNewPassManager(Tool& tool)
+{
+    tool.AppendArg(GetNewPassManagerPipeline(driverOptions));
+}
+
+std::vector<std::string> CJNATIVEBackend::GetPreprocessOptions(const DriverOptions& driverOptions)
+{
+    std::vector<std::string> options;
+    using namespace ToolOptions;
+    SetFuncType setOptionHandler = [&options](const std::string& option) { options.emplace_back(option); };
+    std::vector<ToolOptionType> setOptionsPass = {
+        OPT::SetOptions,                // Comment ensure vector members are arranged vertically.
+        OPT::SetVerifyOptions,          //
+        OPT::SetTripleOptions,          //
+        OPT::SetCodeObfuscationOptions, //
+        OPT::SetLTOOptions,             //
+        OPT::SetPgoOptions,             //
+        OPT::SetTransparentOptions      // The transparent options must after other options.
+    };
+    SetOptions(setOptionHandler, driverOptions, setOptionsPass);
+    return options;
+}
+
+std::vector<std::string> CJNATIVEBackend::GetCompileOptions(const DriverOptions& driverOptions)
+{
+    std::vector<std::string> options;
+    using namespace ToolOptions;
+    SetFuncType setOptionHandler = [&options](const std::string& option) { options.emplace_back(option); };
+    std::vector<ToolOptionType> setOptionsPass = {
+        LLC::SetOptions,                  // Comment ensure vector members are arranged vertically.
+        LLC::SetTripleOptions,            //
+        LLC::SetOptimizationLevelOptions, //
+        LLC::SetTransparentOptions,       // The transparent options must after other options.
+    };
+    SetOptions(setOptionHandler, driverOptions, setOptionsPass);
+    return options;
+}
+
+void CJNATIVEBackend::PrepareInProcessBackend(DriverOptions& driverOptions)
+{
+    driverOptions.inProcessBackendArgs.clear();
+    // LTO hands bitcode over to the linker, --save-temps keeps the intermediate files of 'opt' and 'llc', and the
+    // incremental cache stores bitcode. Options that are passed through to the tools, PGO and obfuscation are left to
+    // the tools as well: LLVM command line options are global to a process and only a known set is applied in process.
+    if (!driverOptions.inProcessBackend || driverOptions.IsLTOEnabled() || driverOptions.saveTemps ||
+        driverOptions.enIncrementalCompilation || !driverOptions.optArg.empty() || !driverOptions.llcArg.empty() ||
+        driverOptions.enablePgoInstrGen || driverOptions.enablePgoInstrUse || driverOptions.IsObfuscationEnabled()) {
+        return;
+    }
+    auto& args = driverOptions.inProcessBackendArgs;
+    args.emplace_back(GetNewPassManagerPipeline(driverOptions));
+    auto preprocessOptions = GetPreprocessOptions(driverOptions);
+    args.insert(args.end(), preprocessOptions.begin(), preprocessOptions.end());
+    // 'opt' and 'llc' share some options, which may only be given once to one command line.
+    for (auto& option : GetCompileOptions(driverOptions)) {
+        if (std::find(args.begin(), args.end(), option) == args.end()) {
+            args.emplace_back(option);
+        }
+    }
 }
 
 std::vector<TempFileInfo> CJNATIVEBackend::GeneratePreprocessTools(const std::vector<TempFileInfo>& bitCodeFiles)
 {
     std::vector<TempFileInfo> outputFiles;
     ToolBatch batch{};
+    auto options = GetPreprocessOptions(driverOptions);
     for (const auto& bitCodeFile : bitCodeFiles) {
         // 'opt' can only process one file in one execution, for each bitCodeFile, generate one 'opt' command for it.
         std::unique_ptr<Tool> tool = GenerateCJNativeBaseTool(optPath);
@@ -280,19 +353,8 @@ std::vector<TempFileInfo> CJNATIVEBackend::GeneratePreprocessTools(const std::ve
         // set options
         // handle the new pass manager of 'opt'
         PreprocessOfNewPassManager(*tool);
-        {
-            using namespace ToolOptions;
-            SetFuncType setOptionHandler = [&tool](const std::string& option) { tool->AppendArg(option); };
-            std::vector<ToolOptionType> setOptionsPass = {
-                OPT::SetOptions,                // Comment ensure vector members are arranged vertically.
-                OPT::SetVerifyOptions,          //
-                OPT::SetTripleOptions,          //
-                OPT::SetCodeObfuscationOptions, //
-                OPT::SetLTOOptions,             //
-                OPT::SetPgoOptions,             //
-                OPT::SetTransparentOptions      // The transparent options must after other options.
-            };
-            SetOptions(setOptionHandler, driverOptions, setOptionsPass);
+        for (auto& option : options) {
+            tool->AppendArg(option);
         }
 
         // set output
@@ -316,6 +378,7 @@ std::vector<TempFileInfo> CJNATIVEBackend::GenerateCompileTool(
 {
     std::vector<TempFileInfo> outputFiles;
     ToolBatch batch{};
+    auto options = GetCompileOptions(driverOptions);
     for (const auto& bitCodeFile : bitCodeFiles) {
         // 'llc' can only process one file in one execution, for each bitCodeFile,
         // generate one 'llc' command for it, just like 'opt'.
@@ -325,16 +388,8 @@ std::vector<TempFileInfo> CJNATIVEBackend::GenerateCompileTool(
         tool->AppendArg(bitCodeFile.filePath);
 
         // set options
-        {
-            using namespace ToolOptions;
-            SetFuncType setOptionHandler = [&tool](const std::string& option) { tool->AppendArg(option); };
-            std::vector<ToolOptionType> setOptionsPass = {
-                LLC::SetOptions,                  // Comment ensure vector members are arranged vertically.
-                LLC::SetTripleOptions,             //
-                LLC::SetOptimizationLevelOptions, //
-                LLC::SetTransparentOptions,       // The transparent options must after other options.
-            };
-            SetOptions(setOptionHandler, driverOptions, setOptionsPass);
+        for (auto& option : options) {
+            tool->AppendArg(option);
         }
 
         // set output
@@ -23,6 +23,9 @@
 
 #include "cangjie/Basic/Print.h"
 #include "cangjie/Basic/Version.h"
+#ifdef CANGJIE_CODEGEN_CJNATIVE_BACKEND
+#include "cangjie/Driver/Backend/CJNATIVEBackend.h"
+#endif
 #include "cangjie/Driver/TempFileManager.h"
 #include "cangjie/Driver/Utils.h"
 #include "cangjie/FrontendTool/DefaultCompilerInstance.h"
@@ -172,6 +175,11 @@ bool Driver::ExecuteCompilation() const
     if (!TempFileManager::Instance().Init(*driverOptions, false)) {
         return false;
     }
+#ifdef CANGJIE_CODEGEN_CJNATIVE_BACKEND
+    if (driverOptions->backend == Triple::BackendType::CJNATIVE) {
+        CJNATIVEBackend::PrepareInProcessBackend(*driverOptions);
+    }
+#endif
     CompilerInvocation compilerInvocation;
 
     compilerInvocation.globalOptions = *driverOptions;
@@ -30,6 +30,7 @@
 #include "cangjie/Utils/Signal.h"
 #endif
 #include "cangjie/Utils/ProfileRecorder.h"
+#include "cangjie/Utils/TaskQueue.h"
 
 using namespace Cangjie;
 using namespace Utils;
@@ -86,6 +87,21 @@ public:
     {
     }
 
+    /** The result of reading and parsing one source file. */
+    struct ParsedFile {
+        OwnedPtr<File> file;      /**< Null if the file could not be read. */
+        TokenVecMap comments;
+        size_t lineNum{0};
+        std::string path;         /**< Only set if the file could not be read. */
+        std::string failedReason; /**< Why the file could not be read. */
+    };
+    /** A package whose files are being read and parsed. */
+    struct PendingPackage {
+        std::string defaultPackageName;
+        std::vector<TaskResult<ParsedFile>> files;
+        bool needExported{true};
+    };
+
     void MergePackage(const Ptr<Package> target, const Ptr<Package> source)
     {
         if (target->accessible != source->accessible) {
@@ -139,6 +155,10 @@ public:
             includeFileSet.insert(
                 s.ci->invocation.globalOptions.srcFiles.begin(), s.ci->invocation.globalOptions.srcFiles.end());
         }
+        // Files of all package directories are read and parsed by one queue, packages are then assembled in the
+        // order of their directories.
+        TaskQueue parseQueue(s.ci->invocation.globalOptions.GetJobs());
+        std::vector<PendingPackage> pendingPackages;
         for (auto& srcDir : s.ci->srcDirs) {
             std::vector<std::string> allSrcFiles;
             auto currentPkg = DEFAULT_PACKAGE_NAME;
@@ -158,8 +178,13 @@ public:
                     allSrcFiles.push_back(filename);
                 }
             }
-            auto package = ParseOnePackage(allSrcFiles, success, currentPkg);
-            if (srcDir == moduleSrcPath) {
+            auto& pending = pendingPackages.emplace_back(ScheduleParseOnePackage(allSrcFiles, currentPkg, parseQueue));
+            pending.needExported = srcDir != moduleSrcPath;
+        }
+        parseQueue.RunAndWaitForAllTasksCompleted();
+        for (auto& pending : pendingPackages) {
+            auto package = CollectParsedPackage(pending, success);
+            if (!pending.needExported) {
                 package->needExported = false;
             }
             if (NeedToAddPackage(package)) {
@@ -201,23 +226,25 @@ public:
     }
 
     OwnedPtr<AST::Package> GetMultiThreadParseOnePackage(
-        std::queue<std::future<std::tuple<OwnedPtr<File>, TokenVecMap, size_t>>>& futureQueue,
-        const std::string& defaultPackageName) const
+        std::vector<TaskResult<ParsedFile>>& parsedFiles, const std::string& defaultPackageName, bool& success) const
     {
         auto package = MakeOwned<Package>(defaultPackageName);
         size_t lineNumInOnePackage = 0;
-        const size_t filePtrIdx = 0;
-        const size_t commentIdx = 1;
-        const size_t lineNumIdx = 2;
-        while (!futureQueue.empty()) {
-            auto curFuture = futureQueue.front().get();
-            std::get<filePtrIdx>(curFuture)->curPackage = package.get();
-            std::get<filePtrIdx>(curFuture)->indexOfPackage = package->files.size();
-            package->files.push_back(std::move(std::get<filePtrIdx>(curFuture)));
-            s.ci->GetSourceManager().AddComments(std::get<commentIdx>(curFuture));
-            lineNumInOnePackage += std::get<lineNumIdx>(curFuture);
-            futureQueue.pop();
+        for (auto& parsedFile : parsedFiles) {
+            auto curFile = parsedFile.get();
+            if (!curFile.file) {
+                s.ci->diag.DiagnoseRefactor(DiagKindRefactor::module_read_file_to_buffer_failed, DEFAULT_POSITION,
+                    curFile.path, curFile.failedReason);
+                success = false;
+                continue;
+            }
+            curFile.file->curPackage = package.get();
+            curFile.file->indexOfPackage = package->files.size();
+            package->files.push_back(std::move(curFile.file));
+            s.ci->GetSourceManager().AddComments(curFile.comments);
+            lineNumInOnePackage += curFile.lineNum;
         }
+        parsedFiles.clear();
         Utils::ProfileRecorder::RecordCodeInfo("package line num", static_cast<int64_t>(lineNumInOnePackage));
         if (!package->files.empty()) {
             // Only update name of package node for first parsed file.
@@ -249,92 +276,97 @@ public:
         package.isMacroPackage = package.files[0]->package->hasMacro;
     }
 
-    OwnedPtr<Package> MultiThreadParseOnePackage(
-        std::queue<std::tuple<std::string, unsigned>>& fileInfoQueue, const std::string& defaultPackageName) const
+    static void PrepareParserThread()
     {
-        std::queue<std::future<std::tuple<OwnedPtr<File>, TokenVecMap, size_t>>> futureQueue;
-        while (!fileInfoQueue.empty()) {
-            auto curFile = fileInfoQueue.front();
-            futureQueue.push(
-                std::async(std::launch::async, [this, curFile]() -> std::tuple<OwnedPtr<File>, TokenVecMap, size_t> {
 #if (defined RELEASE)
 #if (defined __unix__)
-                    // Since alternate signal stack is per thread, we have to create an alternate signal stack for each
-                    // thread.
-                    Cangjie::CreateAltSignalStack();
+        // Since alternate signal stack is per thread, we have to create an alternate signal stack for each
+        // thread.
+        Cangjie::CreateAltSignalStack();
 #elif _WIN32
-                    // When the SIGABRT, SIGFPE, SIGSEGV and SIGILL signals are triggered in a subthread,
-                    // the signals cannot be captured and the process exits directly. Therefore,
-                    // the signal processing function must be set for each thread.
-                    Cangjie::RegisterCrashSignalHandler();
-#endif
+        // When the SIGABRT, SIGFPE, SIGSEGV and SIGILL signals are triggered in a subthread,
+        // the signals cannot be captured and the process exits directly. Therefore,
+        // the signal processing function must be set for each thread.
+        Cangjie::RegisterCrashSignalHandler();
 #endif
-                    auto parser = CreateParser(curFile);
-                    parser->SetCompileOptions(s.ci->invocation.globalOptions);
-                    auto file = parser->ParseTopLevel();
-#ifdef SIGNAL_TEST
-                    // The interrupt signal triggers the function. In normal cases, this function does not take effect.
-                    Cangjie::SignalTest::ExecuteSignalTestCallbackFunc(
-                        Cangjie::SignalTest::TriggerPointer::PARSER_POINTER);
 #endif
-                    return {std::move(file), parser->GetCommentsMap(), parser->GetLineNum()};
-                }));
-            fileInfoQueue.pop();
-        }
-
-        auto package = GetMultiThreadParseOnePackage(futureQueue, defaultPackageName);
-        return package;
     }
 
-    OwnedPtr<Parser> CreateParser(const std::tuple<std::string, unsigned>& curFile) const
+    /** Parse the source @p fileID, whose content must have been set in the SourceManager. */
+    ParsedFile ParseFile(unsigned int fileID) const
     {
-        return MakeOwned<Parser>(std::get<1>(curFile), std::get<0>(curFile), s.ci->diag, s.ci->GetSourceManager(),
-            s.ci->invocation.globalOptions.enableAddCommentToAst, s.ci->invocation.globalOptions.compileCjd);
+        // The lexer reads the content stored in the SourceManager in place, it is never copied.
+        auto parser = MakeOwned<Parser>(fileID, s.ci->GetSourceManager().GetSource(fileID).buffer, s.ci->diag,
+            s.ci->GetSourceManager(), s.ci->invocation.globalOptions.enableAddCommentToAst,
+            s.ci->invocation.globalOptions.compileCjd);
+        parser->SetCompileOptions(s.ci->invocation.globalOptions);
+        auto file = parser->ParseTopLevel();
+#ifdef SIGNAL_TEST
+        // The interrupt signal triggers the function. In normal cases, this function does not take effect.
+        Cangjie::SignalTest::ExecuteSignalTestCallbackFunc(Cangjie::SignalTest::TriggerPointer::PARSER_POINTER);
+#endif
+        return {std::move(file), parser->GetCommentsMap(), parser->GetLineNum(), "", ""};
     }
 
-    OwnedPtr<Package> ParseOnePackage(
-        const std::vector<std::string>& files, bool& success, const std::string& defaultPackageName)
+    /**
+     * Register the files of a package in the SourceManager and add a task reading and parsing each of them to
+     * @p queue. File ids are assigned here, in a stable order, while the contents are read by the tasks, so that
+     * reading a file overlaps with parsing the ones which have already been read.
+     */
+    PendingPackage ScheduleParseOnePackage(
+        const std::vector<std::string>& files, const std::string& defaultPackageName, TaskQueue& queue)
     {
-        std::queue<std::tuple<std::string, unsigned>> fileInfoQueue;
-
-        // Parse source code files to File node list.
+        PendingPackage pending{defaultPackageName, {}};
+        auto& sm = s.ci->GetSourceManager();
         if (s.ci->loadSrcFilesFromCache) {
             for (auto& it : s.ci->bufferCache) {
-                const unsigned int fileID = s.ci->GetSourceManager().AddSource(it.first, it.second);
+                const unsigned int fileID = sm.ReserveSource(it.first);
                 if (s.fileIds.count(fileID) > 0) {
                     (void)s.ci->diag.DiagnoseRefactor(
                         DiagKindRefactor::module_read_file_conflicted, DEFAULT_POSITION, it.first);
+                    continue;
                 }
                 (void)s.fileIds.insert(fileID);
-                fileInfoQueue.emplace(it.second, fileID);
+                const std::string& content = it.second;
+                pending.files.emplace_back(queue.AddTask<ParsedFile>([this, fileID, &content]() {
+                    PrepareParserThread();
+                    s.ci->GetSourceManager().SetSourceBuffer(fileID, std::string(content));
+                    return ParseFile(fileID);
+                }));
             }
-        } else {
-            // The readdir cannot guarantee stable order of inputted files, need sort before adding to sourceManager.
-            std::vector<std::string> parseFiles{files};
-            std::sort(parseFiles.begin(), parseFiles.end(),
-                [&](auto& f, auto& second) { return GetFileName(f) < GetFileName(second); });
-            std::for_each(parseFiles.begin(), parseFiles.end(), [this, &success, &fileInfoQueue](auto file) {
-                std::string failedReason;
-                auto content = ReadFileContent(file, failedReason);
+            return pending;
+        }
+        // The readdir cannot guarantee stable order of inputted files, need sort before adding to sourceManager.
+        std::vector<std::string> parseFiles{files};
+        std::sort(parseFiles.begin(), parseFiles.end(),
+            [&](auto& f, auto& second) { return GetFileName(f) < GetFileName(second); });
+        for (auto& file : parseFiles) {
+            const unsigned int fileID = sm.ReserveSource(file | IdenticalFunc);
+            if (s.fileIds.count(fileID) > 0) {
+                (void)s.ci->diag.DiagnoseRefactor(
+                    DiagKindRefactor::module_read_file_conflicted, DEFAULT_POSITION, file);
+                continue;
+            }
+            (void)s.fileIds.insert(fileID);
+            pending.files.emplace_back(queue.AddTask<ParsedFile>([this, file, fileID]() {
+                PrepareParserThread();
+                ParsedFile result;
+                auto content = ReadFileContent(file, result.failedReason);
                 if (!content.has_value()) {
-                    s.ci->diag.DiagnoseRefactor(
-                        DiagKindRefactor::module_read_file_to_buffer_failed, DEFAULT_POSITION, file, failedReason);
-                    success = false;
-                    return;
-                }
-                const unsigned int fileID = s.ci->GetSourceManager().AddSource(file | IdenticalFunc, content.value());
-                if (s.fileIds.count(fileID) > 0) {
-                    (void)s.ci->diag.DiagnoseRefactor(
-                        DiagKindRefactor::module_read_file_conflicted, DEFAULT_POSITION, file);
-                    return;
+                    result.path = file;
+                    return result;
                 }
-
-                (void)s.fileIds.insert(fileID);
-                fileInfoQueue.emplace(std::move(content.value()), fileID);
-            });
+                s.ci->GetSourceManager().SetSourceBuffer(fileID, std::move(content.value()));
+                return ParseFile(fileID);
+            }));
         }
+        return pending;
+    }
 
-        auto package = MultiThreadParseOnePackage(fileInfoQueue, defaultPackageName);
+    /** Wait for the files of @p pending and assemble them into a package. */
+    OwnedPtr<Package> CollectParsedPackage(PendingPackage& pending, bool& success)
+    {
+        auto package = GetMultiThreadParseOnePackage(pending.files, pending.defaultPackageName, success);
         s.ci->diag.EmitCategoryGroup();
         std::sort(package->files.begin(), package->files.end(),
             [](const OwnedPtr<File>& fileOne, const OwnedPtr<File>& fileTwo) {
@@ -342,6 +374,15 @@ public:
             });
         return package;
     }
+
+    OwnedPtr<Package> ParseOnePackage(
+        const std::vector<std::string>& files, bool& success, const std::string& defaultPackageName)
+    {
+        TaskQueue parseQueue(s.ci->invocation.globalOptions.GetJobs());
+        auto pending = ScheduleParseOnePackage(files, defaultPackageName, parseQueue);
+        parseQueue.RunAndWaitForAllTasksCompleted();
+        return CollectParsedPackage(pending, success);
+    }
     FullCompileStrategy& s;
 };
 } // namespace Cangjie
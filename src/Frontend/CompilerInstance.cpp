@@ -18,6 +18,7 @@
 
 #include "PrintSymbolTable.h"
 
+#include "cangjie/AST/NodeAllocator.h"
 #include "cangjie/Basic/DiagnosticEngine.h"
 #include "cangjie/Basic/Match.h"
 #include "cangjie/Basic/Print.h"
@@ -103,6 +104,9 @@ CompilerInstance::~CompilerInstance()
     gim = nullptr;
     delete packageManager;
     packageManager = nullptr;
+    // Return the slabs of the freed AST to the system, the nodes freed with the remaining members are reused by the
+    // next compilation or returned by its trim.
+    (void)AST::NodeAllocator::Trim();
 }
 
 bool CompilerInstance::InitCompilerInstance()
@@ -714,9 +718,10 @@ void DoMangling(const BaseMangler& baseMangler, size_t parallelNum, const std::v
         }
         // Concurrent processing of grouped decls
         taskQueue.RunInBackground();
+        // The remaining decls are mangled by the current thread while the pool works on the batches.
+        DoNewMangling(baseMangler, topDecls, start, topDecls.size());
         // Wait until all mangle tasks are complete.
         taskQueue.WaitForAllTasksCompleted();
-        DoNewMangling(baseMangler, topDecls, start, topDecls.size());
     }
 }
 
@@ -1247,4 +1252,14 @@ const CHIR::AnalysisWrapper<CHIR::ConstAnalysis, CHIR::ConstDomain>& CHIRData::G
 {
     return constAnalysisWrapper;
 }
+
+void CHIRData::SetPGOProfile(std::unique_ptr<CHIR::PGOProfile> profile)
+{
+    pgoProfile = std::move(profile);
+}
+
+const CHIR::PGOProfile* CHIRData::GetPGOProfile() const
+{
+    return pgoProfile.get();
+}
 #endif
@@ -16,9 +16,16 @@
 
 #include "llvm/Bitcode/BitcodeWriter.h"
 #include "llvm/IR/Verifier.h"
+#ifdef CANGJIE_CODEGEN_CJNATIVE_BACKEND
+#include "llvm/ProfileData/InstrProfReader.h"
+#include "llvm/ProfileData/ProfileCommon.h"
+#endif
 
 #include "cangjie/Basic/StringConvertor.h"
 #include "cangjie/CodeGen/EmitPackageIR.h"
+#ifdef CANGJIE_CODEGEN_CJNATIVE_BACKEND
+#include "cangjie/CodeGen/InProcessBackend.h"
+#endif
 #include "cangjie/Driver/StdlibMap.h"
 #include "cangjie/Driver/TempFileManager.h"
 #include "cangjie/Modules/PackageManager.h"
@@ -33,6 +40,57 @@
 using namespace Cangjie;
 using namespace AST;
 
+#ifdef CANGJIE_CODEGEN_CJNATIVE_BACKEND
+namespace {
+bool StoreInObjectCache(
+    CodeGen::ObjectCacheSession& objectCache, const CodeGen::ObjectCacheSession::Entry& entry, const std::string& path)
+{
+    std::string metadata;
+    for (auto& symbol : entry.localizedSymbols) {
+        metadata += symbol + "\n";
+    }
+    return objectCache.cache.Store(entry.key, path, metadata);
+}
+
+/// Read the function counts and indirect call targets of the `--pgo-instr-use` profile for CHIR optimizations.
+std::unique_ptr<CHIR::PGOProfile> ReadPGOProfile(const std::string& path, DiagnosticEngine& diag)
+{
+    auto readerOrErr = llvm::IndexedInstrProfReader::create(path);
+    if (auto err = readerOrErr.takeError()) {
+        diag.DiagnoseRefactor(
+            DiagKindRefactor::driver_pgo_profile_read_failed, DEFAULT_POSITION, path, llvm::toString(std::move(err)));
+        return nullptr;
+    }
+    auto& reader = *readerOrErr;
+    auto profile = std::make_unique<CHIR::PGOProfile>();
+    for (const auto& record : *reader) {
+        CHIR::PGOProfile::FuncProfile funcProfile;
+        for (auto count : record.Counts) {
+            funcProfile.maxCount = std::max(funcProfile.maxCount, count);
+        }
+        for (uint32_t site = 0; site < record.getNumValueSites(llvm::IPVK_IndirectCallTarget); ++site) {
+            auto valueData = record.getValueForSite(llvm::IPVK_IndirectCallTarget, site);
+            for (uint32_t i = 0; i < record.getNumValueDataForSite(llvm::IPVK_IndirectCallTarget, site); ++i) {
+                auto target = reader->getSymtab().getFuncName(valueData[i].Value);
+                if (!target.empty()) {
+                    funcProfile.callTargets[target.str()] += valueData[i].Count;
+                }
+            }
+        }
+        profile->AddFuncProfile(record.Name.str(), funcProfile);
+    }
+    if (reader->hasError()) {
+        diag.DiagnoseRefactor(DiagKindRefactor::driver_pgo_profile_read_failed, DEFAULT_POSITION, path,
+            llvm::toString(reader->getError()));
+        return nullptr;
+    }
+    profile->SetHotCountThreshold(
+        llvm::ProfileSummaryBuilder::getHotCountThreshold(reader->getSummary(false).getDetailedSummary()));
+    return profile;
+}
+} // namespace
+#endif
+
 namespace Cangjie {
 class DefaultCIImpl final {
 public:
@@ -54,6 +112,7 @@ private:
 
     bool EmitLLVMSimilarBytecode(AST::Package& pkg, bool enableIncrement);
 #ifdef CANGJIE_CODEGEN_CJNATIVE_BACKEND
+    bool EmitObjectFilesInProcess(const AST::Package& pkg, CodeGen::ObjectCacheSession* objectCache);
     void SaveBchir([[maybe_unused]] const AST::Package& pkg) const
     {
     }
@@ -131,6 +190,12 @@ bool DefaultCompilerInstance::PerformGenericInstantiation()
 bool DefaultCompilerInstance::PerformCHIRCompilation()
 {
     Utils::ProfileRecorder recorder("Main Stage", "CHIR");
+#ifdef CANGJIE_CODEGEN_CJNATIVE_BACKEND
+    auto& opts = invocation.globalOptions;
+    if (opts.enablePgoInstrUse && !opts.pgoProfileFile.empty()) {
+        chirData.SetPGOProfile(ReadPGOProfile(opts.pgoProfileFile, diag));
+    }
+#endif
     return CompilerInstance::PerformCHIRCompilation();
 }
 
@@ -156,6 +221,7 @@ std::string DefaultCIImpl::GenerateBCFilePathAndUpdateToInvocation(
 {
     std::string fileName = GenerateFileName(pkgName, idx);
     TempFileInfo bcFileInfo = TempFileManager::Instance().CreateNewFileInfo(TempFileInfo{fileName, "", "", true}, kind);
+    bcFileInfo.isObject = kind == TempFileKind::T_OBJ;
     ci.invocation.globalOptions.frontendOutputFiles.emplace_back(bcFileInfo);
 
     auto bcFilePath = bcFileInfo.filePath;
@@ -247,11 +313,31 @@ bool DefaultCIImpl::CodegenOnePackage(Package& pkg, bool enableIncrement)
 #ifdef CANGJIE_CODEGEN_CJNATIVE_BACKEND
 bool DefaultCIImpl::EmitLLVMSimilarBytecode(Package& pkg, bool enableIncrement)
 {
+    auto& options = ci.invocation.globalOptions;
+    // Object files can only be emitted in process if the driver allows it.
+    bool inProcessBackend =
+        !options.inProcessBackendArgs.empty() && CodeGen::InitInProcessBackend(options.inProcessBackendArgs);
+    // The object cache skips the generation of IR, so it is not used if IR is requested. Incremental compilation
+    // keeps its own cache of the generated IR.
+    std::optional<Utils::PersistentCache> objectCache;
+    std::optional<CodeGen::ObjectCacheSession> objectCacheSession;
+    if (inProcessBackend && !options.objectCacheDir.empty() && !enableIncrement && !options.NeedDumpIRToFile() &&
+        !options.NeedDumpIRToScreen()) {
+        objectCache.emplace(options.objectCacheDir, options.objectCacheSize);
+        objectCacheSession.emplace(*objectCache);
+    }
+
     // 1. translate CHIR to LLVM IR
     CHIR::CHIRBuilder builder(ci.chirData.GetCHIRContext());
-    llvmModules = CodeGen::GenPackageModules(builder, ci.chirData, ci.invocation.globalOptions, ci, enableIncrement);
+    auto session = objectCacheSession ? &objectCacheSession.value() : nullptr;
+    llvmModules = CodeGen::GenPackageModules(builder, ci.chirData, options, ci, enableIncrement, session);
+
+    // 2. optimize LLVM IR and emit object files in process
+    if (inProcessBackend) {
+        return EmitObjectFilesInProcess(pkg, session);
+    }
 
-    // 2. save LLVM IR to bc file
+    // 3. otherwise save LLVM IR to bc file
     Utils::ProfileRecorder recorder("CodeGen", "Save bc file");
     ci.invocation.globalOptions.UpdateCachedDirName(pkg.fullPackageName);
     if (llvmModules.size() == 1) {
@@ -286,6 +372,70 @@ bool DefaultCIImpl::EmitLLVMSimilarBytecode(Package& pkg, bool enableIncrement)
     }
     return true;
 }
+
+bool DefaultCIImpl::EmitObjectFilesInProcess(const Package& pkg, CodeGen::ObjectCacheSession* objectCache)
+{
+    Utils::ProfileRecorder recorder("CodeGen", "Emit object file");
+    ci.invocation.globalOptions.UpdateCachedDirName(pkg.fullPackageName);
+    // Every sub-module keeps its own object file, generated or taken from the object cache, so the order of the
+    // object files passed to the linker does not depend on which sub-modules are cached.
+    size_t objFileNum = llvmModules.size() + (objectCache ? objectCache->reused.size() : 0);
+    std::vector<std::string> objFilePaths;
+    for (size_t i = 0; i < objFileNum; ++i) {
+        auto filePath = GenerateBCFilePathAndUpdateToInvocation(
+            TempFileKind::T_OBJ, pkg.fullPackageName, objFileNum == 1 ? "" : std::to_string(i));
+        if (filePath.empty()) {
+            return false;
+        }
+        objFilePaths.emplace_back(filePath);
+    }
+    std::vector<size_t> moduleIndexes(llvmModules.size());
+    for (size_t i = 0; i < llvmModules.size(); ++i) {
+        moduleIndexes[i] = objectCache ? objectCache->generated[i].index : i;
+    }
+    if (objectCache) {
+        for (auto& entry : objectCache->reused) {
+            if (!FileUtil::WriteBufferToASTFile(objFilePaths[entry.index], entry.object)) {
+                Errorln("Failed to write the object file " + objFilePaths[entry.index]);
+                return false;
+            }
+        }
+    }
+    // Optimization changes the LLVM context, so modules sharing a context are compiled one after another.
+    std::unordered_map<llvm::LLVMContext*, std::vector<size_t>> modulesOfContext;
+    std::vector<llvm::LLVMContext*> contexts;
+    for (size_t i = 0; i < llvmModules.size(); ++i) {
+        auto& modules = modulesOfContext[&llvmModules[i]->getContext()];
+        if (modules.empty()) {
+            contexts.emplace_back(&llvmModules[i]->getContext());
+        }
+        modules.emplace_back(i);
+    }
+    Utils::TaskQueue taskQueueEmitObject(ci.invocation.globalOptions.GetJobs());
+    std::vector<Utils::TaskResult<bool>> results;
+    for (auto context : contexts) {
+        auto& modules = modulesOfContext[context];
+        results.emplace_back(
+            taskQueueEmitObject.AddTask<bool>([this, &modules, &objFilePaths, &moduleIndexes, objectCache]() {
+                bool success = true;
+                for (auto i : modules) {
+                    auto& objFilePath = objFilePaths[moduleIndexes[i]];
+                    if (!CodeGen::EmitObjectFile(*llvmModules[i], objFilePath)) {
+                        success = false;
+                    } else if (objectCache) {
+                        // The object cache is only an optimization, failing to store an entry is not an error.
+                        (void)StoreInObjectCache(*objectCache, objectCache->generated[i], objFilePath);
+                    }
+                }
+                return success;
+            }));
+    }
+    taskQueueEmitObject.RunAndWaitForAllTasksCompleted();
+    if (objectCache) {
+        objectCache->cache.Trim();
+    }
+    return std::all_of(results.begin(), results.end(), [](auto& result) { return result.get(); });
+}
 #endif
 
 bool DefaultCompilerInstance::PerformMangling()
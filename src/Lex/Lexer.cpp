@@ -13,6 +13,7 @@
  */
 
 #include "LexerImpl.h"
+#include "ScanKernels.h"
 
 #include <cstdlib>
 #include <string>
@@ -289,11 +290,11 @@ void LexerImpl::ReadUTF8CharFromMultiBytes(int32_t& ch)
     }
 }
 
-TokenKind LexerImpl::LookupKeyword(const std::string& literal)
+TokenKind LexerImpl::LookupKeyword(std::string_view literal) const
 {
-    if (LexerImpl::tokenMap.count(literal) != 0) {
+    if (auto it = tokenMap.find(literal); it != tokenMap.end()) {
         // keyword
-        return LexerImpl::tokenMap[literal];
+        return it->second;
     }
 
     // identifier
@@ -1027,6 +1028,7 @@ std::pair<Token, bool> LexerImpl::ScanStringOrJString(const char* pStart, bool n
     }
     auto quote = currentChar;
     for (;;) {
+        pNext = ScanKernels::SkipPlainASCII(pNext, pInputEnd, static_cast<char>(quote), '\\', '$');
         ReadUTF8Char();
         if (currentChar == quote) {
             stringParts.emplace_back(StringPart::STR, std::string(begin, pCurrent), beginPos, GetPos(pCurrent));
@@ -1220,6 +1222,7 @@ std::pair<Token, bool> LexerImpl::ScanMultiLineString(const char* pStart, bool n
     const char* begin = pStart + multiStringBeginOffset;
     Position beginPos = GetPos(begin);
     for (;;) {
+        pNext = ScanKernels::SkipPlainASCII(pNext, pInputEnd, static_cast<char>(quote), '\\', '$');
         ReadUTF8Char();
         if (currentChar == '\\') {
             ProcessEscape(pStart, true, false);
@@ -1355,6 +1358,7 @@ std::pair<Token, bool> LexerImpl::ScanMultiLineComment(const char* pStart, bool
 {
     size_t level = 1;
     while ((currentChar != -1) && (level > 0)) {
+        pNext = ScanKernels::SkipPlainASCII(pNext, pInputEnd, '*', '/');
         ReadUTF8Char();
         if (IsCurrentCharLineTerminator()) {
             if (success && !allowNewLine) {
@@ -1387,6 +1391,7 @@ std::pair<Token, bool> LexerImpl::ScanComment(const char* pStart, bool allowNewL
         return ScanMultiLineComment(pStart, allowNewLine);
     } else {
         while ((currentChar != -1) && !IsCurrentCharLineTerminator()) {
+            pNext = ScanKernels::SkipPlainASCII(pNext, pInputEnd);
             ReadUTF8Char();
         }
         if (IsCurrentCharLineTerminator()) {
@@ -1677,13 +1682,13 @@ void LexerImpl::ScanSymbolColon()
 
 Token LexerImpl::GetSymbolToken(const char* pStart)
 {
-    TokenKind kind = LookupKeyword(std::string(pStart, pNext));
+    TokenKind kind = LookupKeyword(std::string_view(pStart, static_cast<size_t>(pNext - pStart)));
     if (kind == TokenKind::IDENTIFIER) {
         if (success) {
             DiagUnknownStartOfToken(GetPos(pStart));
             success = false;
         }
-        return Token(TokenKind::ILLEGAL, std::string(pStart, pNext), pos, GetPos(pNext));
+        kind = TokenKind::ILLEGAL;
     }
     return Token(kind, std::string(pStart, pNext), pos, GetPos(pNext));
 }
@@ -1957,18 +1962,18 @@ void LexerImpl::Reset()
 
 Token LexerImpl::Next()
 {
-    Token token{TokenKind::SENTINEL, "", Position(0, 1, 1), Position{0, 1, 1}};
     if (lookAheadCache.empty()) {
-        token = Scan();
-    } else {
-        token = lookAheadCache.front();
-        lookAheadCache.pop_front();
+        Token token = Scan();
+        CollectToken(token);
+        return token;
     }
+    Token token = std::move(lookAheadCache.front());
+    lookAheadCache.pop_front();
     CollectToken(token);
     return token;
 }
 
-const std::list<Token>& LexerImpl::LookAhead(size_t num)
+const std::deque<Token>& LexerImpl::LookAhead(size_t num)
 {
     if (num <= lookAheadCache.size()) {
         return lookAheadCache;
@@ -2045,9 +2050,10 @@ bool LexerImpl::Seeing(const std::vector<TokenKind>& kinds, bool skipNewline, bo
     return Seeing(kinds.begin(), kinds.end(), skipNewline, skipComments);
 }
 
-std::list<Token> LexerImpl::LookAheadSkipNL(size_t num)
+std::vector<Token> LexerImpl::LookAheadSkipNL(size_t num)
 {
-    std::list<Token> ret;
+    std::vector<Token> ret;
+    ret.reserve(num);
     for (const Token& token : lookAheadCache) {
         if (token.kind != TokenKind::NL) {
             ret.push_back(token);
@@ -2137,7 +2143,7 @@ inline void LexerImpl::CheckIllegalUTF8InStringLiteral(uint32_t byte)
 std::size_t LexerImpl::GetCurrentToken() const
 {
     auto tokenNumber = this->curToken;
-    for (auto token : this->lookAheadCache) {
+    for (auto& token : this->lookAheadCache) {
         if (token.kind != TokenKind::SENTINEL && token.kind != TokenKind::ILLEGAL && token.kind != TokenKind::END) {
             tokenNumber--;
         }
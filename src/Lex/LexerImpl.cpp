@@ -20,7 +20,7 @@ Token Lexer::Next()
     return impl->Next();
 }
 
-const std::list<Token>& Lexer::LookAhead(size_t num)
+const std::deque<Token>& Lexer::LookAhead(size_t num)
 {
     return impl->LookAhead(num);
 }
@@ -34,7 +34,7 @@ bool Lexer::Seeing(const std::vector<TokenKind>& kinds, bool skipNewline, bool s
     return impl->Seeing(kinds, skipNewline, skipComments);
 }
 
-std::list<Token> Lexer::LookAheadSkipNL(size_t num)
+std::vector<Token> Lexer::LookAheadSkipNL(size_t num)
 {
     return impl->LookAheadSkipNL(num);
 }
@@ -88,13 +88,13 @@ public:
     void ReserveToken(size_t num, bool skipNewline, bool skipComments);
 
     // Parse/unittests.
-    const std::list<Token>& LookAhead(size_t num);
+    const std::deque<Token>& LookAhead(size_t num);
     bool Seeing(const std::vector<TokenKind>::const_iterator& begin, const std::vector<TokenKind>::const_iterator& end,
         bool skipNewline = false, bool skipComments = true);
     bool Seeing(const std::vector<TokenKind>& kinds, bool skipNewline = false, bool skipComments = true);
 
     // Parse.
-    std::list<Token> LookAheadSkipNL(size_t num);
+    std::vector<Token> LookAheadSkipNL(size_t num);
     std::vector<Token> comments; // All Comments.
     void EnableCollectTokenStream()
     {
@@ -181,8 +181,9 @@ private:
      *
      */
     std::vector<size_t> lineOffsetsFromBase{0};
-    std::list<Token> lookAheadCache;
-    std::list<Token> resetLookAheadCache;
+    // A deque keeps the scanned tokens in chunks, instead of allocating a node for each token as a list does.
+    std::deque<Token> lookAheadCache;
+    std::deque<Token> resetLookAheadCache;
     bool enableScan{true};
     std::vector<Token> tokens;
     size_t curToken{0};
@@ -212,7 +213,7 @@ private:
     bool ProcessDigits(const int& base, bool& hasDigit, const char* reasonPoint, bool* isFloat = nullptr);
     std::string GetSuffix(const char* pSuffixStart);
     void ProcessIntegerSuffix();
-    TokenKind LookupKeyword(const std::string& literal);
+    TokenKind LookupKeyword(std::string_view literal) const;
     void ProcessEscape(const char* pStart, bool isInString, bool isByteLiteral);
     void ProcessUnicodeEscape();
     Token ProcessIllegalToken(bool needStringParts, bool multiLine, const char* pStart, bool isJString = false);
@@ -0,0 +1,97 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+// The Cangjie API is in Beta. For details on its capabilities and limitations, please refer to the README file.
+
+/**
+ * @file
+ *
+ * This file declares the kernels the lexer uses to skip runs of plain ASCII characters in bulk.
+ */
+
+#ifndef CANGJIE_LEX_SCANKERNELS_H
+#define CANGJIE_LEX_SCANKERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CANGJIE_LEX_SCAN_SSE2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define CANGJIE_LEX_SCAN_NEON
+#endif
+
+namespace Cangjie::ScanKernels {
+constexpr size_t BLOCK_SIZE = 16;
+constexpr uint8_t FIRST_PRINTABLE = 0x20;
+constexpr uint8_t LAST_PRINTABLE = 0x7E;
+
+inline bool IsStop(uint8_t c, char stop1, char stop2, char stop3)
+{
+    return c < FIRST_PRINTABLE || c > LAST_PRINTABLE || c == static_cast<uint8_t>(stop1) ||
+        c == static_cast<uint8_t>(stop2) || c == static_cast<uint8_t>(stop3);
+}
+
+/**
+ * Returns the first position in [@p p, @p end) whose byte is not printable ASCII or equals one of the stop
+ * characters, or @p end if there is none. The skipped bytes are neither line terminators, nor tabs, nor parts of
+ * multi-byte UTF-8 characters, so the caller may move past them without registering line offsets or checking the
+ * encoding. Unused stop characters are passed as '\0', which is never printable.
+ */
+inline const char* SkipPlainASCII(const char* p, const char* end, char stop1 = '\0', char stop2 = '\0',
+    char stop3 = '\0')
+{
+#if defined(CANGJIE_LEX_SCAN_SSE2)
+    // Bytes from 0x80 are negative as signed chars, so one signed comparison finds them and the control characters.
+    const __m128i firstPrintable = _mm_set1_epi8(static_cast<char>(FIRST_PRINTABLE));
+    const __m128i lastPrintable = _mm_set1_epi8(static_cast<char>(LAST_PRINTABLE));
+    const __m128i s1 = _mm_set1_epi8(stop1);
+    const __m128i s2 = _mm_set1_epi8(stop2);
+    const __m128i s3 = _mm_set1_epi8(stop3);
+    while (static_cast<size_t>(end - p) >= BLOCK_SIZE) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i stops = _mm_or_si128(_mm_cmplt_epi8(v, firstPrintable), _mm_cmpgt_epi8(v, lastPrintable));
+        stops = _mm_or_si128(stops, _mm_or_si128(_mm_cmpeq_epi8(v, s1), _mm_cmpeq_epi8(v, s2)));
+        stops = _mm_or_si128(stops, _mm_cmpeq_epi8(v, s3));
+        auto mask = static_cast<unsigned>(_mm_movemask_epi8(stops));
+        if (mask != 0) {
+#if defined(_MSC_VER) && !defined(__clang__)
+            unsigned long index;
+            _BitScanForward(&index, mask);
+            return p + index;
+#else
+            return p + __builtin_ctz(mask);
+#endif
+        }
+        p += BLOCK_SIZE;
+    }
+#elif defined(CANGJIE_LEX_SCAN_NEON)
+    const uint8x16_t firstPrintable = vdupq_n_u8(FIRST_PRINTABLE);
+    const uint8x16_t lastPrintable = vdupq_n_u8(LAST_PRINTABLE);
+    const uint8x16_t s1 = vdupq_n_u8(static_cast<uint8_t>(stop1));
+    const uint8x16_t s2 = vdupq_n_u8(static_cast<uint8_t>(stop2));
+    const uint8x16_t s3 = vdupq_n_u8(static_cast<uint8_t>(stop3));
+    while (static_cast<size_t>(end - p) >= BLOCK_SIZE) {
+        uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t*>(p));
+        uint8x16_t stops = vorrq_u8(vcltq_u8(v, firstPrintable), vcgtq_u8(v, lastPrintable));
+        stops = vorrq_u8(stops, vorrq_u8(vceqq_u8(v, s1), vceqq_u8(v, s2)));
+        stops = vorrq_u8(stops, vceqq_u8(v, s3));
+        if (vmaxvq_u8(stops) != 0) {
+            break; // The scalar loop below finds the stop within this block.
+        }
+        p += BLOCK_SIZE;
+    }
+#endif
+    while (p < end && !IsStop(static_cast<uint8_t>(*p), stop1, stop2, stop3)) {
+        ++p;
+    }
+    return p;
+}
+} // namespace Cangjie::ScanKernels
+
+#endif // CANGJIE_LEX_SCANKERNELS_H
@@ -152,6 +152,13 @@ void SetOuterDeclForMemberDecl(Decl& member, Decl& parentDecl)
 
 ASTLoader::ASTLoader(std::vector<uint8_t>&& data, const std::string& fullPackageName, TypeManager& typeManager,
     const CjoManager& cjoManager, const GlobalOptions& opts)
+{
+    pImpl = MakeOwned<ASTLoaderImpl>(
+        Utils::ReadOnlyBuffer::FromVector(std::move(data)), fullPackageName, typeManager, cjoManager, opts);
+}
+
+ASTLoader::ASTLoader(std::shared_ptr<const Utils::ReadOnlyBuffer> data, const std::string& fullPackageName,
+    TypeManager& typeManager, const CjoManager& cjoManager, const GlobalOptions& opts)
 {
     pImpl = MakeOwned<ASTLoaderImpl>(std::move(data), fullPackageName, typeManager, cjoManager, opts);
 }
@@ -179,7 +186,7 @@ std::string ASTLoader::PreReadAndSetPackageName()
 std::string ASTLoader::ASTLoaderImpl::PreReadAndSetPackageName()
 {
     if (!package) {
-        package = PackageFormat::GetPackage(data.data());
+        package = PackageFormat::GetPackage(data->Data());
     }
     CJC_NULLPTR_CHECK(package);
     CJC_NULLPTR_CHECK(package->fullPkgName());
@@ -214,9 +221,9 @@ const std::vector<std::string> ASTLoader::GetDependentPackageNames() const
 
 bool ASTLoader::ASTLoaderImpl::VerifyForData(const std::string& id)
 {
-    size_t size = data.size();
+    size_t size = data->Size();
     // We need to verify the size first.
-    flatbuffers::Verifier verifier(data.data(), size, FB_MAX_DEPTH, FB_MAX_TABLES);
+    flatbuffers::Verifier verifier(data->Data(), size, FB_MAX_DEPTH, FB_MAX_TABLES);
     if (!PackageFormat::VerifyPackageBuffer(verifier)) {
         diag.DiagnoseRefactor(
             DiagKindRefactor::module_loaded_ast_failed, DEFAULT_POSITION, id, importedPackageName, CANGJIE_VERSION);
@@ -236,7 +243,7 @@ std::string ASTLoader::ASTLoaderImpl::LoadPackageDepInfo()
     if (!VerifyForData("ast")) {
         return "";
     }
-    package = PackageFormat::GetPackage(data.data());
+    package = PackageFormat::GetPackage(data->Data());
     return package->pkgDepInfo()->str();
 }
 
@@ -303,7 +310,7 @@ void ASTLoader::ASTLoaderImpl::PreloadCommonPartOfPackage(AST::Package& pkg)
         CJC_ABORT();
     }
 
-    package = PackageFormat::GetPackage(data.data());
+    package = PackageFormat::GetPackage(data->Data());
     CJC_NULLPTR_CHECK(package);
 
     curPackage = &pkg; // Deserialize common part AST into current platform package AST
@@ -407,7 +414,7 @@ OwnedPtr<AST::File> ASTLoader::ASTLoaderImpl::CreateFileNode(
 OwnedPtr<AST::Package> ASTLoader::ASTLoaderImpl::PreLoadImportedPackageNode()
 {
     // Begin to parse the flatbuffer.
-    package = PackageFormat::GetPackage(data.data());
+    package = PackageFormat::GetPackage(data->Data());
     CJC_NULLPTR_CHECK(package);
     // Imported package is PackageDecl Node.
     OwnedPtr<Package> packageNode = MakeOwned<Package>();
@@ -26,8 +26,8 @@
 namespace Cangjie {
 class ASTLoader::ASTLoaderImpl {
 public:
-    ASTLoaderImpl(std::vector<uint8_t>&& data, const std::string& fullPackageName, TypeManager& typeManager,
-        const CjoManager& cjoManager, const GlobalOptions& opts)
+    ASTLoaderImpl(std::shared_ptr<const Utils::ReadOnlyBuffer> data, const std::string& fullPackageName,
+        TypeManager& typeManager, const CjoManager& cjoManager, const GlobalOptions& opts)
         : importedPackageName(fullPackageName),
           data(std::move(data)),
           typeManager(typeManager),
@@ -66,7 +66,8 @@ public:
 
 private:
 friend ASTLoader;
-    std::vector<uint8_t> data;
+    /** Serialized package, read in place and shared with other loaders of the same unchanged file. Never null. */
+    std::shared_ptr<const Utils::ReadOnlyBuffer> data;
     TypeManager& typeManager;
     DiagnosticEngine& diag;
     SourceManager& sourceManager;
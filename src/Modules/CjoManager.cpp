@@ -22,6 +22,7 @@
 #include "cangjie/AST/Walker.h"
 #include "cangjie/Modules/ASTSerialization.h"
 #include "cangjie/Modules/ModulesUtils.h"
+#include "cangjie/Modules/SharedCjoCache.h"
 
 using namespace Cangjie;
 using namespace AST;
@@ -429,17 +430,21 @@ Ptr<ASTLoader> CjoManagerImpl::GetCommonPartCjo(std::string expectedName)
 OwnedPtr<ASTLoader> CjoManagerImpl::ReadCjo(
     const std::string& fullPackageName, const std::string& cjoPath, const CjoManager& cjoManager, bool printErr) const
 {
-    std::vector<uint8_t> buffer;
+    SharedCjoCache::Buffer buffer;
     if (auto found = cjoFileCacheMap.find(fullPackageName); found != cjoFileCacheMap.end()) {
         buffer = found->second;
     } else {
+        // Loaders of the same unchanged file share its contents.
         std::string failedReason;
-        FileUtil::ReadBinaryFileToBuffer(cjoPath, buffer, failedReason);
+        buffer = SharedCjoCache::Get().Load(cjoPath, failedReason);
         if (printErr && !failedReason.empty()) {
             diag.DiagnoseRefactor(
                 DiagKindRefactor::module_read_file_to_buffer_failed, DEFAULT_POSITION, cjoPath, failedReason);
             return nullptr;
         }
+        if (!buffer) {
+            buffer = Utils::ReadOnlyBuffer::FromVector({});
+        }
     }
     auto loader = MakeOwned<ASTLoader>(std::move(buffer), fullPackageName, typeManager, cjoManager, globalOptions);
     loader->SetImportSourceCode(importSrcCode);
@@ -16,6 +16,7 @@
 #define CANGJIE_MODULES_CJO_MANAGERIMPL_H
 
 #include "cangjie/Modules/CjoManager.h"
+#include "cangjie/Utils/ReadOnlyBuffer.h"
 
 namespace Cangjie {
 class CjoManagerImpl {
@@ -101,9 +102,10 @@ public:
         if (fullPackageName.empty() || cjoData.empty()) {
             return;
         }
-        cjoFileCacheMap[fullPackageName] = cjoData;
+        // Copied once here, then shared by every loader created for this package.
+        cjoFileCacheMap[fullPackageName] = Utils::ReadOnlyBuffer::FromVector(std::vector<uint8_t>(cjoData));
     }
-    std::unordered_map<std::string, std::vector<uint8_t>>& GetCjoFileCacheMap()
+    std::unordered_map<std::string, std::shared_ptr<const Utils::ReadOnlyBuffer>>& GetCjoFileCacheMap()
     {
         return cjoFileCacheMap;
     }
@@ -162,7 +164,7 @@ private:
     /** Only used to hold ownership of imported packages. */
     std::vector<OwnedPtr<AST::Package>> importedPackages;
     std::unordered_map<std::string, OwnedPtr<CjoManagerImpl::PackageInfo>> packageNameMap;
-    std::unordered_map<std::string, std::vector<uint8_t>> cjoFileCacheMap;
+    std::unordered_map<std::string, std::shared_ptr<const Utils::ReadOnlyBuffer>> cjoFileCacheMap;
     std::unordered_map<Ptr<const AST::ImportSpec>, std::pair<std::string, bool>> importedPackageNameMap;
     // Searching cache.
     std::unordered_set<std::string> visitedPkgs;
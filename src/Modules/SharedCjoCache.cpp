@@ -0,0 +1,79 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+// The Cangjie API is in Beta. For details on its capabilities and limitations, please refer to the README file.
+
+/**
+ * @file
+ *
+ * This file implements class SharedCjoCache.
+ */
+
+#include "cangjie/Modules/SharedCjoCache.h"
+
+#include <sys/stat.h>
+
+#include "cangjie/Utils/FileUtil.h"
+
+using namespace Cangjie;
+
+namespace {
+constexpr int64_t NANOSECONDS_PER_SECOND = 1000000000;
+} // namespace
+
+SharedCjoCache& SharedCjoCache::Get()
+{
+    static SharedCjoCache cache;
+    return cache;
+}
+
+std::optional<SharedCjoCache::FileStamp> SharedCjoCache::GetFileStamp(const std::string& path)
+{
+    struct stat st {};
+    if (stat(path.c_str(), &st) != 0) {
+        return std::nullopt;
+    }
+    FileStamp stamp;
+#if defined(__APPLE__)
+    stamp.mtime = static_cast<int64_t>(st.st_mtimespec.tv_sec) * NANOSECONDS_PER_SECOND + st.st_mtimespec.tv_nsec;
+#elif defined(_WIN32)
+    stamp.mtime = static_cast<int64_t>(st.st_mtime) * NANOSECONDS_PER_SECOND;
+#else
+    stamp.mtime = static_cast<int64_t>(st.st_mtim.tv_sec) * NANOSECONDS_PER_SECOND + st.st_mtim.tv_nsec;
+#endif
+    stamp.size = static_cast<uint64_t>(st.st_size);
+    return stamp;
+}
+
+SharedCjoCache::Buffer SharedCjoCache::Load(const std::string& cjoPath, std::string& failedReason)
+{
+    failedReason.clear();
+    auto absPath = FileUtil::GetAbsPath(cjoPath);
+    auto stamp = absPath ? GetFileStamp(*absPath) : std::nullopt;
+    if (!stamp) {
+        failedReason = "open file failed";
+        return nullptr;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (auto found = entries.find(*absPath); found != entries.end()) {
+            if (found->second.stamp == *stamp) {
+                if (auto buffer = found->second.buffer.lock()) {
+                    return buffer;
+                }
+            }
+            entries.erase(found);
+        }
+    }
+    // Map outside the lock, so that different files can be loaded concurrently.
+    auto data = Utils::ReadOnlyBuffer::FromFile(*absPath, failedReason);
+    if (!data) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(mtx);
+    entries.insert_or_assign(*absPath, Entry{*stamp, data});
+    return data;
+}
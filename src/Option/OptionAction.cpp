@@ -483,6 +483,20 @@ bool ParseAPCJobs(GlobalOptions& opts, const OptionArgInstance& arg)
     opts.aggressiveParallelCompile = jobsValue;
     return true;
 }
+
+bool ParseObjectCacheSize(GlobalOptions& opts, const OptionArgInstance& arg)
+{
+    // The size is given in MiB, up to 9 digits to avoid overflow.
+    constexpr std::size_t maxLen = 9;
+    if (arg.value.empty() || arg.value.find_first_not_of("0123456789") != std::string::npos ||
+        arg.value.length() > maxLen) {
+        Errorf("'%s' only accepts a non-negative integer number as value.\n", arg.name.c_str());
+        return false;
+    }
+    constexpr uint64_t bytesPerMiB = 1024 * 1024;
+    opts.objectCacheSize = std::stoull(arg.value) * bytesPerMiB;
+    return true;
+}
 #endif
 
 bool IsEscaped(const std::string& str, size_t index)
@@ -893,6 +907,7 @@ std::unordered_map<Options::ID, std::function<bool(GlobalOptions&, OptionArgInst
         return true;
     }},
     { Options::ID::DEBUG_CODEGEN, OPTION_TRUE_ACTION(opts.codegenDebugMode = true) },
+    { Options::ID::IN_PROCESS_BACKEND, OPTION_TRUE_ACTION(opts.inProcessBackend = true) },
     { Options::ID::CHIR_OPT_DEBUG, OPTION_TRUE_ACTION(opts.chirDebugOptimizer = true) },
     { Options::ID::DUMP_AST, OPTION_TRUE_ACTION(opts.dumpAST = true)},
     { Options::ID::DUMP_CHIR, OPTION_TRUE_ACTION(opts.dumpCHIR = true)},
@@ -938,6 +953,10 @@ std::unordered_map<Options::ID, std::function<bool(GlobalOptions&, OptionArgInst
         OPTION_TRUE_ACTION(opts.selectedCHIROpts.insert(GlobalOptions::OptimizationFlag::FUNC_INLINING)) },
     { Options::ID::NO_FUNC_INLINING,
         OPTION_TRUE_ACTION(opts.selectedCHIROpts.erase(GlobalOptions::OptimizationFlag::FUNC_INLINING)) },
+    { Options::ID::CHIR_INLINE_REMARKS, [](GlobalOptions& opts, const OptionArgInstance& arg) {
+        opts.chirInlineRemarksFile = arg.value;
+        return true;
+    }},
     { Options::ID::DEVIRTUALIZATION,
         OPTION_TRUE_ACTION(opts.selectedCHIROpts.insert(GlobalOptions::OptimizationFlag::DEVIRTUALIZATION)) },
     { Options::ID::NO_DEVIRTUALIZATION,
@@ -1015,6 +1034,15 @@ std::unordered_map<Options::ID, std::function<bool(GlobalOptions&, OptionArgInst
     { Options::ID::DISCARD_EH_FRAME, OPTION_TRUE_ACTION(opts.discardEhFrame = true) },
     {Options::ID::JOBS, ParseJobs},
     {Options::ID::AGGRESSIVE_PARALLEL_COMPILE, ParseAPCJobs},
+    { Options::ID::OBJECT_CACHE_DIR, [](GlobalOptions& opts, const OptionArgInstance& arg) {
+        if (arg.value.empty()) {
+            Errorf("'%s' requires a non-empty value.\n", arg.name.c_str());
+            return false;
+        }
+        opts.objectCacheDir = arg.value;
+        return true;
+    }},
+    {Options::ID::OBJECT_CACHE_SIZE, ParseObjectCacheSize},
 #ifndef DISABLE_EFFECT_HANDLERS
     {Options::ID::ENABLE_EFFECTS, OPTION_TRUE_ACTION(opts.enableEH = true) },
 #endif
@@ -451,20 +451,31 @@ public:
         }
     }
 
+    /**
+     * Sub-patterns are immutable once destructed and shared by all copies of a pattern, so that copying a pattern
+     * while specializing pattern stacks does not copy the whole pattern tree.
+     */
+    using SubPatternList = std::shared_ptr<const std::vector<DestructedPattern>>;
+
     DestructedPattern(Constructor ctor, std::vector<DestructedPattern> subPatterns, Ty& goalTy, Ptr<Pattern> pattern)
-        : ctor_(std::move(ctor)), subPatterns_(std::move(subPatterns)), goalTy_(goalTy), pattern_(pattern)
+        : ctor_(std::move(ctor)),
+          subPatterns_(subPatterns.empty()
+                  ? nullptr
+                  : std::make_shared<const std::vector<DestructedPattern>>(std::move(subPatterns))),
+          goalTy_(goalTy),
+          pattern_(pattern)
     {
     }
 
     std::string ToString() const
     {
         if (ctor_.Kind() == ConstructorKind::TUPLE) {
-            return SubPatternsToString(subPatterns_);
+            return SubPatternsToString(SubPatterns());
         }
         if (ctor_.Kind() == ConstructorKind::ENUM) {
             if (ctor_.Arity() > 0) {
                 // Enum constructor with fields.
-                return ctor_.ToString() + SubPatternsToString(subPatterns_);
+                return ctor_.ToString() + SubPatternsToString(SubPatterns());
             }
             // Enum constructor without associated type.
             return ctor_.ToString();
@@ -520,7 +531,7 @@ public:
     {
         return ctor_.Kind() == ConstructorKind::WILDCARD ||
             (ctor_.Kind() == ConstructorKind::TUPLE &&
-                std::all_of(subPatterns_.cbegin(), subPatterns_.cend(),
+                std::all_of(SubPatterns().cbegin(), SubPatterns().cend(),
                     [](const DestructedPattern& subPattern) { return subPattern.AllWildcard(); }));
     }
 
@@ -529,10 +540,14 @@ public:
      *
      * @param otherCtor must Intersects() with the Head().
      */
-    std::vector<DestructedPattern> Specialize(const Constructor& otherCtor) const
+    SubPatternList Specialize(const Constructor& otherCtor) const
     {
         if (ctor_.Kind() == ConstructorKind::WILDCARD) {
-            return SpecializeWildcard(goalTy_, otherCtor);
+            auto subPatterns = SpecializeWildcard(goalTy_, otherCtor);
+            if (subPatterns.empty()) {
+                return nullptr;
+            }
+            return std::make_shared<const std::vector<DestructedPattern>>(std::move(subPatterns));
         }
         return subPatterns_;
     }
@@ -544,15 +559,16 @@ public:
 
     const std::vector<DestructedPattern>& SubPatterns() const
     {
-        return subPatterns_;
+        static const std::vector<DestructedPattern> noSubPatterns;
+        return subPatterns_ ? *subPatterns_ : noSubPatterns;
     }
 
-    AST::Ty& GoalTy()
+    AST::Ty& GoalTy() const
     {
         return goalTy_;
     }
 
-    Ptr<AST::Pattern> Node()
+    Ptr<AST::Pattern> Node() const
     {
         return pattern_;
     }
@@ -670,11 +686,16 @@ private:
     }
 
     Constructor ctor_;
-    std::vector<DestructedPattern> subPatterns_;
+    SubPatternList subPatterns_; // nullptr if there is no sub-pattern.
     Ty& goalTy_;
     Ptr<Pattern> pattern_;
 };
 
+/**
+ * A persistent stack of patterns: every stack derived by Specialize(), Apply() or ExpandOr() shares all items below
+ * the ones it replaces with the stack it is derived from. Deriving a stack costs O(arity) instead of copying every
+ * column, which makes large matches over nested tuples and enums with many constructors linear in the number of rows.
+ */
 class PatternStack {
 public:
     PatternStack()
@@ -682,38 +703,45 @@ public:
     }
     explicit PatternStack(const DestructedPattern& pattern)
     {
-        stack.emplace_back(pattern);
+        Push(pattern);
     }
 
     bool IsEmpty() const
     {
-        return stack.empty();
+        return top == nullptr;
     }
 
     bool AllWildcard() const
     {
-        return std::all_of(
-            stack.cbegin(), stack.cend(), [](const DestructedPattern& pattern) { return pattern.AllWildcard(); });
+        for (auto item = top.get(); item; item = item->below.get()) {
+            if (!item->pattern.AllWildcard()) {
+                return false;
+            }
+        }
+        return true;
     }
 
     size_t Size() const
     {
-        return stack.size();
+        return size;
     }
 
-    DestructedPattern& Head()
+    const DestructedPattern& Head() const
     {
-        return stack.back();
+        CJC_NULLPTR_CHECK(top);
+        return top->pattern;
     }
 
-    PatternStack Specialize(const Constructor& ctor)
+    PatternStack Specialize(const Constructor& ctor) const
     {
-        std::vector<DestructedPattern> newStack;
-        // Copies the `stack` except the head (the last element) to `newStack`.
-        std::copy(stack.cbegin(), stack.cend() - 1, std::back_inserter(newStack));
-        std::vector<DestructedPattern> headSubPatterns = Head().Specialize(ctor);
-        std::copy(headSubPatterns.crbegin(), headSubPatterns.crend(), std::back_inserter(newStack));
-        return PatternStack(std::move(newStack));
+        PatternStack newStack = Pop(1);
+        auto headSubPatterns = Head().Specialize(ctor);
+        if (headSubPatterns) {
+            // The first sub-pattern becomes the new head.
+            std::for_each(headSubPatterns->crbegin(), headSubPatterns->crend(),
+                [&newStack](const DestructedPattern& subPattern) { newStack.Push(subPattern); });
+        }
+        return newStack;
     }
 
     /**
@@ -724,13 +752,16 @@ public:
      */
     PatternStack Apply(const Constructor& ctor, Ty& ty) const
     {
-        std::vector<DestructedPattern> subPatterns;
         CJC_ASSERT(Size() >= ctor.Arity());
-        std::copy_n(stack.crbegin(), ctor.Arity(), std::back_inserter(subPatterns));
-        std::vector<DestructedPattern> newStack;
-        std::copy_n(stack.cbegin(), stack.size() - ctor.Arity(), std::back_inserter(newStack));
-        newStack.emplace_back(DestructedPattern(ctor, subPatterns, ty, nullptr));
-        return PatternStack(std::move(newStack));
+        std::vector<DestructedPattern> subPatterns;
+        subPatterns.reserve(ctor.Arity());
+        auto item = top.get();
+        for (size_t i = 0; i < ctor.Arity(); ++i, item = item->below.get()) {
+            subPatterns.emplace_back(item->pattern);
+        }
+        PatternStack newStack = Pop(ctor.Arity());
+        newStack.Push(DestructedPattern(ctor, std::move(subPatterns), ty, nullptr));
+        return newStack;
     }
 
     /**
@@ -742,27 +773,49 @@ public:
      *         [false, 1, 2, 3]
      *     ]
      */
-    std::vector<PatternStack> ExpandOr()
+    std::vector<PatternStack> ExpandOr() const
     {
-        CJC_ASSERT(!stack.empty());
+        CJC_ASSERT(!IsEmpty());
         CJC_ASSERT(Head().Ctor().Kind() == ConstructorKind::OR);
         std::vector<PatternStack> results;
+        results.reserve(Head().SubPatterns().size());
+        PatternStack rest = Pop(1);
         std::transform(Head().SubPatterns().cbegin(), Head().SubPatterns().cend(), std::back_inserter(results),
-            [this](const DestructedPattern& newHead) {
-                std::vector<DestructedPattern> newStack;
-                std::copy(this->stack.cbegin(), this->stack.cend() - 1, std::back_inserter(newStack));
-                newStack.emplace_back(newHead);
-                return PatternStack(std::move(newStack));
+            [&rest](const DestructedPattern& newHead) {
+                PatternStack newStack = rest;
+                newStack.Push(newHead);
+                return newStack;
             });
         return results;
     }
 
 private:
-    explicit PatternStack(std::vector<DestructedPattern>&& stack) : stack(stack)
+    struct Item {
+        DestructedPattern pattern;
+        std::shared_ptr<const Item> below;
+    };
+
+    void Push(const DestructedPattern& pattern)
     {
+        top = std::make_shared<const Item>(Item{pattern, std::move(top)});
+        ++size;
+    }
+
+    // Returns the stack without its top @p n items, which shares the remaining items with this stack.
+    PatternStack Pop(size_t n) const
+    {
+        CJC_ASSERT(size >= n);
+        PatternStack rest;
+        rest.top = top;
+        rest.size = size - n;
+        for (size_t i = 0; i < n; ++i) {
+            rest.top = rest.top->below;
+        }
+        return rest;
     }
 
-    std::vector<DestructedPattern> stack; // Stores `DestructedPattern`s reversely, i.e., the `Head()` is the last item.
+    std::shared_ptr<const Item> top; // The `Head()` of the stack.
+    size_t size = 0;
 };
 
 class Matrix {
@@ -784,7 +837,7 @@ public:
 
     bool HeadsAllWildcard()
     {
-        return std::all_of(rows.begin(), rows.end(), [](PatternStack& row) {
+        return std::all_of(rows.cbegin(), rows.cend(), [](const PatternStack& row) {
             if (row.IsEmpty()) {
                 return false;
             }
@@ -795,11 +848,11 @@ public:
     Matrix Specialize(TypeManager& typeManager, const Constructor& ctor)
     {
         Matrix newMatrix;
+        newMatrix.rows.reserve(rows.size());
         for (auto& row : rows) {
             CJC_ASSERT(!row.IsEmpty());
             if (ctor.IsCoveredBy(typeManager, row.Head().Ctor())) {
-                PatternStack newRow = row.Specialize(ctor);
-                newMatrix.rows.emplace_back(newRow);
+                newMatrix.rows.emplace_back(row.Specialize(ctor));
             }
         }
         return newMatrix;
@@ -826,7 +879,7 @@ public:
     {
     }
     UsefulnessChecker(DiagnosticEngine& diag, TypeManager& typeManager, Matrix&& matrix)
-        : diag(diag), typeManager_(typeManager), matrix_(matrix)
+        : diag(diag), typeManager_(typeManager), matrix_(std::move(matrix))
     {
     }
 
@@ -849,7 +902,7 @@ public:
             return {};
         }
         // Induction:
-        DestructedPattern& head = vec.Head();
+        const DestructedPattern& head = vec.Head();
         if (head.IsUnreachableTypePattern(typeManager_)) {
             return {};
         }
@@ -948,7 +1001,7 @@ private:
 
     std::vector<PatternStack> FindWitnessesForWildcard(PatternStack& vec)
     {
-        DestructedPattern& head = vec.Head();
+        const DestructedPattern& head = vec.Head();
         CJC_ASSERT(head.Ctor().Kind() == ConstructorKind::WILDCARD);
         if (matrix_.HeadsAllWildcard()) {
             // Avoid inspecting the sub-patterns if the matrix' heads are all wildcards.
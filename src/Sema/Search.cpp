@@ -21,6 +21,7 @@
 #include "cangjie/AST/ScopeManagerApi.h"
 #include "cangjie/AST/Searcher.h"
 #include "cangjie/AST/Symbol.h"
+#include "cangjie/Utils/TaskQueue.h"
 #include "cangjie/Utils/Utils.h"
 
 using namespace Cangjie;
@@ -41,16 +42,12 @@ void TypeChecker::TypeCheckerImpl::WarmupCache(const ASTContext& ctx) const
     if (numProcessors < numScopeNames) {
         return;
     }
-    std::unordered_map<std::string, std::vector<Symbol*>> cache;
-    std::vector<std::thread> threads(numScopeNames);
+    // The searchers are not thread-safe, so each task fills the cache of its own searcher.
     std::vector<std::unique_ptr<Searcher>> searchers(numScopeNames);
+    Utils::TaskQueue taskQueue(numScopeNames);
     for (size_t i = 0; i < numScopeNames; i++) {
         searchers[i] = std::make_unique<Searcher>();
-    }
-    for (size_t i = 0; i < numScopeNames; i++) {
-        std::string scopeName = scopeNames[i];
-        Searcher* s = searchers[i].get();
-        threads[i] = std::thread([scopeName, s, &ctx]() {
+        taskQueue.AddTask<void>([&scopeName = scopeNames[i], s = searchers[i].get(), &ctx]() {
             Query q(Operator::NOT);
             q.left = std::make_unique<Query>(Operator::AND);
             q.left->left = std::make_unique<Query>("scope_name", scopeName);
@@ -62,11 +59,8 @@ void TypeChecker::TypeCheckerImpl::WarmupCache(const ASTContext& ctx) const
             s->Search(ctx, &q);
         });
     }
-    for (auto& t : threads) {
-        if (t.joinable()) {
-            t.join();
-        }
-    }
+    taskQueue.RunAndWaitForAllTasksCompleted();
+    std::unordered_map<std::string, std::vector<Symbol*>> cache;
     for (auto& searcher : searchers) {
         cache.merge(searcher->GetCache());
     }
@@ -14,6 +14,8 @@
 
 #include "cangjie/Utils/FileUtil.h"
 
+#include <atomic>
+#include <cstdio>
 #include <fstream>
 #include <istream>
 #include <optional>
@@ -21,6 +23,7 @@
 #include <sstream>
 #include <string>
 #include <sys/stat.h>
+#include <thread>
 #include <vector>
 
 #include "cangjie/Basic/Print.h"
@@ -35,6 +38,7 @@
 #include <direct.h>
 #include <fileapi.h>
 #include <io.h>
+#include <process.h>
 #include <windows.h>
 #include <winerror.h>
 #ifndef PATH_MAX
@@ -42,6 +46,7 @@
 #endif
 #elif defined(__linux__) || defined(__APPLE__)
 #include <dirent.h>
+#include <unistd.h>
 #endif
 
 namespace Cangjie::FileUtil {
@@ -614,6 +619,35 @@ bool WriteToFile(const std::string& filePath, const std::string& data)
     return didSucceed;
 }
 
+namespace {
+/// A name next to @p targetPath which no other thread or process writes to at the same time.
+std::string GetUniqueTempPath(const std::string& targetPath)
+{
+    static std::atomic<uint64_t> counter{0};
+#ifdef _WIN32
+    auto pid = _getpid();
+#else
+    auto pid = getpid();
+#endif
+    auto tid = std::hash<std::thread::id>{}(std::this_thread::get_id());
+    return targetPath + ".tmp" + std::to_string(pid) + "." + std::to_string(tid) + "." +
+        std::to_string(counter.fetch_add(1, std::memory_order_relaxed));
+}
+
+/// Replace @p targetPath by @p tempPath in one step, so that readers see either the old or the new contents.
+bool ReplaceByTempFile(const std::string& tempPath, const std::string& targetPath)
+{
+#ifdef _WIN32
+    auto wideTemp = StringConvertor::StringToWString(tempPath);
+    auto wideTarget = StringConvertor::StringToWString(targetPath);
+    return wideTemp && wideTarget &&
+        MoveFileExW(wideTemp->c_str(), wideTarget->c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    return rename(tempPath.c_str(), targetPath.c_str()) == 0;
+#endif
+}
+} // namespace
+
 bool WriteBufferToASTFile(const std::string& filePath, const std::vector<uint8_t>& buffer)
 {
     std::string baseDir = GetDirPath(filePath);
@@ -627,7 +661,15 @@ bool WriteBufferToASTFile(const std::string& filePath, const std::vector<uint8_t
         return false;
     }
     auto fileName = GetFileName(filePath);
-    std::ofstream outStream(JoinPath(realFilePath.value(), fileName), std::ofstream::out | std::ofstream::binary);
+    auto targetPath = JoinPath(realFilePath.value(), fileName);
+    // Write through a symbolic link instead of replacing the link by a regular file.
+    if (auto linkTarget = FileExist(targetPath) ? GetAbsPath(targetPath) : std::nullopt) {
+        targetPath = *linkTarget;
+    }
+    // Readers may have the old file mapped into memory (see ReadOnlyBuffer). Truncating it in place would invalidate
+    // their pages, so write a temporary file and replace the old one by it.
+    auto writePath = GetUniqueTempPath(targetPath);
+    std::ofstream outStream(writePath, std::ofstream::out | std::ofstream::binary);
     if (!outStream.is_open()) {
         return false;
     }
@@ -635,6 +677,10 @@ bool WriteBufferToASTFile(const std::string& filePath, const std::vector<uint8_t
     outStream.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(length));
     bool success = !outStream.fail();
     outStream.close();
+    success = success && !outStream.fail() && ReplaceByTempFile(writePath, targetPath);
+    if (!success) {
+        (void)std::remove(writePath.c_str());
+    }
     return success;
 }
 
@@ -0,0 +1,164 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+// The Cangjie API is in Beta. For details on its capabilities and limitations, please refer to the README file.
+
+/**
+ * @file
+ *
+ * This file implements class PersistentCache.
+ */
+
+#include "cangjie/Utils/PersistentCache.h"
+
+#include <algorithm>
+#include <cctype>
+#include <sys/stat.h>
+#ifdef _WIN32
+#include <sys/utime.h>
+#else
+#include <utime.h>
+#endif
+
+#include "cangjie/Utils/CheckUtils.h"
+#include "cangjie/Utils/FileUtil.h"
+
+using namespace Cangjie;
+using namespace Cangjie::Utils;
+
+namespace {
+const std::string DATA_EXTENSION = "entry";
+const std::string METADATA_EXTENSION = "meta";
+
+bool IsValidKey(const std::string& key)
+{
+    return !key.empty() && std::all_of(key.begin(), key.end(), [](unsigned char c) { return std::isalnum(c) != 0; });
+}
+
+// Mark the entry as recently used. Failing to do so only makes it a candidate for early eviction.
+void Touch(const std::string& path)
+{
+#ifdef _WIN32
+    (void)_utime(path.c_str(), nullptr);
+#else
+    (void)utime(path.c_str(), nullptr);
+#endif
+}
+
+struct EntryInfo {
+    std::string key;
+    int64_t mtime{0};
+    uint64_t size{0};
+};
+} // namespace
+
+PersistentCache::PersistentCache(const std::string& dir, uint64_t capacity) : dir(dir), capacity(capacity)
+{
+}
+
+std::string PersistentCache::HashToKey(uint64_t hash)
+{
+    constexpr size_t hexDigits = 16;
+    constexpr uint64_t digitMask = 0xf;
+    constexpr unsigned bitsPerDigit = 4;
+    std::string key(hexDigits, '0');
+    for (size_t i = hexDigits; i > 0; --i) {
+        key[i - 1] = "0123456789abcdef"[hash & digitMask];
+        hash >>= bitsPerDigit;
+    }
+    return key;
+}
+
+std::string PersistentCache::GetDataPath(const std::string& key) const
+{
+    return FileUtil::JoinPath(dir, key + "." + DATA_EXTENSION);
+}
+
+std::string PersistentCache::GetMetadataPath(const std::string& key) const
+{
+    return FileUtil::JoinPath(dir, key + "." + METADATA_EXTENSION);
+}
+
+bool PersistentCache::Lookup(const std::string& key, std::vector<uint8_t>& data, std::string& metadata)
+{
+    CJC_ASSERT(IsValidKey(key));
+    auto dataPath = GetDataPath(key);
+    std::vector<uint8_t> content;
+    std::string failedReason;
+    // The data file is stored last and removed first, so a metadata file always exists alongside it, unless the
+    // entry is being evicted right now.
+    bool found = FileUtil::FileExist(dataPath) && FileUtil::ReadBinaryFileToBuffer(dataPath, content, failedReason);
+    auto storedMetadata = found ? FileUtil::ReadFileContent(GetMetadataPath(key), failedReason) : std::nullopt;
+    std::lock_guard<std::mutex> lock(mtx);
+    if (!storedMetadata.has_value()) {
+        ++stats.misses;
+        return false;
+    }
+    ++stats.hits;
+    Touch(dataPath);
+    data = std::move(content);
+    metadata = std::move(storedMetadata.value());
+    return true;
+}
+
+bool PersistentCache::Store(const std::string& key, const std::string& filePath, const std::string& metadata)
+{
+    CJC_ASSERT(IsValidKey(key));
+    std::vector<uint8_t> content;
+    std::string failedReason;
+    if (!FileUtil::ReadBinaryFileToBuffer(filePath, content, failedReason)) {
+        return false;
+    }
+    // Entries are replaced atomically on every platform (see FileUtil::WriteBufferToASTFile), the data file last as it
+    // marks the entry as complete.
+    if (!FileUtil::WriteBufferToASTFile(GetMetadataPath(key), std::vector<uint8_t>(metadata.begin(), metadata.end())) ||
+        !FileUtil::WriteBufferToASTFile(GetDataPath(key), content)) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mtx);
+    ++stats.stores;
+    return true;
+}
+
+void PersistentCache::Trim()
+{
+    std::vector<EntryInfo> entries;
+    uint64_t totalSize = 0;
+    for (auto& fileName : FileUtil::GetAllFilesUnderCurrentPath(dir, DATA_EXTENSION, false)) {
+        EntryInfo entry{FileUtil::GetFileNameWithoutExtension(fileName)};
+        struct stat st {};
+        if (!IsValidKey(entry.key) || stat(GetDataPath(entry.key).c_str(), &st) != 0) {
+            continue;
+        }
+        entry.mtime = static_cast<int64_t>(st.st_mtime);
+        entry.size = static_cast<uint64_t>(st.st_size) + FileUtil::GetFileSize(GetMetadataPath(entry.key));
+        totalSize += entry.size;
+        entries.emplace_back(std::move(entry));
+    }
+    if (totalSize <= capacity) {
+        return;
+    }
+    std::sort(entries.begin(), entries.end(), [](auto& lhs, auto& rhs) { return lhs.mtime < rhs.mtime; });
+    size_t evictions = 0;
+    for (auto& entry : entries) {
+        if (totalSize <= capacity) {
+            break;
+        }
+        // Another process may be trimming the same directory, so the entry may be gone already.
+        (void)FileUtil::Remove(GetDataPath(entry.key));
+        (void)FileUtil::Remove(GetMetadataPath(entry.key));
+        totalSize -= entry.size;
+        ++evictions;
+    }
+    std::lock_guard<std::mutex> lock(mtx);
+    stats.evictions += evictions;
+}
+
+PersistentCache::Stats PersistentCache::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(mtx);
+    return stats;
+}
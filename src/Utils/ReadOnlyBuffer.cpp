@@ -0,0 +1,181 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+// The Cangjie API is in Beta. For details on its capabilities and limitations, please refer to the README file.
+
+/**
+ * @file
+ *
+ * This file implements class ReadOnlyBuffer.
+ */
+
+#include "cangjie/Utils/ReadOnlyBuffer.h"
+
+#ifndef _WIN32
+#include <atomic>
+#include <csignal>
+#include <cstring>
+#include <mutex>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "cangjie/Utils/FileUtil.h"
+
+using namespace Cangjie;
+using namespace Cangjie::Utils;
+
+namespace {
+#ifndef _WIN32
+// Mapped files which a SIGBUS is attributed to. Only atomics are used, since they are read from the signal handler.
+constexpr size_t MAX_GUARDED_MAPPINGS = 4096;
+struct GuardedMapping {
+    std::atomic<bool> claimed{false};
+    std::atomic<uintptr_t> begin{0}; /**< 0 while the slot is not published. */
+    std::atomic<size_t> size{0};
+    std::atomic<const char*> path{nullptr};
+};
+GuardedMapping g_guardedMappings[MAX_GUARDED_MAPPINGS];
+struct sigaction g_oldBusAction {};
+
+void WriteToStderr(const char* str)
+{
+    (void)!write(STDERR_FILENO, str, strlen(str));
+}
+
+void BusHandler(int signum, siginfo_t* si, void* context)
+{
+    auto addr = reinterpret_cast<uintptr_t>(si->si_addr);
+    for (auto& mapping : g_guardedMappings) {
+        auto begin = mapping.begin.load(std::memory_order_acquire);
+        if (begin != 0 && addr >= begin && addr - begin < mapping.size.load(std::memory_order_relaxed)) {
+            WriteToStderr("error: read file '");
+            WriteToStderr(mapping.path.load(std::memory_order_relaxed));
+            WriteToStderr("' failed, reason: 'file truncated while being read'\n");
+            _exit(EXIT_FAILURE);
+        }
+    }
+    // Not caused by a mapped file: restore the previous handler, which handles the fault when the access repeats.
+    (void)sigaction(signum, &g_oldBusAction, nullptr);
+    (void)context;
+}
+
+/// Guard the mapping [@p addr, @p addr + @p size) of @p path against SIGBUS. Returns false if no slot is left.
+bool GuardMapping(const void* addr, size_t size, const char* path, size_t& slot)
+{
+    static std::once_flag installFlag;
+    std::call_once(installFlag, []() {
+        struct sigaction sa {};
+        sa.sa_sigaction = BusHandler;
+        sigemptyset(&sa.sa_mask);
+        sa.sa_flags = SA_SIGINFO | SA_ONSTACK;
+        (void)sigaction(SIGBUS, &sa, &g_oldBusAction);
+    });
+    for (slot = 0; slot < MAX_GUARDED_MAPPINGS; ++slot) {
+        auto& mapping = g_guardedMappings[slot];
+        bool expected = false;
+        if (mapping.claimed.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+            mapping.size.store(size, std::memory_order_relaxed);
+            mapping.path.store(path, std::memory_order_relaxed);
+            mapping.begin.store(reinterpret_cast<uintptr_t>(addr), std::memory_order_release);
+            return true;
+        }
+    }
+    return false;
+}
+
+void UnguardMapping(size_t slot)
+{
+    g_guardedMappings[slot].begin.store(0, std::memory_order_release);
+    g_guardedMappings[slot].claimed.store(false, std::memory_order_release);
+}
+
+// Map @p filePath read-only. Returns MAP_FAILED if it cannot be mapped; @p failedReason is only set when the file
+// itself is unusable, otherwise the caller may still fall back to reading it.
+void* MapFile(const std::string& filePath, size_t& size, std::string& failedReason)
+{
+    int fd = open(filePath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        failedReason = "open file failed";
+        return MAP_FAILED;
+    }
+    struct stat st {};
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        (void)close(fd);
+        return MAP_FAILED;
+    }
+    size = static_cast<size_t>(st.st_size);
+    if (size == 0) {
+        failedReason = "empty binary file";
+    } else if (size >= FILE_LEN_LIMIT) {
+        failedReason = "exceed the max file length: 4 GB";
+    }
+    if (!failedReason.empty()) {
+        (void)close(fd);
+        return MAP_FAILED;
+    }
+    void* addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping stays valid after the descriptor is closed.
+    (void)close(fd);
+    return addr;
+}
+#endif
+} // namespace
+
+std::shared_ptr<const ReadOnlyBuffer> ReadOnlyBuffer::FromFile(const std::string& filePath, std::string& failedReason)
+{
+    failedReason.clear();
+    auto realFilePath = FileUtil::GetAbsPath(filePath);
+    if (!realFilePath.has_value()) {
+        failedReason = "open file failed";
+        return nullptr;
+    }
+#ifndef _WIN32
+    size_t size = 0;
+    void* addr = MapFile(realFilePath.value(), size, failedReason);
+    if (!failedReason.empty()) {
+        return nullptr;
+    }
+    if (addr != MAP_FAILED) {
+        auto buffer = std::shared_ptr<ReadOnlyBuffer>(new ReadOnlyBuffer());
+        buffer->path = realFilePath.value();
+        if (GuardMapping(addr, size, buffer->path.c_str(), buffer->guardSlot)) {
+            buffer->data = static_cast<const uint8_t*>(addr);
+            buffer->size = size;
+            buffer->mapped = true;
+            return buffer;
+        }
+        // Too many files are mapped to guard another one, read it instead.
+        (void)munmap(addr, size);
+    }
+#endif
+    std::vector<uint8_t> content;
+    if (!FileUtil::ReadBinaryFileToBuffer(realFilePath.value(), content, failedReason)) {
+        return nullptr;
+    }
+    return FromVector(std::move(content));
+}
+
+std::shared_ptr<const ReadOnlyBuffer> ReadOnlyBuffer::FromVector(std::vector<uint8_t>&& data)
+{
+    auto buffer = std::shared_ptr<ReadOnlyBuffer>(new ReadOnlyBuffer());
+    buffer->owned = std::move(data);
+    buffer->data = buffer->owned.data();
+    buffer->size = buffer->owned.size();
+    return buffer;
+}
+
+ReadOnlyBuffer::~ReadOnlyBuffer()
+{
+#ifndef _WIN32
+    if (mapped) {
+        UnguardMapping(guardSlot);
+        (void)munmap(const_cast<uint8_t*>(data), size);
+    }
+#endif
+}
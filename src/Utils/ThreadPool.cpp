@@ -0,0 +1,133 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+// The Cangjie API is in Beta. For details on its capabilities and limitations, please refer to the README file.
+
+/**
+ * @file
+ *
+ * This file implements the process-wide work-stealing ThreadPool.
+ */
+
+#include "cangjie/Utils/ThreadPool.h"
+
+#include <limits>
+
+using namespace Cangjie::Utils;
+
+namespace {
+constexpr size_t NOT_A_WORKER = std::numeric_limits<size_t>::max();
+thread_local size_t g_workerIdx = NOT_A_WORKER;
+} // namespace
+
+ThreadPool::ThreadPool(size_t workersNum) : workersNum(workersNum > 0 ? workersNum : 1)
+{
+    for (size_t i = 0; i < this->workersNum; ++i) {
+        deques.emplace_back(std::make_unique<WorkDeque>());
+    }
+}
+
+ThreadPool& ThreadPool::Get()
+{
+    // The pool is intentionally never destroyed: workers may still be parked when static destructors run, and a job
+    // may call `exit` itself, in which case joining the workers from a worker would never return.
+    static ThreadPool* pool = new ThreadPool(std::thread::hardware_concurrency());
+    return *pool;
+}
+
+bool ThreadPool::IsWorkerThread()
+{
+    return g_workerIdx != NOT_A_WORKER;
+}
+
+void ThreadPool::StartWorkers()
+{
+    for (size_t i = 0; i < workersNum; ++i) {
+        std::thread([this, i]() { WorkerLoop(i); }).detach();
+    }
+}
+
+void ThreadPool::Submit(Job job)
+{
+    std::call_once(startFlag, [this]() { StartWorkers(); });
+    // Jobs spawned by a running job stay on the worker's own deque for locality, others are spread round-robin.
+    size_t idx = IsWorkerThread() ? g_workerIdx : nextDeque.fetch_add(1, std::memory_order_relaxed) % workersNum;
+    // Count the job before publishing it, so that a thief never observes fewer queued jobs than it can find.
+    queuedJobs.fetch_add(1, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(deques[idx]->mtx);
+        deques[idx]->jobs.emplace_back(std::move(job));
+    }
+    {
+        // Take the sleep lock so that a worker which has just observed an empty pool cannot miss this notification.
+        std::lock_guard<std::mutex> lock(sleepMtx);
+    }
+    sleepCv.notify_one();
+}
+
+bool ThreadPool::PopOrSteal(size_t startIdx, bool popOwn, Job& job)
+{
+    if (queuedJobs.load(std::memory_order_acquire) == 0) {
+        return false;
+    }
+    for (size_t i = 0; i < workersNum; ++i) {
+        auto& dq = *deques[(startIdx + i) % workersNum];
+        std::lock_guard<std::mutex> lock(dq.mtx);
+        if (dq.jobs.empty()) {
+            continue;
+        }
+        if (popOwn && i == 0) {
+            job = std::move(dq.jobs.back());
+            dq.jobs.pop_back();
+        } else {
+            job = std::move(dq.jobs.front());
+            dq.jobs.pop_front();
+        }
+        queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+bool ThreadPool::TryRunOne()
+{
+    Job job;
+    bool found = IsWorkerThread() ? PopOrSteal(g_workerIdx, true, job)
+                                  : PopOrSteal(nextDeque.load(std::memory_order_relaxed) % workersNum, false, job);
+    if (!found) {
+        return false;
+    }
+    job();
+    return true;
+}
+
+void ThreadPool::Park(const std::function<bool()>& done)
+{
+    std::unique_lock<std::mutex> lock(sleepMtx);
+    sleepCv.wait(lock, [this, &done]() { return done() || queuedJobs.load(std::memory_order_acquire) > 0; });
+}
+
+void ThreadPool::WakeWaiters()
+{
+    {
+        std::lock_guard<std::mutex> lock(sleepMtx);
+    }
+    sleepCv.notify_all();
+}
+
+void ThreadPool::WorkerLoop(size_t idx)
+{
+    g_workerIdx = idx;
+    while (true) {
+        Job job;
+        if (PopOrSteal(idx, true, job)) {
+            job();
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleepMtx);
+        sleepCv.wait(lock, [this]() { return queuedJobs.load(std::memory_order_acquire) > 0; });
+    }
+}
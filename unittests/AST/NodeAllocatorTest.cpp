@@ -0,0 +1,163 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+// The Cangjie API is in Beta. For details on its capabilities and limitations, please refer to the README file.
+
+#include "cangjie/AST/NodeAllocator.h"
+
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "cangjie/AST/Node.h"
+
+using namespace Cangjie::AST;
+
+namespace {
+size_t SizeClassOf(size_t size)
+{
+    constexpr size_t granule = 16;
+    return (size - 1) / granule;
+}
+
+template <typename T> void CheckNodeAllocation()
+{
+    ASSERT_NE(SizeClassOf(sizeof(T)), SizeClassOf(sizeof(Node)));
+    // A block freed to the allocator is the next one handed out for its size, so a node allocated right after it
+    // occupies it only if Node::operator new asks the allocator for the size of the derived node.
+    void* block = NodeAllocator::Allocate(sizeof(T));
+    NodeAllocator::Deallocate(block, sizeof(T));
+    Node* node = new T();
+    EXPECT_EQ(static_cast<void*>(node), block);
+    // Deleted through the base class, the sized operator delete must still get the size of the derived node, or the
+    // block would go back to the free list of another size.
+    delete node;
+    void* reused = NodeAllocator::Allocate(sizeof(T));
+    EXPECT_EQ(reused, block);
+    NodeAllocator::Deallocate(reused, sizeof(T));
+}
+} // namespace
+
+TEST(NodeAllocatorTest, AllocateAlignedDistinctBlocks)
+{
+    std::vector<void*> blocks;
+    for (size_t size : {1, 16, 17, 700, 1608, 2048, 4096}) {
+        for (int i = 0; i < 100; ++i) {
+            void* ptr = NodeAllocator::Allocate(size);
+            ASSERT_NE(ptr, nullptr);
+            EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % alignof(std::max_align_t), 0);
+            std::memset(ptr, 0xAB, size);
+            blocks.emplace_back(ptr);
+        }
+        for (auto ptr : blocks) {
+            NodeAllocator::Deallocate(ptr, size);
+        }
+        blocks.clear();
+    }
+}
+
+TEST(NodeAllocatorTest, FreeAcrossThreads)
+{
+    // Nodes created by one thread and freed by another, as the nodes of a package parsed in parallel.
+    constexpr size_t nodeNum = 10000;
+    constexpr size_t nodeSize = 512;
+    std::vector<void*> blocks(nodeNum);
+    std::thread producer([&blocks]() {
+        for (size_t i = 0; i < nodeNum; ++i) {
+            blocks[i] = NodeAllocator::Allocate(nodeSize);
+            std::memset(blocks[i], static_cast<int>(i & 0xFF), nodeSize);
+        }
+    });
+    producer.join();
+    for (size_t i = 0; i < nodeNum; ++i) {
+        EXPECT_EQ(*static_cast<unsigned char*>(blocks[i]), static_cast<unsigned char>(i & 0xFF));
+    }
+    std::thread consumer([&blocks]() {
+        for (auto ptr : blocks) {
+            NodeAllocator::Deallocate(ptr, nodeSize);
+        }
+    });
+    consumer.join();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 4; ++t) {
+        workers.emplace_back([]() {
+            std::vector<void*> own;
+            for (size_t i = 0; i < nodeNum; ++i) {
+                own.emplace_back(NodeAllocator::Allocate(nodeSize));
+            }
+            for (auto ptr : own) {
+                NodeAllocator::Deallocate(ptr, nodeSize);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+TEST(NodeAllocatorTest, NodesAreAllocatedWithTheirOwnSize)
+{
+#ifdef CANGJIE_AST_NODE_POOL_DISABLED
+    GTEST_SKIP() << "nodes are allocated by the global operator new under AddressSanitizer";
+#endif
+    // A new thread starts with an empty cache, so the free lists only hold the blocks of this test.
+    std::thread checker([]() {
+        CheckNodeAllocation<FuncDecl>();
+        CheckNodeAllocation<ClassDecl>();
+        CheckNodeAllocation<Block>();
+        CheckNodeAllocation<CallExpr>();
+        CheckNodeAllocation<RefExpr>();
+    });
+    checker.join();
+}
+
+TEST(NodeAllocatorTest, TrimReturnsUnusedSlabs)
+{
+#ifdef CANGJIE_AST_NODE_POOL_DISABLED
+    GTEST_SKIP() << "nodes are allocated by the global operator new under AddressSanitizer";
+#endif
+    // A size no other test uses, so that no node of its size class is alive.
+    constexpr size_t nodeSize = 1000;
+    constexpr size_t nodeNum = 10000;
+    std::vector<void*> blocks;
+    for (size_t i = 0; i < nodeNum; ++i) {
+        blocks.emplace_back(NodeAllocator::Allocate(nodeSize));
+    }
+    // Slabs with a live node are kept.
+    for (size_t i = 1; i < nodeNum; ++i) {
+        NodeAllocator::Deallocate(blocks[i], nodeSize);
+    }
+    size_t partlyFreed = NodeAllocator::Trim();
+    EXPECT_GE(partlyFreed, (nodeNum / 2) * nodeSize);
+    std::memset(blocks[0], 0xAB, nodeSize);
+    NodeAllocator::Deallocate(blocks[0], nodeSize);
+    size_t fullyFreed = NodeAllocator::Trim();
+    EXPECT_GT(fullyFreed, 0);
+    // Every slab the nodes were carved from is returned, whatever the order of the slab addresses.
+    EXPECT_GE(partlyFreed + fullyFreed, nodeNum * nodeSize);
+    EXPECT_EQ(NodeAllocator::Trim(), 0);
+    // The allocator still works after its slabs were returned.
+    void* ptr = NodeAllocator::Allocate(nodeSize);
+    std::memset(ptr, 0xCD, nodeSize);
+    NodeAllocator::Deallocate(ptr, nodeSize);
+}
+
+TEST(NodeAllocatorTest, ExitingThreadReturnsCachedNodes)
+{
+#ifdef CANGJIE_AST_NODE_POOL_DISABLED
+    GTEST_SKIP() << "nodes are allocated by the global operator new under AddressSanitizer";
+#endif
+    // A size no other test uses. The thread caches all nodes of the slab it carves, which is less than a batch.
+    constexpr size_t nodeSize = 1200;
+    (void)NodeAllocator::Trim();
+    std::thread worker([]() { NodeAllocator::Deallocate(NodeAllocator::Allocate(nodeSize), nodeSize); });
+    worker.join();
+    // The slab can only be freed if the exiting thread moved its cached nodes to the depot.
+    EXPECT_GT(NodeAllocator::Trim(), 0);
+}
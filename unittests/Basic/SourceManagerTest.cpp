@@ -125,4 +125,29 @@ TEST_F(SourceManagerTest, GetContentBetweenTest)
     code = sm.GetContentBetween(fileID1, Position(16, 9), Position(17, std::numeric_limits<int>::max()));
     EXPECT_EQ(code, "let a = 1\n        print(\"PageRankList${a}\\n\");\n");
 #endif
-}
\ No newline at end of file
+}
+
+TEST_F(SourceManagerTest, ReserveSourceTest)
+{
+    std::string absName = FileUtil::JoinPath(srcPath, "reserved.cj");
+    auto fileID = sm.ReserveSource(absName);
+    EXPECT_EQ(sm.ReserveSource(absName), fileID);
+    EXPECT_EQ(sm.GetFileID(FileUtil::Normalize(absName)), static_cast<int>(fileID));
+    EXPECT_TRUE(sm.GetSource(fileID).buffer.empty());
+
+    // Long enough not to be stored inline by the small string optimization.
+    std::string content = "let a = 1\nlet b = 2\nlet c = 3\n";
+    auto data = content.data();
+    sm.SetSourceBuffer(fileID, std::move(content));
+    auto& source = sm.GetSource(fileID);
+    EXPECT_EQ(source.buffer, "let a = 1\nlet b = 2\nlet c = 3\n");
+    // The buffer is taken over, not copied.
+    EXPECT_EQ(source.buffer.data(), data);
+    EXPECT_EQ(source.lineOffsets, (std::vector<size_t>{0, 10, 20, 30}));
+    EXPECT_EQ(sm.GetContentBetween(fileID, Position(2, 5), Position(2, 6)), "b");
+
+    // Setting a new content resets the line table.
+    sm.SetSourceBuffer(fileID, "let d = 4");
+    EXPECT_EQ(sm.GetSource(fileID).lineOffsets, (std::vector<size_t>{0}));
+    EXPECT_EQ(sm.GetNumberOfFiles(), 2);
+}
@@ -0,0 +1,273 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+// The Cangjie API is in Beta. For details on its capabilities and limitations, please refer to the README file.
+
+#include "cangjie/CHIR/Interpreter/BCHIRLinker.h"
+
+#include <chrono>
+#include <initializer_list>
+
+#include "CHIROptTest.h"
+#include "cangjie/Basic/DiagnosticEngine.h"
+#include "cangjie/CHIR/Interpreter/BCHIRInterpreter.h"
+
+using namespace Cangjie;
+using namespace Cangjie::CHIR::Interpreter;
+
+namespace {
+// The local variables of the function written by WriteSumFunction.
+constexpr Bchir::ByteCodeContent TUPLE_VAR = 0;
+constexpr Bchir::ByteCodeContent FLAG_VAR = 1;
+constexpr Bchir::ByteCodeContent I_VAR = 2;
+constexpr Bchir::ByteCodeContent ACC_VAR = 3;
+constexpr Bchir::ByteCodeContent NUM_VARS = 4;
+
+const std::string FUNC_NAME = "sum";
+
+/// Writes the unlinked bytecode of a function, and records the opcode each operation is expected to have once linked.
+struct FunctionWriter {
+    Bchir::Definition def;
+    std::vector<std::pair<Bchir::ByteCodeIndex, OpCode>> linkedOps;
+
+    Bchir::ByteCodeIndex Here() const
+    {
+        return def.NextIndex();
+    }
+
+    Bchir::ByteCodeIndex Emit(OpCode op, std::initializer_list<Bchir::ByteCodeContent> args = {})
+    {
+        return EmitAs(op, op, args);
+    }
+
+    /// Emits LVAR :: @p var, which the linker is expected to fuse with the next operation into @p superOp.
+    void EmitFused(OpCode superOp, Bchir::ByteCodeContent var)
+    {
+        EmitAs(OpCode::LVAR, superOp, {var});
+    }
+
+    void EmitInt64(int64_t value)
+    {
+        linkedOps.emplace_back(Here(), OpCode::INT64);
+        def.Push(OpCode::INT64);
+        def.Push8bytes(static_cast<uint64_t>(value));
+    }
+
+private:
+    Bchir::ByteCodeIndex EmitAs(OpCode op, OpCode linkedOp, std::initializer_list<Bchir::ByteCodeContent> args)
+    {
+        auto idx = Here();
+        linkedOps.emplace_back(idx, linkedOp);
+        def.Push(op);
+        for (auto arg : args) {
+            def.Push(arg);
+        }
+        return idx;
+    }
+};
+
+/**
+ * Writes a function returning n + 4 + n * (n + 1) / 2 + 3 * n, with fusable pairs right after SWITCH, FIELD_TPL,
+ * SYSCALL and CAPPLY, whose operands are variable-length. SYSCALL and CAPPLY are never executed because the
+ * interpreter does not support them.
+ */
+void WriteSumFunction(FunctionWriter& w, int64_t n)
+{
+    // FIELD_TPL below has a path whose words look like LVAR operations
+    static_assert(static_cast<Bchir::ByteCodeContent>(OpCode::LVAR) == 1);
+    auto int64Kind = static_cast<Bchir::ByteCodeContent>(CHIR::Type::TypeKind::TYPE_INT64);
+    auto uint8Kind = static_cast<Bchir::ByteCodeContent>(CHIR::Type::TypeKind::TYPE_UINT8);
+    auto wrapping = static_cast<Bchir::ByteCodeContent>(OverflowStrategy::WRAPPING);
+
+    w.Emit(OpCode::DROP); // the function itself
+    w.EmitInt64(0);
+    w.Emit(OpCode::LVAR_SET, {ACC_VAR});
+    w.EmitInt64(n);
+    w.Emit(OpCode::LVAR_SET, {I_VAR});
+    w.EmitInt64(3);
+    w.EmitInt64(4);
+    w.Emit(OpCode::TUPLE, {2});
+    w.Emit(OpCode::LVAR_SET, {TUPLE_VAR});
+    // SWITCH :: type :: number of cases :: case 1 (8 bytes) :: default target :: target of case 1
+    w.Emit(OpCode::UINT8, {1});
+    auto switchIdx = w.Emit(OpCode::SWITCH, {uint8Kind, 1, 1, 0, Bchir::DUMMY, Bchir::DUMMY});
+    w.def.Set(switchIdx + Bchir::FLAG_SIX, w.Here());
+    // acc = 2 * n
+    w.EmitFused(OpCode::LVAR_LVAR, I_VAR);
+    w.Emit(OpCode::LVAR, {I_VAR});
+    w.Emit(OpCode::BIN_ADD, {int64Kind, wrapping});
+    w.Emit(OpCode::LVAR_SET, {ACC_VAR});
+    // acc = tuple.1 + (acc - i)
+    w.Emit(OpCode::LVAR, {TUPLE_VAR});
+    w.Emit(OpCode::FIELD_TPL, {1, 1});
+    w.EmitFused(OpCode::LVAR_LVAR, ACC_VAR);
+    w.Emit(OpCode::LVAR, {I_VAR});
+    w.Emit(OpCode::BIN_SUB, {int64Kind, wrapping});
+    w.Emit(OpCode::BIN_ADD, {int64Kind, wrapping});
+    w.Emit(OpCode::LVAR_SET, {ACC_VAR});
+    // while (0 < i)
+    auto loop = w.Here();
+    w.EmitInt64(0);
+    w.Emit(OpCode::LVAR, {I_VAR});
+    w.Emit(OpCode::BIN_LT, {int64Kind, wrapping});
+    w.Emit(OpCode::LVAR_SET, {FLAG_VAR});
+    w.EmitFused(OpCode::LVAR_BRANCH, FLAG_VAR);
+    auto branchIdx = w.Emit(OpCode::BRANCH, {Bchir::DUMMY, Bchir::DUMMY});
+    w.def.Set(branchIdx + 1, w.Here());
+    // acc = acc + i
+    w.EmitFused(OpCode::LVAR_LVAR, ACC_VAR);
+    w.Emit(OpCode::LVAR, {I_VAR});
+    w.Emit(OpCode::BIN_ADD, {int64Kind, wrapping});
+    w.Emit(OpCode::LVAR_SET, {ACC_VAR});
+    // acc = acc + tuple.0, LVAR :: LVAR :: FIELD is fused as LVAR :: LVAR_FIELD
+    w.Emit(OpCode::LVAR, {ACC_VAR});
+    w.EmitFused(OpCode::LVAR_FIELD, TUPLE_VAR);
+    w.Emit(OpCode::FIELD, {0});
+    w.Emit(OpCode::BIN_ADD, {int64Kind, wrapping});
+    w.Emit(OpCode::LVAR_SET, {ACC_VAR});
+    // i = i - 1
+    w.Emit(OpCode::LVAR, {I_VAR});
+    w.EmitInt64(1);
+    w.Emit(OpCode::BIN_SUB, {int64Kind, wrapping});
+    w.Emit(OpCode::LVAR_SET, {I_VAR});
+    w.Emit(OpCode::JUMP, {loop});
+    w.def.Set(branchIdx + Bchir::FLAG_TWO, w.Here());
+    w.Emit(OpCode::LVAR, {ACC_VAR});
+    w.Emit(OpCode::RETURN);
+    // default target of the SWITCH, never executed
+    w.def.Set(switchIdx + Bchir::FLAG_FIVE, w.Here());
+    // SYSCALL :: name :: number of arguments :: result type :: argument types
+    w.Emit(OpCode::SYSCALL, {0, 1, 0, 0});
+    w.EmitFused(OpCode::LVAR_LVAR, I_VAR);
+    w.Emit(OpCode::LVAR, {ACC_VAR});
+    // CAPPLY :: number of arguments :: argument types :: result type
+    w.Emit(OpCode::CAPPLY, {1, 0, 0});
+    w.EmitFused(OpCode::LVAR_FIELD, TUPLE_VAR);
+    w.Emit(OpCode::FIELD, {1});
+    w.Emit(OpCode::ABORT);
+}
+
+int64_t ExpectedSum(int64_t n)
+{
+    constexpr int64_t tuple0 = 3;
+    constexpr int64_t tuple1 = 4;
+    return n + tuple1 + n * (n + 1) / 2 + tuple0 * n;
+}
+} // namespace
+
+class BCHIRLinkerTest : public CHIROptTest {
+protected:
+    /// Links a package made of the function written by WriteSumFunction, and returns the index of its FRAME.
+    Bchir::ByteCodeIndex LinkSumFunction(Bchir& linked, FunctionWriter& w, int64_t n)
+    {
+        WriteSumFunction(w, n);
+        std::vector<Bchir> packages(1);
+        auto& package = packages.back();
+        package.packageName = "test";
+        package.AddString("syscall");
+        package.AddType(*int64Ty);
+        auto def = w.def;
+        def.SetNumLVars(NUM_VARS);
+        package.AddFunction(FUNC_NAME, std::move(def));
+        BCHIRLinker linker(linked);
+        linker.Run(packages, GlobalOptions());
+        for (auto& [idx, mangledName] : linked.GetLinkedByteCode().GetMangledNamesAnnotations()) {
+            if (mangledName == FUNC_NAME && static_cast<OpCode>(linked.Get(idx)) == OpCode::FRAME) {
+                return idx;
+            }
+        }
+        ADD_FAILURE() << "function " << FUNC_NAME << " is not linked";
+        return 0;
+    }
+
+    /// The index of an operation of the linked function, from its index in the unlinked function.
+    static Bchir::ByteCodeIndex LinkedIndex(Bchir::ByteCodeIndex frame, Bchir::ByteCodeIndex idx)
+    {
+        // FRAME :: number of local variables :: body
+        return frame + Bchir::FLAG_TWO + idx;
+    }
+
+    /// Restores the operations fused by the linker, so that the function is run operation by operation.
+    static void Unfuse(Bchir& linked, Bchir::ByteCodeIndex frame, const FunctionWriter& w)
+    {
+        for (auto& [idx, op] : w.linkedOps) {
+            if (op == OpCode::LVAR_LVAR || op == OpCode::LVAR_FIELD || op == OpCode::LVAR_BRANCH) {
+                linked.SetOp(LinkedIndex(frame, idx), OpCode::LVAR);
+            }
+        }
+    }
+
+    /// Interprets FUNC :: frame :: APPLY :: 1 :: EXIT in the playground of the linked bytecode.
+    static int64_t Interpret(Bchir& linked, Bchir::ByteCodeIndex frame)
+    {
+        auto playground = static_cast<Bchir::ByteCodeIndex>(linked.GetLinkedByteCode().Size());
+        auto entry = playground + static_cast<Bchir::ByteCodeIndex>(BCHIRInterpreter::INTERNAL_PLAYGROUND_SIZE);
+        linked.Resize(
+            playground + BCHIRInterpreter::INTERNAL_PLAYGROUND_SIZE + BCHIRInterpreter::EXTERNAL_PLAYGROUND_SIZE);
+        linked.SetOp(entry, OpCode::FUNC);
+        linked.Set(entry + 1, frame);
+        linked.SetOp(entry + Bchir::FLAG_TWO, OpCode::APPLY);
+        linked.Set(entry + Bchir::FLAG_THREE, 1);
+        linked.SetOp(entry + Bchir::FLAG_FOUR, OpCode::EXIT);
+        DiagnosticEngine diag;
+        std::unordered_map<std::string, void*> dyHandles;
+        BCHIRInterpreter interpreter(linked, diag, dyHandles, playground, entry, true);
+        auto result = interpreter.Run(entry);
+        auto success = std::get_if<ISuccess>(&result);
+        if (success == nullptr) {
+            ADD_FAILURE() << "interpretation failed";
+            return 0;
+        }
+        return IValUtils::Get<IInt64>(success->val).content;
+    }
+};
+
+TEST_F(BCHIRLinkerTest, FusesPairsAfterVariableLengthOperations)
+{
+    constexpr int64_t n = 10;
+    Bchir linked;
+    FunctionWriter w;
+    auto frame = LinkSumFunction(linked, w, n);
+    for (auto& [idx, op] : w.linkedOps) {
+        EXPECT_EQ(static_cast<OpCode>(linked.Get(LinkedIndex(frame, idx))), op)
+            << "at " << idx << ", expected " << GetOpCodeLabel(op) << ", got "
+            << GetOpCodeLabel(static_cast<OpCode>(linked.Get(LinkedIndex(frame, idx))));
+    }
+    EXPECT_EQ(Interpret(linked, frame), ExpectedSum(n));
+}
+
+TEST_F(BCHIRLinkerTest, FusedAndUnfusedRunsAgree)
+{
+    constexpr int64_t n = 100;
+    Bchir fused;
+    FunctionWriter fusedWriter;
+    auto fusedFrame = LinkSumFunction(fused, fusedWriter, n);
+    Bchir unfused;
+    FunctionWriter unfusedWriter;
+    auto unfusedFrame = LinkSumFunction(unfused, unfusedWriter, n);
+    Unfuse(unfused, unfusedFrame, unfusedWriter);
+    EXPECT_EQ(Interpret(fused, fusedFrame), Interpret(unfused, unfusedFrame));
+}
+
+// Dispatch benchmark of the superinstructions: the same loop is interpreted with and without them. The times are only
+// recorded as test properties (see `--gtest_output=xml`), since they depend on the host and on the build type.
+TEST_F(BCHIRLinkerTest, SuperInstructionDispatch)
+{
+    constexpr int64_t n = 200000;
+    for (bool fuse : {true, false}) {
+        Bchir linked;
+        FunctionWriter w;
+        auto frame = LinkSumFunction(linked, w, n);
+        if (!fuse) {
+            Unfuse(linked, frame, w);
+        }
+        auto start = std::chrono::steady_clock::now();
+        auto sum = Interpret(linked, frame);
+        auto us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+        EXPECT_EQ(sum, ExpectedSum(n));
+        RecordProperty(fuse ? "us_fused" : "us_unfused", std::to_string(us.count()));
+    }
+}
@@ -0,0 +1,152 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+// The Cangjie API is in Beta. For details on its capabilities and limitations, please refer to the README file.
+
+#include "cangjie/CHIR/Transformation/BottomUpInliner.h"
+
+#include "CHIROptTest.h"
+
+namespace {
+constexpr size_t CALLER_NUM = 8;
+constexpr size_t CALLS_PER_CALLER = 20;
+// Allocate, 7 constants, Store and Exit, small enough to be inlined into every caller.
+constexpr size_t CALLEE_CONSTANT_NUM = 7;
+constexpr size_t CALLEE_SIZE = CALLEE_CONSTANT_NUM + 3;
+// The package is smaller than this, so the growth budget is its minimum.
+constexpr size_t MIN_GROWTH_BUDGET = 1000;
+
+/// Records the functions whose cached results are invalidated.
+class InvalidationRecorder : public AnalysisResultCache {
+public:
+    void InvalidateAllAnalysisResults() override
+    {
+        allInvalidated = true;
+    }
+
+    bool InvalidateAnalysisResult(const Func* func) override
+    {
+        return invalidated.emplace(func).second;
+    }
+
+    bool allInvalidated{false};
+    std::unordered_set<const Func*> invalidated;
+};
+} // namespace
+
+/**
+ * Builds func g(): Int64 and the callers f0(), f1(), ... which call it CALLS_PER_CALLER times each. The callers are
+ * on the same level of the call graph, and inlining all calls would exceed the growth budget of the package.
+ */
+class BottomUpInlinerTest : public CHIROptTest {
+protected:
+    void CreatePackage()
+    {
+        package = builder.CreatePackage("test");
+        callee = CreateFunc("g", {}, int64Ty);
+        auto entry = callee->GetEntryBlock();
+        auto ret = CreateAndAppendExpression<Allocate>(builder, builder.GetType<RefType>(int64Ty), int64Ty, entry);
+        callee->SetReturnValue(*ret->GetResult());
+        Value* value = nullptr;
+        for (size_t i = 0; i < CALLEE_CONSTANT_NUM; ++i) {
+            value = CreateInt(static_cast<int64_t>(i), entry);
+        }
+        CreateAndAppendExpression<Store>(builder, unitTy, value, ret->GetResult(), entry);
+        entry->AppendExpression(builder.CreateTerminator<Exit>(entry));
+
+        callers.clear();
+        for (size_t i = 0; i < CALLER_NUM; ++i) {
+            auto caller = CreateFunc("f" + std::to_string(i), {}, int64Ty);
+            auto callerEntry = caller->GetEntryBlock();
+            auto callerRet = CreateAndAppendExpression<Allocate>(
+                builder, builder.GetType<RefType>(int64Ty), int64Ty, callerEntry);
+            caller->SetReturnValue(*callerRet->GetResult());
+            Value* result = nullptr;
+            for (size_t j = 0; j < CALLS_PER_CALLER; ++j) {
+                result = CreateAndAppendExpression<Apply>(builder, int64Ty, callee, FuncCallContext{}, callerEntry)
+                             ->GetResult();
+            }
+            CreateAndAppendExpression<Store>(builder, unitTy, result, callerRet->GetResult(), callerEntry);
+            callerEntry->AppendExpression(builder.CreateTerminator<Exit>(callerEntry));
+            callers.emplace_back(caller);
+        }
+    }
+
+    /// Inlines the package with @p jobs threads and returns the remarks.
+    std::string Run(size_t jobs, AnalysisManager* analysisManager = nullptr)
+    {
+        opts.jobs = jobs;
+        DevirtualizationInfo devirtInfo(package, opts);
+        CallGraphAnalysis callGraph(package, devirtInfo);
+        callGraph.DoCallGraphAnalysis(false);
+        auto inliner = BottomUpInliner(builder, opts, nullptr, analysisManager);
+        inliner.Run(*package, callGraph, true);
+        growth = inliner.GetGrowth();
+        return BottomUpInliner::RemarksToJsonLines(inliner.GetRemarks());
+    }
+
+    Func* callee;
+    std::vector<Func*> callers;
+    size_t growth{0};
+};
+
+TEST_F(BottomUpInlinerTest, StopsInliningWhenBudgetIsExhausted)
+{
+    CreatePackage();
+    auto remarks = Run(1);
+    EXPECT_GT(growth, 0);
+    EXPECT_LE(growth, MIN_GROWTH_BUDGET);
+    EXPECT_NE(remarks.find("\"reason\":\"package-budget\""), std::string::npos);
+    // The callers are of the same size, so they get the same share of the budget.
+    size_t inlinedNum = CALLS_PER_CALLER - CountExprs(*callers[0], ExprKind::APPLY);
+    EXPECT_GT(inlinedNum, 0);
+    EXPECT_LT(inlinedNum, CALLS_PER_CALLER);
+    for (auto caller : callers) {
+        EXPECT_EQ(CountExprs(*caller, ExprKind::APPLY), CALLS_PER_CALLER - inlinedNum);
+    }
+    EXPECT_EQ(growth, CALLER_NUM * inlinedNum * CALLEE_SIZE);
+}
+
+TEST_F(BottomUpInlinerTest, InlinesInstanceVarInitsBeyondBudget)
+{
+    CreatePackage();
+    callee->SetFuncKind(FuncKind::INSTANCEVAR_INIT);
+    auto remarks = Run(1);
+    EXPECT_EQ(remarks.find("\"reason\":\"package-budget\""), std::string::npos);
+    for (auto caller : callers) {
+        EXPECT_EQ(CountExprs(*caller, ExprKind::APPLY), 0);
+    }
+    // Still charged, beyond the budget.
+    EXPECT_EQ(growth, CALLER_NUM * CALLS_PER_CALLER * CALLEE_SIZE);
+    EXPECT_GT(growth, MIN_GROWTH_BUDGET);
+}
+
+TEST_F(BottomUpInlinerTest, RemarksDoNotDependOnJobs)
+{
+    CreatePackage();
+    auto serialRemarks = Run(1);
+    auto serialGrowth = growth;
+    CreatePackage();
+    auto parallelRemarks = Run(4);
+    EXPECT_FALSE(serialRemarks.empty());
+    EXPECT_EQ(parallelRemarks, serialRemarks);
+    EXPECT_EQ(growth, serialGrowth);
+}
+
+TEST_F(BottomUpInlinerTest, MarksInlinedFunctionsChanged)
+{
+    CreatePackage();
+    AnalysisManager analysisManager;
+    InvalidationRecorder cache;
+    analysisManager.Synchronize(cache);
+    (void)Run(1, &analysisManager);
+    analysisManager.Synchronize(cache);
+    // Cached results of the callers must not be reused after calls were inlined into them.
+    EXPECT_FALSE(cache.allInvalidated);
+    for (auto caller : callers) {
+        EXPECT_EQ(cache.invalidated.count(caller), 1);
+    }
+}
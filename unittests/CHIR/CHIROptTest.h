@@ -0,0 +1,115 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+// The Cangjie API is in Beta. For details on its capabilities and limitations, please refer to the README file.
+
+/**
+ * @file
+ *
+ * This file declares the fixture of the tests of CHIR optimization passes, which build the CHIR of small functions.
+ */
+
+#ifndef CANGJIE_CHIR_OPT_TEST_H
+#define CANGJIE_CHIR_OPT_TEST_H
+
+#include <gtest/gtest.h>
+
+#include "cangjie/CHIR/Analysis/CallGraphAnalysis.h"
+#include "cangjie/CHIR/Analysis/DevirtualizationInfo.h"
+#include "cangjie/CHIR/Analysis/EscapeAnalysis.h"
+#include "cangjie/CHIR/CHIRBuilder.h"
+#include "cangjie/CHIR/CHIRContext.h"
+#include "cangjie/CHIR/Expression/Terminator.h"
+#include "cangjie/CHIR/Package.h"
+#include "cangjie/CHIR/Type/ClassDef.h"
+#include "cangjie/CHIR/Utils.h"
+#include "cangjie/Option/Option.h"
+
+using namespace Cangjie::CHIR;
+
+class CHIROptTest : public ::testing::Test {
+protected:
+    CHIROptTest() : cctx(&fileNameMap), builder(cctx)
+    {
+        package = builder.CreatePackage("test");
+        int64Ty = builder.GetInt64Ty();
+        boolTy = builder.GetBoolTy();
+        unitTy = builder.GetUnitTy();
+    }
+
+    /// Creates a function of package test with an empty entry block.
+    Func* CreateFunc(const std::string& name, const std::vector<Type*>& paramTys, Type* retTy)
+    {
+        auto func = builder.CreateFunc(
+            INVALID_LOCATION, builder.GetType<FuncType>(paramTys, retTy), name, name, "", package->GetName());
+        auto body = builder.CreateBlockGroup(*func);
+        func->InitBody(*body);
+        for (auto ty : paramTys) {
+            builder.CreateParameter(ty, INVALID_LOCATION, *func);
+        }
+        body->SetEntryBlock(builder.CreateBlock(body));
+        return func;
+    }
+
+    /// Creates a class of package test with one instance variable of each of @p memberTys, named m0, m1, ...
+    ClassType* CreateClass(const std::string& name, const std::vector<Type*>& memberTys)
+    {
+        auto classDef = builder.CreateClass(INVALID_LOCATION, name, name, package->GetName(), true, false);
+        for (size_t i = 0; i < memberTys.size(); ++i) {
+            MemberVarInfo member;
+            member.name = "m" + std::to_string(i);
+            member.rawMangledName = member.name;
+            member.type = memberTys[i];
+            classDef->AddInstanceVar(member);
+        }
+        auto classTy = builder.GetType<ClassType>(classDef);
+        classDef->SetType(*classTy);
+        return classTy;
+    }
+
+    Value* CreateInt(int64_t value, Block* block)
+    {
+        auto constant = builder.CreateConstantExpression<IntLiteral>(int64Ty, block, static_cast<uint64_t>(value));
+        block->AppendExpression(constant);
+        return constant->GetResult();
+    }
+
+    /// Runs the escape analysis of the whole package, as ToCHIR does before the passes using it.
+    const EscapeAnalysis& AnalyseEscapes()
+    {
+        DevirtualizationInfo devirtInfo(package, opts);
+        CallGraphAnalysis callGraph(package, devirtInfo);
+        callGraph.DoCallGraphAnalysis(false);
+        escapeAnalysis = EscapeAnalysis();
+        escapeAnalysis.RunOnPackage(*package, callGraph);
+        return escapeAnalysis;
+    }
+
+    /// Counts the expressions of @p kind in the blocks of @p func, not in its lambdas.
+    static size_t CountExprs(const Func& func, ExprKind kind)
+    {
+        size_t num = 0;
+        for (auto block : func.GetBody()->GetBlocks()) {
+            for (auto expr : block->GetExpressions()) {
+                num += static_cast<size_t>(expr->GetExprKind() == kind);
+            }
+        }
+        return num;
+    }
+
+    std::unordered_map<unsigned int, std::string> fileNameMap;
+    CHIRContext cctx;
+    CHIRBuilder builder;
+    Cangjie::GlobalOptions opts;
+    Package* package;
+    Type* int64Ty;
+    Type* boolTy;
+    Type* unitTy;
+
+private:
+    EscapeAnalysis escapeAnalysis;
+};
+#endif // CANGJIE_CHIR_OPT_TEST_H
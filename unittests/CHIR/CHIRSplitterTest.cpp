@@ -0,0 +1,67 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+// The Cangjie API is in Beta. For details on its capabilities and limitations, please refer to the README file.
+
+#include "CJNative/CHIRSplitter.h"
+
+#include <limits>
+
+#include "CHIROptTest.h"
+
+using namespace Cangjie::CodeGen;
+
+class CHIRSplitterTest : public CHIROptTest {
+protected:
+    static SubCHIRPackageSet CreateSubCHIRPackages(size_t splitNum)
+    {
+        SubCHIRPackageSet subCHIRPackages;
+        for (size_t idx = 0; idx < splitNum; ++idx) {
+            subCHIRPackages.emplace(SubCHIRPackage(idx, splitNum));
+        }
+        return subCHIRPackages;
+    }
+
+    /// Returns the index of the sub-package containing @p func, or the maximum size_t if there is none.
+    static size_t FindSubCHIRPackageIdx(const SubCHIRPackageSet& subCHIRPackages, Func* func)
+    {
+        for (auto& subCHIRPackage : subCHIRPackages) {
+            if (subCHIRPackage.chirFuncs.count(func) != 0) {
+                return subCHIRPackage.subCHIRPackageIdx;
+            }
+        }
+        return std::numeric_limits<size_t>::max();
+    }
+};
+
+TEST_F(CHIRSplitterTest, StaleCachedIndexesKeepClustersTogether)
+{
+    // The cache comes from a compilation with more sub-packages than the current two.
+    constexpr size_t splitNum = 2;
+    auto subCHIRPackages = CreateSubCHIRPackages(splitNum);
+    auto f = CreateFunc("f", {}, unitTy);
+    auto g = CreateFunc("g", {}, unitTy);
+    auto h = CreateFunc("h", {}, unitTy);
+    auto a = CreateFunc("a", {}, unitTy);
+    auto b = CreateFunc("b", {}, unitTy);
+    std::map<std::string, size_t> cache{{f->GetIdentifierWithoutPrefix(), 5}, {g->GetIdentifierWithoutPrefix(), 7},
+        {a->GetIdentifierWithoutPrefix(), 9}, {b->GetIdentifierWithoutPrefix(), 1}};
+    std::vector<FuncCluster> clusters{FuncCluster{{f, g, h}, 30}, FuncCluster{{a, b}, 10}};
+    SplitFuncClusters(clusters, subCHIRPackages, cache);
+
+    // Every stale function of a cluster moves to the same existing sub-package, and the cache records it.
+    auto clusterIdx = FindSubCHIRPackageIdx(subCHIRPackages, f);
+    EXPECT_LT(clusterIdx, splitNum);
+    for (auto func : {f, g, h}) {
+        EXPECT_EQ(FindSubCHIRPackageIdx(subCHIRPackages, func), clusterIdx);
+        EXPECT_EQ(cache.at(func->GetIdentifierWithoutPrefix()), clusterIdx);
+    }
+    // A cluster with one cached sub-package which still exists stays there.
+    for (auto func : {a, b}) {
+        EXPECT_EQ(FindSubCHIRPackageIdx(subCHIRPackages, func), 1);
+        EXPECT_EQ(cache.at(func->GetIdentifierWithoutPrefix()), 1);
+    }
+}
@@ -0,0 +1,161 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+// The Cangjie API is in Beta. For details on its capabilities and limitations, please refer to the README file.
+
+#include "cangjie/CHIR/Transformation/Devirtualization.h"
+
+#include "cangjie/CHIR/Analysis/PGOProfile.h"
+
+#include "CHIROptTest.h"
+
+/**
+ * Builds the hierarchy
+ *     open class A { open func foo(): Int64 }
+ *     class B <: A { override func foo(): Int64 }
+ *     class C <: A { override func foo(): Int64 }
+ * and func f(%0: A&): Int64, whose invoke of foo can't be de-virtualized without the profile.
+ */
+class DevirtualizationTest : public CHIROptTest {
+protected:
+    DevirtualizationTest()
+    {
+        aTy = CreatePrivateClass("A");
+        aTy->GetClassDef()->EnableAttr(Attribute::VIRTUAL);
+        CreateMethod(*aTy, *aTy);
+        bTy = CreateSubclass("B", *aTy);
+        CreateMethod(*bTy, *aTy);
+        cTy = CreateSubclass("C", *aTy);
+        CreateMethod(*cTy, *aTy);
+
+        auto aRefTy = builder.GetType<RefType>(aTy);
+        func = CreateFunc("f", {aRefTy}, int64Ty);
+        auto entry = func->GetEntryBlock();
+        auto ret = CreateAndAppendExpression<Allocate>(builder, builder.GetType<RefType>(int64Ty), int64Ty, entry);
+        func->SetReturnValue(*ret->GetResult());
+        auto originalFuncTy = builder.GetType<FuncType>(std::vector<Type*>{aRefTy}, int64Ty);
+        invoke = CreateAndAppendExpression<Invoke>(builder, int64Ty, InvokeCallContext{
+            .caller = func->GetParam(0),
+            .funcCallCtx = FuncCallContext{.thisType = aRefTy},
+            .virMethodCtx = VirMethodContext{.srcCodeIdentifier = "foo", .originalFuncType = originalFuncTy}}, entry);
+        CreateAndAppendExpression<Store>(builder, unitTy, invoke->GetResult(), ret->GetResult(), entry);
+        entry->AppendExpression(builder.CreateTerminator<Exit>(entry));
+    }
+
+    /// The subclasses of private classes are all in the package, so the pass may look at all of them.
+    ClassType* CreatePrivateClass(const std::string& name)
+    {
+        auto classTy = CreateClass(name, {});
+        classTy->GetClassDef()->EnableAttr(Attribute::PRIVATE);
+        return classTy;
+    }
+
+    ClassType* CreateSubclass(const std::string& name, ClassType& parent)
+    {
+        auto classTy = CreatePrivateClass(name);
+        classTy->GetClassDef()->SetSuperClassTy(parent);
+        return classTy;
+    }
+
+    /// Creates the implementation of foo in @p classTy, which overrides the one of @p topClassTy.
+    Func* CreateMethod(ClassType& classTy, ClassType& topClassTy)
+    {
+        auto classDef = classTy.GetClassDef();
+        auto method = CreateFunc(classDef->GetSrcCodeIdentifier() + ".foo", {builder.GetType<RefType>(&classTy)},
+            int64Ty);
+        auto entry = method->GetEntryBlock();
+        auto ret = CreateAndAppendExpression<Allocate>(builder, builder.GetType<RefType>(int64Ty), int64Ty, entry);
+        method->SetReturnValue(*ret->GetResult());
+        CreateAndAppendExpression<Store>(builder, unitTy, CreateInt(1, entry), ret->GetResult(), entry);
+        entry->AppendExpression(builder.CreateTerminator<Exit>(entry));
+        classDef->AddMethod(method);
+
+        VirtualFuncInfo info;
+        info.srcCodeIdentifier = "foo";
+        info.instance = method;
+        info.typeInfo.sigType = builder.GetType<FuncType>(std::vector<Type*>{}, unitTy);
+        info.typeInfo.originalType =
+            builder.GetType<FuncType>(std::vector<Type*>{builder.GetType<RefType>(&topClassTy)}, int64Ty);
+        info.typeInfo.parentType = &topClassTy;
+        info.typeInfo.returnType = int64Ty;
+        classDef->SetVTable(VTableType{{&topClassTy, {info}}});
+        return method;
+    }
+
+    /// Runs the pass on f with the call counts of foo's implementations in the profile of f.
+    size_t Run(const std::unordered_map<std::string, uint64_t>& callTargets)
+    {
+        PGOProfile profile;
+        profile.AddFuncProfile(func->GetIdentifierWithoutPrefix(), PGOProfile::FuncProfile{1000, callTargets});
+        DevirtualizationInfo devirtInfo(package, opts);
+        devirtInfo.CollectInfo();
+        TypeValue::SetCHIRBuilder(&builder);
+        Devirtualization::TypeAnalysisWrapper typeAnalysisWrapper(builder);
+        typeAnalysisWrapper.RunOnPackage(package, false, 1, devirtInfo);
+        auto devirt = Devirtualization(&typeAnalysisWrapper, devirtInfo, &profile);
+        devirt.RunOnFuncs({func}, builder, false);
+        return devirt.GetSpeculatedNum();
+    }
+
+    ClassType* aTy;
+    ClassType* bTy;
+    ClassType* cTy;
+    Func* func;
+    Invoke* invoke;
+};
+
+TEST_F(DevirtualizationTest, GuardsInvokeByHottestTarget)
+{
+    EXPECT_EQ(Run({{"B.foo", 1000}, {"A.foo", 100}}), 1);
+    // The instances of B call B.foo directly, the expressions after the invoke, including the terminator, are moved
+    // to the block both paths join in.
+    EXPECT_EQ(func->ToString(),
+        "Func @f([readOnly] %0: Class-A&) : Int64 srcCodeIdentifier: f\n"
+        "{ // Block Group: 0\n"
+        "Block #0: // preds: \n"
+        "  [ret] %1: Int64& = Allocate(Int64)\n"
+        "  %4: Int64& = Allocate(Int64)\n"
+        "  %6: Bool = InstanceOf(%0, Class-B&)\n"
+        "  Branch(%6, #2, #3) // sourceExpr: OTHER\n"
+        "Block #2: // preds: #0\n"
+        "  %10: Class-B& = TypeCast(%0) // checkTypeCast: true // Overflow: NA\n"
+        "  %11: Int64 = Apply(ThisType: Class-B&, @B.foo, %10)\n"
+        "  %8: Unit = Store(%11, %4)\n"
+        "  GoTo(#1)\n"
+        "Block #3: // preds: #0\n"
+        "  %2: Int64 = Invoke(ThisType: Class-A&, foo: (Class-A&) -> Int64, %0)\n"
+        "  %9: Unit = Store(%2, %4)\n"
+        "  GoTo(#1)\n"
+        "Block #1: // preds: #2, #3\n"
+        "  %5: Int64 = Load(%4)\n"
+        "  %3: Unit = Store(%5, %1)\n"
+        "  Exit()\n"
+        "}");
+}
+
+TEST_F(DevirtualizationTest, KeepsInvokeWithoutDominantTarget)
+{
+    // B.foo gets only half of the calls.
+    EXPECT_EQ(Run({{"B.foo", 1000}, {"C.foo", 1000}}), 0);
+    EXPECT_EQ(func->GetBody()->GetBlocks().size(), 1);
+    EXPECT_EQ(invoke->GetParentBlock(), func->GetEntryBlock());
+}
+
+TEST_F(DevirtualizationTest, KeepsInvokeOfRarelyCalledTarget)
+{
+    EXPECT_EQ(Run({{"B.foo", 999}}), 0);
+    EXPECT_EQ(func->GetBody()->GetBlocks().size(), 1);
+}
+
+TEST_F(DevirtualizationTest, KeepsInvokeIfSubclassOverridesTarget)
+{
+    // The guard holds for the instances of D <: B too, which don't call B.foo.
+    bTy->GetClassDef()->EnableAttr(Attribute::VIRTUAL);
+    auto dTy = CreateSubclass("D", *bTy);
+    CreateMethod(*dTy, *aTy);
+    EXPECT_EQ(Run({{"B.foo", 1000}}), 0);
+    EXPECT_EQ(func->GetBody()->GetBlocks().size(), 1);
+}
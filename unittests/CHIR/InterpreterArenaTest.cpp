@@ -0,0 +1,191 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+// The Cangjie API is in Beta. For details on its capabilities and limitations, please refer to the README file.
+
+#include "cangjie/CHIR/Interpreter/InterpreterArena.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace Cangjie::CHIR::Interpreter;
+
+namespace {
+// More values than fit in the buckets of the arena, which hold 2048 values each.
+constexpr size_t MANY_VALUES = 3 * 2048;
+
+IVal MakeInt(int64_t value)
+{
+    return IValUtils::PrimitiveValue<IInt64>(value);
+}
+
+int64_t GetInt(const IVal& value)
+{
+    return IValUtils::Get<IInt64>(value).content;
+}
+
+bool IsFreed(const IVal& value)
+{
+    return std::holds_alternative<IInvalid>(value);
+}
+
+IVal MakeObject(std::vector<IVal>&& fields)
+{
+    return IObject{0, std::move(fields)};
+}
+
+void Collect(Arena& arena, const std::vector<IVal>& roots)
+{
+    arena.BeginCollection();
+    for (auto& root : roots) {
+        arena.MarkRoot(root);
+    }
+    arena.FinishCollection();
+}
+} // namespace
+
+TEST(InterpreterArenaTest, KeepsValuesReachableFromRoots)
+{
+    Arena arena;
+    auto kept = arena.Allocate(MakeInt(1));
+    auto freed = arena.Allocate(MakeInt(2));
+    // kept -> target, through a pointer stored in an object
+    auto target = arena.Allocate(MakeInt(3));
+    auto holder = arena.Allocate(MakeObject({IPointer{target}}));
+
+    Collect(arena, {IPointer{kept}, IPointer{holder}});
+
+    EXPECT_EQ(GetInt(*kept), 1);
+    EXPECT_TRUE(IsFreed(*freed));
+    EXPECT_EQ(GetInt(*target), 3);
+    EXPECT_EQ(arena.GetAllocatedSize(), static_cast<int64_t>(3 * sizeof(IVal)));
+}
+
+TEST(InterpreterArenaTest, InteriorPointerKeepsOwnerAlive)
+{
+    Arena arena;
+    auto object = arena.Allocate(MakeObject({MakeInt(1), MakeInt(2), MakeInt(3)}));
+    auto field = &IValUtils::Get<IObject>(*object).content[1];
+    auto freed = arena.Allocate(MakeObject({MakeInt(4)}));
+
+    Collect(arena, {IPointer{field}});
+
+    ASSERT_FALSE(IsFreed(*object));
+    EXPECT_EQ(GetInt(IValUtils::Get<IObject>(*object).content[2]), 3);
+    EXPECT_TRUE(IsFreed(*freed));
+}
+
+TEST(InterpreterArenaTest, InteriorPointerIntoNestedAggregate)
+{
+    Arena arena;
+    auto object = arena.Allocate(MakeObject({MakeInt(1), ITuple{{MakeInt(2), MakeInt(3)}}}));
+    auto& tuple = IValUtils::Get<ITuple>(IValUtils::Get<IObject>(*object).content[1]);
+    auto element = &tuple.content[1];
+
+    Collect(arena, {IPointer{element}});
+
+    ASSERT_FALSE(IsFreed(*object));
+    EXPECT_EQ(GetInt(IValUtils::Get<IObject>(*object).content[0]), 1);
+}
+
+TEST(InterpreterArenaTest, ChainOfInteriorPointers)
+{
+    // root -> field of a, a -> field of b, b -> field of c: every owner is only found through the previous one.
+    Arena arena;
+    auto c = arena.Allocate(MakeObject({MakeInt(1), MakeInt(2)}));
+    auto b = arena.Allocate(MakeObject({MakeInt(3), IPointer{&IValUtils::Get<IObject>(*c).content[1]}}));
+    auto a = arena.Allocate(MakeObject({MakeInt(4), IPointer{&IValUtils::Get<IObject>(*b).content[0]}}));
+    auto unreachable = arena.Allocate(MakeObject({IPointer{&IValUtils::Get<IObject>(*a).content[0]}}));
+
+    Collect(arena, {IPointer{&IValUtils::Get<IObject>(*a).content[1]}});
+
+    EXPECT_FALSE(IsFreed(*a));
+    EXPECT_FALSE(IsFreed(*b));
+    EXPECT_FALSE(IsFreed(*c));
+    EXPECT_TRUE(IsFreed(*unreachable));
+}
+
+TEST(InterpreterArenaTest, PointerOutsideArenaIsIgnored)
+{
+    Arena arena;
+    auto freed = arena.Allocate(MakeInt(1));
+    IVal variable = MakeInt(2);
+
+    Collect(arena, {IPointer{&variable}});
+
+    EXPECT_TRUE(IsFreed(*freed));
+    EXPECT_EQ(GetInt(variable), 2);
+}
+
+TEST(InterpreterArenaTest, ReleasesEmptyBuckets)
+{
+    Arena arena;
+    std::vector<IVal*> values;
+    for (size_t i = 0; i < MANY_VALUES; ++i) {
+        values.emplace_back(arena.Allocate(MakeInt(static_cast<int64_t>(i))));
+    }
+    auto kept = values.back();
+    EXPECT_EQ(arena.GetAllocatedSize(), static_cast<int64_t>(MANY_VALUES * sizeof(IVal)));
+
+    Collect(arena, {IPointer{kept}});
+
+    // Only the last bucket is left, holding the one live value.
+    EXPECT_EQ(arena.GetAllocatedSize(), static_cast<int64_t>(sizeof(IVal)));
+    EXPECT_EQ(GetInt(*kept), static_cast<int64_t>(MANY_VALUES - 1));
+
+    Collect(arena, {});
+    EXPECT_EQ(arena.GetAllocatedSize(), 0);
+}
+
+TEST(InterpreterArenaTest, ReusesFreedSlotsLowestFirst)
+{
+    Arena arena;
+    std::vector<IVal*> values;
+    for (int64_t i = 0; i < 4; ++i) {
+        values.emplace_back(arena.Allocate(MakeInt(i)));
+    }
+
+    Collect(arena, {IPointer{values[0]}, IPointer{values[2]}});
+
+    EXPECT_EQ(arena.Allocate(MakeInt(5)), values[1]);
+    EXPECT_EQ(arena.Allocate(MakeInt(6)), values[3]);
+    EXPECT_EQ(GetInt(*values[1]), 5);
+    EXPECT_EQ(GetInt(*values[0]), 0);
+    EXPECT_EQ(arena.GetAllocatedSize(), static_cast<int64_t>(4 * sizeof(IVal)));
+}
+
+TEST(InterpreterArenaTest, FinalizingObjectsAreNeverCollected)
+{
+    Arena arena;
+    auto object = arena.Allocate(MakeObject({MakeInt(1)}));
+    arena.finalizingObjects.emplace_back(object);
+
+    Collect(arena, {});
+
+    EXPECT_FALSE(IsFreed(*object));
+}
+
+TEST(InterpreterArenaTest, CollectionThresholdFollowsLiveValues)
+{
+    const size_t minThreshold = 4;
+    Arena arena(minThreshold);
+    std::vector<IVal> roots;
+    for (int64_t i = 0; i < 8; ++i) {
+        roots.emplace_back(IPointer{arena.Allocate(MakeInt(i))});
+    }
+    EXPECT_TRUE(arena.ShouldCollect());
+
+    Collect(arena, roots);
+
+    // 8 values survived, so as many must be allocated before the next collection.
+    for (int64_t i = 0; i < 7; ++i) {
+        (void)arena.Allocate(MakeInt(i));
+    }
+    EXPECT_FALSE(arena.ShouldCollect());
+    (void)arena.Allocate(MakeInt(0));
+    EXPECT_TRUE(arena.ShouldCollect());
+}
@@ -0,0 +1,126 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+// The Cangjie API is in Beta. For details on its capabilities and limitations, please refer to the README file.
+
+#include "cangjie/CHIR/Interpreter/InterpreterStack.h"
+
+#include <chrono>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace Cangjie::CHIR::Interpreter;
+
+namespace {
+// More aggregates than the stack keeps content vectors for, which is 1024.
+constexpr size_t MANY_AGGREGATES = 3 * 1024;
+// Aggregates pushed before they are popped again in the benchmark, as for the arguments of a call.
+constexpr size_t CALL_ARGS = 8;
+constexpr size_t BENCH_PUSHES = 2000000;
+
+IVal MakeInt(int64_t value)
+{
+    return IValUtils::PrimitiveValue<IInt64>(value);
+}
+
+int64_t GetInt(const IVal& value)
+{
+    return IValUtils::Get<IInt64>(value).content;
+}
+
+/// The push and pop of an aggregate before the stack pooled content vectors.
+int64_t PushPopUnpooled(std::vector<ITuplePtr>& stack, ITuple&& tuple)
+{
+    for (size_t i = 0; i < CALL_ARGS; ++i) {
+        ITuple arg = i + 1 == CALL_ARGS ? std::move(tuple) : ITuple{{MakeInt(0)}};
+        ITuplePtr t{new std::vector<IVal>};
+        std::swap(*t.contentPtr, arg.content);
+        stack.emplace_back(t);
+    }
+    int64_t sum = 0;
+    for (size_t i = 0; i < CALL_ARGS; ++i) {
+        ITuple res;
+        std::swap(res.content, *stack.back().contentPtr);
+        delete stack.back().contentPtr;
+        stack.pop_back();
+        sum += GetInt(res.content[0]);
+    }
+    return sum;
+}
+
+int64_t PushPopPooled(InterpreterStack& stack, ITuple&& tuple)
+{
+    for (size_t i = 0; i < CALL_ARGS; ++i) {
+        ITuple arg = i + 1 == CALL_ARGS ? std::move(tuple) : ITuple{{MakeInt(0)}};
+        stack.ArgsPush(std::move(arg));
+    }
+    int64_t sum = 0;
+    for (size_t i = 0; i < CALL_ARGS; ++i) {
+        sum += GetInt(stack.ArgsPop<ITuple>().content[0]);
+    }
+    return sum;
+}
+} // namespace
+
+TEST(InterpreterStackTest, AggregatesKeepTheirContent)
+{
+    InterpreterStack stack;
+    stack.ArgsPush(ITuple{{MakeInt(1), MakeInt(2)}});
+    stack.ArgsPush(IArray{{MakeInt(3)}});
+    stack.ArgsPush(IObject{7, {MakeInt(4), MakeInt(5), MakeInt(6)}});
+
+    auto object = stack.ArgsPop<IObject>();
+    EXPECT_EQ(object.classId, 7U);
+    ASSERT_EQ(object.content.size(), 3U);
+    EXPECT_EQ(GetInt(object.content[2]), 6);
+
+    // a content vector back from the pool must not keep the elements of the popped object
+    stack.ArgsPush(ITuple{{MakeInt(8)}});
+    auto tuple = IValUtils::Get<ITuple>(stack.ArgsPopIVal());
+    ASSERT_EQ(tuple.content.size(), 1U);
+    EXPECT_EQ(GetInt(tuple.content[0]), 8);
+
+    auto array = stack.ArgsPop<IArray>();
+    ASSERT_EQ(array.content.size(), 1U);
+    EXPECT_EQ(GetInt(array.content[0]), 3);
+    stack.ArgsPopBack();
+    EXPECT_EQ(stack.ArgsSize(), 0U);
+}
+
+TEST(InterpreterStackTest, MoreAggregatesThanPooled)
+{
+    InterpreterStack stack;
+    for (int round = 0; round < 2; ++round) {
+        for (size_t i = 0; i < MANY_AGGREGATES; ++i) {
+            stack.ArgsPush(ITuple{{MakeInt(static_cast<int64_t>(i))}});
+        }
+        for (size_t i = MANY_AGGREGATES; i > 0; --i) {
+            auto tuple = stack.ArgsPop<ITuple>();
+            ASSERT_EQ(tuple.content.size(), 1U);
+            EXPECT_EQ(GetInt(tuple.content[0]), static_cast<int64_t>(i - 1));
+        }
+    }
+}
+
+// Not a check: records the time of pushing and popping aggregates, with and without the pool of content vectors.
+TEST(InterpreterStackTest, AggregatePushPop)
+{
+    std::vector<ITuplePtr> unpooled;
+    InterpreterStack pooled;
+    for (bool pool : {true, false}) {
+        int64_t sum = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < BENCH_PUSHES / CALL_ARGS; ++i) {
+            ITuple tuple{{MakeInt(1), MakeInt(static_cast<int64_t>(i))}};
+            sum += pool ? PushPopPooled(pooled, std::move(tuple)) : PushPopUnpooled(unpooled, std::move(tuple));
+        }
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+        EXPECT_EQ(sum, static_cast<int64_t>(BENCH_PUSHES / CALL_ARGS));
+        RecordProperty(pool ? "ns_per_push_pooled" : "ns_per_push_unpooled",
+            std::to_string(ns.count() / static_cast<int64_t>(BENCH_PUSHES)));
+    }
+}
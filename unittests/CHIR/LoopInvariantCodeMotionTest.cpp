@@ -0,0 +1,211 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+// The Cangjie API is in Beta. For details on its capabilities and limitations, please refer to the README file.
+
+#include "cangjie/CHIR/Transformation/LoopInvariantCodeMotion.h"
+
+#include "CHIROptTest.h"
+
+using Cangjie::OverflowStrategy;
+
+/**
+ * Builds func f(%0: Int64, %1: Int64, %2: Bool): Int64 with the loop
+ *     entry:  GoTo(header)
+ *     header: Branch(%2, body, exit)   // the only exit of the loop
+ *     body:   GoTo(header)             // the latch, executed conditionally
+ *     exit:   Exit()
+ * the tests append the expressions to hoist to the header or the body.
+ */
+class LoopInvariantCodeMotionTest : public CHIROptTest {
+protected:
+    LoopInvariantCodeMotionTest()
+    {
+        func = CreateFunc("f", {int64Ty, int64Ty, boolTy}, int64Ty);
+        entry = func->GetEntryBlock();
+        auto ret = CreateAndAppendExpression<Allocate>(builder, builder.GetType<RefType>(int64Ty), int64Ty, entry);
+        func->SetReturnValue(*ret->GetResult());
+        header = builder.CreateBlock(func->GetBody());
+        body = builder.CreateBlock(func->GetBody());
+        exit = builder.CreateBlock(func->GetBody());
+        // The no side effect function noEffect(%0: Int64): Int64.
+        noEffectFunc = CreateFunc("noEffect", {int64Ty}, int64Ty);
+        noEffectFunc->EnableAttr(Attribute::NO_SIDE_EFFECT);
+        auto calleeEntry = noEffectFunc->GetEntryBlock();
+        auto calleeRet =
+            CreateAndAppendExpression<Allocate>(builder, builder.GetType<RefType>(int64Ty), int64Ty, calleeEntry);
+        noEffectFunc->SetReturnValue(*calleeRet->GetResult());
+        CreateAndAppendExpression<Store>(
+            builder, unitTy, noEffectFunc->GetParam(0), calleeRet->GetResult(), calleeEntry);
+        calleeEntry->AppendExpression(builder.CreateTerminator<Exit>(calleeEntry));
+    }
+
+    Expression* CreateBinary(ExprKind kind, Value* lhs, Value* rhs, OverflowStrategy strategy, Block* block)
+    {
+        return CreateAndAppendExpression<BinaryExpression>(builder, lhs->GetType(), kind, lhs, rhs, strategy, block);
+    }
+
+    /// Terminates the blocks of the loop and runs the pass.
+    size_t Run()
+    {
+        entry->AppendExpression(builder.CreateTerminator<GoTo>(header, entry));
+        header->AppendExpression(builder.CreateTerminator<Branch>(func->GetParam(2), body, exit, header));
+        body->AppendExpression(builder.CreateTerminator<GoTo>(header, body));
+        exit->AppendExpression(builder.CreateTerminator<Exit>(exit));
+        return LoopInvariantCodeMotion(AnalyseEscapes()).RunOnFunc(*func, builder, false);
+    }
+
+    /// Whether @p expr is outside the loop after the pass.
+    bool IsHoisted(const Expression& expr) const
+    {
+        return expr.GetParentBlock() != header && expr.GetParentBlock() != body;
+    }
+
+    Func* func;
+    Func* noEffectFunc;
+    Block* entry;
+    Block* header;
+    Block* body;
+    Block* exit;
+};
+
+TEST_F(LoopInvariantCodeMotionTest, HoistsNonThrowingArithmeticOutOfConditionalBlock)
+{
+    auto a = func->GetParam(0);
+    auto b = func->GetParam(1);
+    auto add = CreateBinary(ExprKind::ADD, a, b, OverflowStrategy::WRAPPING, body);
+    // Its operand is hoisted first, so it is invariant as well.
+    auto mul = CreateBinary(ExprKind::MUL, add->GetResult(), b, OverflowStrategy::SATURATING, body);
+    auto cmp = CreateAndAppendExpression<BinaryExpression>(builder, boolTy, ExprKind::LT, a, b, body);
+
+    EXPECT_EQ(Run(), 3);
+    EXPECT_TRUE(IsHoisted(*add));
+    EXPECT_TRUE(IsHoisted(*mul));
+    EXPECT_TRUE(IsHoisted(*cmp));
+    // In the order they were executed in the loop.
+    EXPECT_EQ(add->GetParentBlock(), entry);
+    auto hoisted = entry->GetExpressions();
+    EXPECT_LT(std::find(hoisted.begin(), hoisted.end(), add), std::find(hoisted.begin(), hoisted.end(), mul));
+}
+
+TEST_F(LoopInvariantCodeMotionTest, KeepsThrowingArithmetic)
+{
+    auto a = func->GetParam(0);
+    auto b = func->GetParam(1);
+    // Throws on overflow.
+    auto add = CreateBinary(ExprKind::ADD, a, b, OverflowStrategy::THROWING, body);
+    // Throws on a zero divisor, which the loop may never reach.
+    auto div = CreateBinary(ExprKind::DIV, a, b, OverflowStrategy::WRAPPING, body);
+    auto mod = CreateBinary(ExprKind::MOD, a, b, OverflowStrategy::WRAPPING, header);
+    // Throws on a shift by a negative value or by the width of the type or more.
+    auto shl = CreateBinary(ExprKind::LSHIFT, a, b, OverflowStrategy::WRAPPING, body);
+    auto shr = CreateBinary(ExprKind::RSHIFT, a, b, OverflowStrategy::WRAPPING, header);
+
+    EXPECT_EQ(Run(), 0);
+    EXPECT_FALSE(IsHoisted(*add));
+    EXPECT_FALSE(IsHoisted(*div));
+    EXPECT_FALSE(IsHoisted(*mod));
+    EXPECT_FALSE(IsHoisted(*shl));
+    EXPECT_FALSE(IsHoisted(*shr));
+}
+
+TEST_F(LoopInvariantCodeMotionTest, KeepsExpressionsUsingLoopValues)
+{
+    auto a = func->GetParam(0);
+    // The value loaded from memory written in the loop changes in every iteration.
+    auto counter = CreateAndAppendExpression<Allocate>(builder, builder.GetType<RefType>(int64Ty), int64Ty, entry);
+    auto value = CreateAndAppendExpression<Load>(builder, int64Ty, counter->GetResult(), header);
+    auto next = CreateBinary(ExprKind::ADD, value->GetResult(), a, OverflowStrategy::WRAPPING, body);
+    CreateAndAppendExpression<Store>(builder, unitTy, next->GetResult(), counter->GetResult(), body);
+
+    EXPECT_EQ(Run(), 0);
+    EXPECT_FALSE(IsHoisted(*value));
+    EXPECT_FALSE(IsHoisted(*next));
+}
+
+TEST_F(LoopInvariantCodeMotionTest, HoistsLoadOfMemoryOnlyReadInLoop)
+{
+    auto local = CreateAndAppendExpression<Allocate>(builder, builder.GetType<RefType>(int64Ty), int64Ty, entry);
+    CreateAndAppendExpression<Store>(builder, unitTy, func->GetParam(0), local->GetResult(), entry);
+    auto load = CreateAndAppendExpression<Load>(builder, int64Ty, local->GetResult(), body);
+
+    EXPECT_EQ(Run(), 1);
+    EXPECT_TRUE(IsHoisted(*load));
+}
+
+TEST_F(LoopInvariantCodeMotionTest, KeepsLoadUnderStore)
+{
+    auto local = CreateAndAppendExpression<Allocate>(builder, builder.GetType<RefType>(int64Ty), int64Ty, entry);
+    CreateAndAppendExpression<Store>(builder, unitTy, func->GetParam(0), local->GetResult(), entry);
+    // The store is after the load, but the load of the next iteration reads it.
+    auto load = CreateAndAppendExpression<Load>(builder, int64Ty, local->GetResult(), header);
+    CreateAndAppendExpression<Store>(builder, unitTy, func->GetParam(1), local->GetResult(), body);
+
+    EXPECT_EQ(Run(), 0);
+    EXPECT_FALSE(IsHoisted(*load));
+}
+
+TEST_F(LoopInvariantCodeMotionTest, KeepsLoadOfEscapingMemory)
+{
+    // A callee which keeps the reference may write the memory at any time.
+    auto refTy = builder.GetType<RefType>(int64Ty);
+    auto keepFunc = CreateFunc("keep", {refTy}, unitTy);
+    auto keepEntry = keepFunc->GetEntryBlock();
+    auto slot = CreateAndAppendExpression<Allocate>(builder, builder.GetType<RefType>(refTy), refTy, keepEntry);
+    CreateAndAppendExpression<Store>(builder, unitTy, keepFunc->GetParam(0), slot->GetResult(), keepEntry);
+    keepEntry->AppendExpression(builder.CreateTerminator<Exit>(keepEntry));
+
+    auto local = CreateAndAppendExpression<Allocate>(builder, refTy, int64Ty, entry);
+    CreateAndAppendExpression<Apply>(
+        builder, unitTy, keepFunc, FuncCallContext{.args = {local->GetResult()}}, entry);
+    auto load = CreateAndAppendExpression<Load>(builder, int64Ty, local->GetResult(), body);
+
+    EXPECT_EQ(Run(), 0);
+    EXPECT_FALSE(IsHoisted(*load));
+}
+
+TEST_F(LoopInvariantCodeMotionTest, HoistsNoSideEffectCallOnlyIfExecutedInEveryIteration)
+{
+    // The header is executed whenever the loop is, the body may not be executed at all.
+    auto a = func->GetParam(0);
+    auto guaranteed =
+        CreateAndAppendExpression<Apply>(builder, int64Ty, noEffectFunc, FuncCallContext{.args = {a}}, header);
+    auto conditional =
+        CreateAndAppendExpression<Apply>(builder, int64Ty, noEffectFunc, FuncCallContext{.args = {a}}, body);
+
+    EXPECT_EQ(Run(), 1);
+    EXPECT_TRUE(IsHoisted(*guaranteed));
+    EXPECT_FALSE(IsHoisted(*conditional));
+}
+
+TEST_F(LoopInvariantCodeMotionTest, KeepsCallWithSideEffect)
+{
+    noEffectFunc->DisableAttr(Attribute::NO_SIDE_EFFECT);
+    auto call = CreateAndAppendExpression<Apply>(
+        builder, int64Ty, noEffectFunc, FuncCallContext{.args = {func->GetParam(0)}}, header);
+
+    EXPECT_EQ(Run(), 0);
+    EXPECT_FALSE(IsHoisted(*call));
+}
+
+TEST_F(LoopInvariantCodeMotionTest, CreatesPreheader)
+{
+    // The header has two predecessors outside the loop, the entry and the block before it.
+    auto before = builder.CreateBlock(func->GetBody());
+    auto cond = CreateAndAppendExpression<BinaryExpression>(
+        builder, boolTy, ExprKind::LT, func->GetParam(0), func->GetParam(1), entry);
+    entry->AppendExpression(builder.CreateTerminator<Branch>(cond->GetResult(), header, before, entry));
+    before->AppendExpression(builder.CreateTerminator<GoTo>(header, before));
+    entry = before;
+    auto add = CreateBinary(ExprKind::ADD, func->GetParam(0), func->GetParam(1), OverflowStrategy::WRAPPING, body);
+
+    EXPECT_EQ(Run(), 1);
+    auto preheader = add->GetParentBlock();
+    EXPECT_TRUE(IsHoisted(*add));
+    EXPECT_NE(preheader, before);
+    EXPECT_EQ(preheader->GetPredecessors().size(), 2);
+    EXPECT_EQ(preheader->GetSuccessors(), std::vector<Block*>{header});
+}
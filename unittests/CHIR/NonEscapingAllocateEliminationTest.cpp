@@ -0,0 +1,228 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+// The Cangjie API is in Beta. For details on its capabilities and limitations, please refer to the README file.
+
+#include "cangjie/CHIR/Transformation/NonEscapingAllocateElimination.h"
+
+#include "CHIROptTest.h"
+
+class NonEscapingAllocateEliminationTest : public CHIROptTest {
+protected:
+    NonEscapingAllocateEliminationTest()
+    {
+        classTy = CreateClass("C", {int64Ty, int64Ty});
+        refTy = builder.GetType<RefType>(int64Ty);
+        // func read(%0: Int64&): Unit, which only loads from its parameter.
+        readFunc = CreateFunc("read", {refTy}, unitTy);
+        auto entry = readFunc->GetEntryBlock();
+        CreateAndAppendExpression<Load>(builder, int64Ty, readFunc->GetParam(0), entry);
+        entry->AppendExpression(builder.CreateTerminator<Exit>(entry));
+    }
+
+    /// Creates func f(): Int64, which allocates a C and initializes its members, the allocation is returned.
+    Func* CreateFuncAllocating(Value*& obj)
+    {
+        auto func = CreateFunc("f", {}, int64Ty);
+        auto entry = func->GetEntryBlock();
+        auto ret = CreateAndAppendExpression<Allocate>(builder, refTy, int64Ty, entry);
+        func->SetReturnValue(*ret->GetResult());
+        obj = CreateAndAppendExpression<Allocate>(builder, builder.GetType<RefType>(classTy), classTy, entry)
+                  ->GetResult();
+        CreateAndAppendExpression<StoreElementRef>(builder, unitTy, CreateInt(1, entry), obj,
+            std::vector<uint64_t>{0}, entry);
+        CreateAndAppendExpression<StoreElementRef>(builder, unitTy, CreateInt(2, entry), obj,
+            std::vector<uint64_t>{1}, entry);
+        return func;
+    }
+
+    /// Loads member 0 of @p obj into the return value and exits @p func.
+    void ReturnMember0(Func& func, Value& obj)
+    {
+        auto entry = func.GetEntryBlock();
+        auto member = CreateAndAppendExpression<GetElementRef>(builder, refTy, &obj, std::vector<uint64_t>{0}, entry);
+        auto value = CreateAndAppendExpression<Load>(builder, int64Ty, member->GetResult(), entry);
+        CreateAndAppendExpression<Store>(builder, unitTy, value->GetResult(), func.GetReturnValue(), entry);
+        entry->AppendExpression(builder.CreateTerminator<Exit>(entry));
+    }
+
+    size_t Run(const Func& func, bool enableCompileDebug = false)
+    {
+        return NonEscapingAllocateElimination(AnalyseEscapes()).RunOnFunc(func, builder, false, enableCompileDebug);
+    }
+
+    ClassType* classTy;
+    RefType* refTy;
+    Func* readFunc;
+};
+
+TEST_F(NonEscapingAllocateEliminationTest, ReplacesObjectByMemberVariables)
+{
+    Value* obj = nullptr;
+    auto func = CreateFuncAllocating(obj);
+    ReturnMember0(*func, *obj);
+    EXPECT_EQ(func->ToString(),
+        "Func @f() : Int64 srcCodeIdentifier: f\n"
+        "{ // Block Group: 0\n"
+        "Block #0: // preds: \n"
+        "  [ret] %0: Int64& = Allocate(Int64)\n"
+        "  %1: Class-C& = Allocate(Class-C)\n"
+        "  %2: Int64 = Constant(1i)\n"
+        "  %3: Unit = StoreElementRef(%2, %1, 0)\n"
+        "  %4: Int64 = Constant(2i)\n"
+        "  %5: Unit = StoreElementRef(%4, %1, 1)\n"
+        "  %6: Int64& = GetElementRef(%1, 0)\n"
+        "  %7: Int64 = Load(%6)\n"
+        "  %8: Unit = Store(%7, %0)\n"
+        "  Exit()\n"
+        "}");
+
+    EXPECT_EQ(Run(*func), 1);
+    EXPECT_EQ(func->ToString(),
+        "Func @f() : Int64 srcCodeIdentifier: f\n"
+        "{ // Block Group: 0\n"
+        "Block #0: // preds: \n"
+        "  [ret] %0: Int64& = Allocate(Int64)\n"
+        "  %9: Int64& = Allocate(Int64)\n"
+        "  %11: Int64& = Allocate(Int64)\n"
+        "  %2: Int64 = Constant(1i)\n"
+        "  %10: Unit = Store(%2, %9)\n"
+        "  %4: Int64 = Constant(2i)\n"
+        "  %12: Unit = Store(%4, %11)\n"
+        "  %7: Int64 = Load(%9)\n"
+        "  %8: Unit = Store(%7, %0)\n"
+        "  Exit()\n"
+        "}");
+}
+
+TEST_F(NonEscapingAllocateEliminationTest, KeepsObjectWithDebugOnlyWithDebugInfo)
+{
+    Value* obj = nullptr;
+    auto func = CreateFuncAllocating(obj);
+    CreateAndAppendExpression<Debug>(builder, unitTy, obj, "obj", func->GetEntryBlock());
+    ReturnMember0(*func, *obj);
+    EXPECT_EQ(Run(*func, true), 0);
+    EXPECT_EQ(CountExprs(*func, ExprKind::DEBUGEXPR), 1);
+
+    EXPECT_EQ(Run(*func), 1);
+    EXPECT_EQ(CountExprs(*func, ExprKind::DEBUGEXPR), 0);
+    EXPECT_EQ(CountExprs(*func, ExprKind::GET_ELEMENT_REF), 0);
+}
+
+TEST_F(NonEscapingAllocateEliminationTest, PassesMemberVariableToNonEscapingParameter)
+{
+    Value* obj = nullptr;
+    auto func = CreateFuncAllocating(obj);
+    auto entry = func->GetEntryBlock();
+    auto member = CreateAndAppendExpression<GetElementRef>(builder, refTy, obj, std::vector<uint64_t>{1}, entry);
+    auto call = CreateAndAppendExpression<Apply>(
+        builder, unitTy, readFunc, FuncCallContext{.args = {member->GetResult()}}, entry);
+    ReturnMember0(*func, *obj);
+
+    EXPECT_EQ(Run(*func), 1);
+    EXPECT_EQ(CountExprs(*func, ExprKind::GET_ELEMENT_REF), 0);
+    // The callee reads the local allocation of the member variable instead.
+    auto arg = call->GetArgs()[0];
+    ASSERT_TRUE(arg->IsLocalVar());
+    EXPECT_EQ(Cangjie::StaticCast<LocalVar*>(arg)->GetExpr()->GetExprKind(), ExprKind::ALLOCATE);
+    EXPECT_EQ(arg->GetType(), refTy);
+}
+
+TEST_F(NonEscapingAllocateEliminationTest, KeepsObjectWhoseMemberEscapesThroughCall)
+{
+    // func keep(%0: Int64&): Unit, which stores its parameter into memory.
+    auto keepFunc = CreateFunc("keep", {refTy}, unitTy);
+    auto keepEntry = keepFunc->GetEntryBlock();
+    auto slot = CreateAndAppendExpression<Allocate>(builder, builder.GetType<RefType>(refTy), refTy, keepEntry);
+    CreateAndAppendExpression<Store>(builder, unitTy, keepFunc->GetParam(0), slot->GetResult(), keepEntry);
+    keepEntry->AppendExpression(builder.CreateTerminator<Exit>(keepEntry));
+
+    Value* obj = nullptr;
+    auto func = CreateFuncAllocating(obj);
+    auto entry = func->GetEntryBlock();
+    auto member = CreateAndAppendExpression<GetElementRef>(builder, refTy, obj, std::vector<uint64_t>{1}, entry);
+    CreateAndAppendExpression<Apply>(builder, unitTy, keepFunc, FuncCallContext{.args = {member->GetResult()}}, entry);
+    ReturnMember0(*func, *obj);
+
+    EXPECT_EQ(Run(*func), 0);
+    EXPECT_EQ(CountExprs(*func, ExprKind::ALLOCATE), 2);
+}
+
+TEST_F(NonEscapingAllocateEliminationTest, KeepsObjectPassedToCall)
+{
+    // func use(%0: C&): Unit, which does not let its parameter escape, but needs the object in one piece.
+    auto objRefTy = builder.GetType<RefType>(classTy);
+    auto useFunc = CreateFunc("use", {objRefTy}, unitTy);
+    auto useEntry = useFunc->GetEntryBlock();
+    auto member = CreateAndAppendExpression<GetElementRef>(
+        builder, refTy, useFunc->GetParam(0), std::vector<uint64_t>{0}, useEntry);
+    CreateAndAppendExpression<Load>(builder, int64Ty, member->GetResult(), useEntry);
+    useEntry->AppendExpression(builder.CreateTerminator<Exit>(useEntry));
+
+    Value* obj = nullptr;
+    auto func = CreateFuncAllocating(obj);
+    CreateAndAppendExpression<Apply>(builder, unitTy, useFunc, FuncCallContext{.args = {obj}}, func->GetEntryBlock());
+    ReturnMember0(*func, *obj);
+
+    const auto& escapeAnalysis = AnalyseEscapes();
+    EXPECT_FALSE(escapeAnalysis.IsParamEscaping(*useFunc, 0));
+    EXPECT_EQ(NonEscapingAllocateElimination(escapeAnalysis).RunOnFunc(*func, builder, false, false), 0);
+}
+
+TEST_F(NonEscapingAllocateEliminationTest, KeepsObjectStoredIntoMemory)
+{
+    auto objRefTy = builder.GetType<RefType>(classTy);
+    Value* obj = nullptr;
+    auto func = CreateFuncAllocating(obj);
+    auto entry = func->GetEntryBlock();
+    auto slot = CreateAndAppendExpression<Allocate>(builder, builder.GetType<RefType>(objRefTy), objRefTy, entry);
+    CreateAndAppendExpression<Store>(builder, unitTy, obj, slot->GetResult(), entry);
+    ReturnMember0(*func, *obj);
+
+    EXPECT_EQ(Run(*func), 0);
+}
+
+TEST_F(NonEscapingAllocateEliminationTest, KeepsReturnedObject)
+{
+    // func make(): C&, which returns the object it allocates.
+    auto objRefTy = builder.GetType<RefType>(classTy);
+    auto func = CreateFunc("make", {}, objRefTy);
+    auto entry = func->GetEntryBlock();
+    auto ret = CreateAndAppendExpression<Allocate>(builder, builder.GetType<RefType>(objRefTy), objRefTy, entry);
+    func->SetReturnValue(*ret->GetResult());
+    auto obj = CreateAndAppendExpression<Allocate>(builder, objRefTy, classTy, entry)->GetResult();
+    CreateAndAppendExpression<StoreElementRef>(builder, unitTy, CreateInt(1, entry), obj, std::vector<uint64_t>{0},
+        entry);
+    CreateAndAppendExpression<Store>(builder, unitTy, obj, ret->GetResult(), entry);
+    entry->AppendExpression(builder.CreateTerminator<Exit>(entry));
+
+    EXPECT_EQ(Run(*func), 0);
+}
+
+TEST_F(NonEscapingAllocateEliminationTest, KeepsObjectUsedInLambda)
+{
+    Value* obj = nullptr;
+    auto func = CreateFuncAllocating(obj);
+    auto entry = func->GetEntryBlock();
+    // A lambda which reads member 1 of the object may run after f returns.
+    auto lambdaTy = builder.GetType<FuncType>(std::vector<Type*>{}, int64Ty);
+    auto lambda = CreateAndAppendExpression<Lambda>(builder, lambdaTy, lambdaTy, entry, true, "g", "g");
+    auto lambdaBody = builder.CreateBlockGroup(*func);
+    lambda->InitBody(*lambdaBody);
+    auto lambdaEntry = builder.CreateBlock(lambdaBody);
+    lambdaBody->SetEntryBlock(lambdaEntry);
+    auto lambdaRet = CreateAndAppendExpression<Allocate>(builder, refTy, int64Ty, lambdaEntry);
+    lambda->SetReturnValue(*lambdaRet->GetResult());
+    auto member =
+        CreateAndAppendExpression<GetElementRef>(builder, refTy, obj, std::vector<uint64_t>{1}, lambdaEntry);
+    auto value = CreateAndAppendExpression<Load>(builder, int64Ty, member->GetResult(), lambdaEntry);
+    CreateAndAppendExpression<Store>(builder, unitTy, value->GetResult(), lambdaRet->GetResult(), lambdaEntry);
+    lambdaEntry->AppendExpression(builder.CreateTerminator<Exit>(lambdaEntry));
+    ReturnMember0(*func, *obj);
+
+    EXPECT_EQ(Run(*func), 0);
+    EXPECT_EQ(CountExprs(*func, ExprKind::ALLOCATE), 2);
+}
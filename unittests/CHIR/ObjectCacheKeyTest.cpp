@@ -0,0 +1,55 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+// The Cangjie API is in Beta. For details on its capabilities and limitations, please refer to the README file.
+
+#include "cangjie/CodeGen/EmitPackageIR.h"
+
+#include <functional>
+
+#include "gtest/gtest.h"
+
+using namespace Cangjie;
+using namespace Cangjie::CodeGen;
+
+namespace {
+// Checks that changing an option through @p flip changes the options part of the object cache key.
+void ExpectCacheKeyChanges(const std::function<void(GlobalOptions&)>& flip)
+{
+    GlobalOptions options;
+    auto before = SerializeCodeGenOptions(options);
+    flip(options);
+    EXPECT_NE(before, SerializeCodeGenOptions(options));
+}
+} // namespace
+
+TEST(ObjectCacheKeyTest, OptionsReadOnlyByCodeGenMissTheCache)
+{
+    ExpectCacheKeyChanges([](GlobalOptions& options) { options.mock = MockMode::ON; });
+    ExpectCacheKeyChanges([](GlobalOptions& options) { options.compileTestsOnly = true; });
+    ExpectCacheKeyChanges([](GlobalOptions& options) { options.disableInstantiation = false; });
+    ExpectCacheKeyChanges([](GlobalOptions& options) { options.disableReflection = true; });
+    ExpectCacheKeyChanges([](GlobalOptions& options) { options.enableOpaque = true; });
+    ExpectCacheKeyChanges([](GlobalOptions& options) { options.cjdbMode = true; });
+    ExpectCacheKeyChanges([](GlobalOptions& options) { options.aggressiveParallelCompile = 4; });
+    ExpectCacheKeyChanges([](GlobalOptions& options) { options.inProcessBackendArgs.emplace_back("-O3"); });
+}
+
+TEST(ObjectCacheKeyTest, OptionsSharedWithTheFrontendMissTheCache)
+{
+    ExpectCacheKeyChanges([](GlobalOptions& options) { options.enableCompileDebug = true; });
+    ExpectCacheKeyChanges([](GlobalOptions& options) { options.enableCompileTest = true; });
+    ExpectCacheKeyChanges([](GlobalOptions& options) { options.fastMathMode = true; });
+}
+
+TEST(ObjectCacheKeyTest, SameOptionsHitTheCache)
+{
+    GlobalOptions options;
+    options.mock = MockMode::RUNTIME_ERROR;
+    options.compileTestsOnly = true;
+    GlobalOptions same = options;
+    EXPECT_EQ(SerializeCodeGenOptions(options), SerializeCodeGenOptions(same));
+}
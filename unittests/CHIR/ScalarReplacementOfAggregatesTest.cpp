@@ -0,0 +1,290 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+// The Cangjie API is in Beta. For details on its capabilities and limitations, please refer to the README file.
+
+#include "cangjie/CHIR/Transformation/ScalarReplacementOfAggregates.h"
+
+#include "CHIROptTest.h"
+#include "cangjie/CHIR/Type/StructDef.h"
+
+/// Builds func f(%0: Int64, %1: Int64): Int64, the tests allocate tuples in its entry block.
+class ScalarReplacementOfAggregatesTest : public CHIROptTest {
+protected:
+    ScalarReplacementOfAggregatesTest()
+    {
+        pairTy = builder.GetType<TupleType>(std::vector<Type*>{int64Ty, int64Ty});
+        func = CreateFunc("f", {int64Ty, int64Ty}, int64Ty);
+        entry = func->GetEntryBlock();
+        auto ret = CreateAndAppendExpression<Allocate>(builder, builder.GetType<RefType>(int64Ty), int64Ty, entry);
+        func->SetReturnValue(*ret->GetResult());
+    }
+
+    Value* CreateAlloc(Type* ty, Block* block)
+    {
+        return CreateAndAppendExpression<Allocate>(builder, builder.GetType<RefType>(ty), ty, block)->GetResult();
+    }
+
+    /// Stores @p value into the return value and exits f.
+    void Return(Value* value)
+    {
+        CreateAndAppendExpression<Store>(builder, unitTy, value, func->GetReturnValue(), entry);
+        entry->AppendExpression(builder.CreateTerminator<Exit>(entry));
+    }
+
+    size_t Run(bool enableCompileDebug = false)
+    {
+        return ScalarReplacementOfAggregates::RunOnFunc(*func, builder, false, enableCompileDebug);
+    }
+
+    /// Builds a pair variable with a Debug, whose element 0 is returned.
+    void CreateDebuggedPair()
+    {
+        auto pair = CreateAlloc(pairTy, entry);
+        CreateAndAppendExpression<Debug>(builder, unitTy, pair, "pair", entry);
+        CreateAndAppendExpression<StoreElementRef>(
+            builder, unitTy, func->GetParam(0), pair, std::vector<uint64_t>{0}, entry);
+        auto ref = CreateAndAppendExpression<GetElementRef>(
+            builder, builder.GetType<RefType>(int64Ty), pair, std::vector<uint64_t>{0}, entry);
+        Return(CreateAndAppendExpression<Load>(builder, int64Ty, ref->GetResult(), entry)->GetResult());
+    }
+
+    TupleType* pairTy;
+    Func* func;
+    Block* entry;
+};
+
+TEST_F(ScalarReplacementOfAggregatesTest, SplitsElementAccesses)
+{
+    auto pair = CreateAlloc(pairTy, entry);
+    CreateAndAppendExpression<StoreElementRef>(
+        builder, unitTy, func->GetParam(0), pair, std::vector<uint64_t>{0}, entry);
+    CreateAndAppendExpression<StoreElementRef>(
+        builder, unitTy, func->GetParam(1), pair, std::vector<uint64_t>{1}, entry);
+    auto ref = CreateAndAppendExpression<GetElementRef>(
+        builder, builder.GetType<RefType>(int64Ty), pair, std::vector<uint64_t>{1}, entry);
+    Return(CreateAndAppendExpression<Load>(builder, int64Ty, ref->GetResult(), entry)->GetResult());
+    EXPECT_EQ(func->ToString(),
+        "Func @f([readOnly] %0: Int64, [readOnly] %1: Int64) : Int64 srcCodeIdentifier: f\n"
+        "{ // Block Group: 0\n"
+        "Block #0: // preds: \n"
+        "  [ret] %2: Int64& = Allocate(Int64)\n"
+        "  %3: Tuple<Int64,Int64>& = Allocate(Tuple<Int64,Int64>)\n"
+        "  %4: Unit = StoreElementRef(%0, %3, 0)\n"
+        "  %5: Unit = StoreElementRef(%1, %3, 1)\n"
+        "  %6: Int64& = GetElementRef(%3, 1)\n"
+        "  %7: Int64 = Load(%6)\n"
+        "  %8: Unit = Store(%7, %2)\n"
+        "  Exit()\n"
+        "}");
+
+    EXPECT_EQ(Run(), 1);
+    EXPECT_EQ(func->ToString(),
+        "Func @f([readOnly] %0: Int64, [readOnly] %1: Int64) : Int64 srcCodeIdentifier: f\n"
+        "{ // Block Group: 0\n"
+        "Block #0: // preds: \n"
+        "  [ret] %2: Int64& = Allocate(Int64)\n"
+        "  %9: Int64& = Allocate(Int64)\n"
+        "  %11: Int64& = Allocate(Int64)\n"
+        "  %10: Unit = Store(%0, %9)\n"
+        "  %12: Unit = Store(%1, %11)\n"
+        "  %7: Int64 = Load(%11)\n"
+        "  %8: Unit = Store(%7, %2)\n"
+        "  Exit()\n"
+        "}");
+}
+
+TEST_F(ScalarReplacementOfAggregatesTest, SplitsStoreOfWholeAggregate)
+{
+    auto pair = CreateAlloc(pairTy, entry);
+    // A freshly built tuple is stored element-wise, any other value is split by Fields.
+    auto tuple = CreateAndAppendExpression<Tuple>(
+        builder, pairTy, std::vector<Value*>{func->GetParam(0), func->GetParam(1)}, entry);
+    CreateAndAppendExpression<Store>(builder, unitTy, tuple->GetResult(), pair, entry);
+    auto other = CreateAlloc(pairTy, entry);
+    auto value = CreateAndAppendExpression<Load>(builder, pairTy, other, entry);
+    CreateAndAppendExpression<Store>(builder, unitTy, value->GetResult(), pair, entry);
+    auto ref = CreateAndAppendExpression<GetElementRef>(
+        builder, builder.GetType<RefType>(int64Ty), pair, std::vector<uint64_t>{0}, entry);
+    Return(CreateAndAppendExpression<Load>(builder, int64Ty, ref->GetResult(), entry)->GetResult());
+
+    // The loaded value of other is stored whole, so other stays.
+    EXPECT_EQ(Run(), 1);
+    EXPECT_EQ(CountExprs(*func, ExprKind::GET_ELEMENT_REF), 0);
+    EXPECT_EQ(CountExprs(*func, ExprKind::ALLOCATE), 4);
+    EXPECT_EQ(CountExprs(*func, ExprKind::FIELD), 2);
+    EXPECT_TRUE(tuple->GetResult()->GetUsers().empty());
+    auto users = func->GetParam(0)->GetUsers();
+    EXPECT_EQ(std::count_if(users.begin(), users.end(),
+                  [](const Expression* user) { return user->GetExprKind() == ExprKind::STORE; }),
+        1);
+}
+
+TEST_F(ScalarReplacementOfAggregatesTest, SplitsLoadOnlyUsedByFields)
+{
+    auto pair = CreateAlloc(pairTy, entry);
+    CreateAndAppendExpression<StoreElementRef>(
+        builder, unitTy, func->GetParam(0), pair, std::vector<uint64_t>{1}, entry);
+    auto value = CreateAndAppendExpression<Load>(builder, pairTy, pair, entry);
+    auto field = CreateAndAppendExpression<Field>(
+        builder, int64Ty, value->GetResult(), std::vector<uint64_t>{1}, entry);
+    // Stores after the load must not be observed by the field.
+    CreateAndAppendExpression<StoreElementRef>(
+        builder, unitTy, func->GetParam(1), pair, std::vector<uint64_t>{1}, entry);
+    Return(field->GetResult());
+
+    EXPECT_EQ(Run(), 1);
+    // Element 1 is loaded where the tuple was, and only once per element.
+    EXPECT_EQ(func->ToString(),
+        "Func @f([readOnly] %0: Int64, [readOnly] %1: Int64) : Int64 srcCodeIdentifier: f\n"
+        "{ // Block Group: 0\n"
+        "Block #0: // preds: \n"
+        "  [ret] %2: Int64& = Allocate(Int64)\n"
+        "  %9: Int64& = Allocate(Int64)\n"
+        "  %10: Unit = Store(%0, %9)\n"
+        "  %11: Int64 = Load(%9)\n"
+        "  %12: Unit = Store(%1, %9)\n"
+        "  %8: Unit = Store(%11, %2)\n"
+        "  Exit()\n"
+        "}");
+}
+
+TEST_F(ScalarReplacementOfAggregatesTest, KeepsLoadUsedWhole)
+{
+    auto takeFunc = CreateFunc("take", {pairTy}, unitTy);
+    takeFunc->GetEntryBlock()->AppendExpression(builder.CreateTerminator<Exit>(takeFunc->GetEntryBlock()));
+
+    auto pair = CreateAlloc(pairTy, entry);
+    auto value = CreateAndAppendExpression<Load>(builder, pairTy, pair, entry);
+    CreateAndAppendExpression<Apply>(builder, unitTy, takeFunc, FuncCallContext{.args = {value->GetResult()}}, entry);
+    auto field = CreateAndAppendExpression<Field>(
+        builder, int64Ty, value->GetResult(), std::vector<uint64_t>{0}, entry);
+    Return(field->GetResult());
+
+    EXPECT_EQ(Run(), 0);
+}
+
+TEST_F(ScalarReplacementOfAggregatesTest, SplitsVariableWithDebugWithoutDebugInfo)
+{
+    CreateDebuggedPair();
+    EXPECT_EQ(Run(), 1);
+    EXPECT_EQ(CountExprs(*func, ExprKind::DEBUGEXPR), 0);
+    EXPECT_EQ(CountExprs(*func, ExprKind::GET_ELEMENT_REF), 0);
+}
+
+TEST_F(ScalarReplacementOfAggregatesTest, KeepsVariableWithDebugWithDebugInfo)
+{
+    CreateDebuggedPair();
+    EXPECT_EQ(Run(true), 0);
+    EXPECT_EQ(CountExprs(*func, ExprKind::DEBUGEXPR), 1);
+    EXPECT_EQ(CountExprs(*func, ExprKind::GET_ELEMENT_REF), 1);
+}
+
+TEST_F(ScalarReplacementOfAggregatesTest, SplitsCopyOfAggregate)
+{
+    // The copy is split first, its Store of the whole tuple becomes Fields of the loaded value, so that the original
+    // tuple is split in turn.
+    auto pair = CreateAlloc(pairTy, entry);
+    CreateAndAppendExpression<StoreElementRef>(
+        builder, unitTy, func->GetParam(0), pair, std::vector<uint64_t>{0}, entry);
+    auto value = CreateAndAppendExpression<Load>(builder, pairTy, pair, entry);
+    auto copy = CreateAlloc(pairTy, entry);
+    CreateAndAppendExpression<Store>(builder, unitTy, value->GetResult(), copy, entry);
+    auto ref = CreateAndAppendExpression<GetElementRef>(
+        builder, builder.GetType<RefType>(int64Ty), copy, std::vector<uint64_t>{0}, entry);
+    Return(CreateAndAppendExpression<Load>(builder, int64Ty, ref->GetResult(), entry)->GetResult());
+
+    EXPECT_EQ(Run(), 2);
+    EXPECT_EQ(CountExprs(*func, ExprKind::FIELD), 0);
+    EXPECT_EQ(CountExprs(*func, ExprKind::GET_ELEMENT_REF), 0);
+    for (auto expr : entry->GetExpressions()) {
+        if (expr->GetExprKind() == ExprKind::ALLOCATE) {
+            EXPECT_EQ(Cangjie::StaticCast<Allocate*>(expr)->GetType(), int64Ty);
+        }
+    }
+}
+
+TEST_F(ScalarReplacementOfAggregatesTest, SplitsNestedAggregates)
+{
+    auto nestedTy = builder.GetType<TupleType>(std::vector<Type*>{int64Ty, pairTy});
+    auto nested = CreateAlloc(nestedTy, entry);
+    CreateAndAppendExpression<StoreElementRef>(
+        builder, unitTy, func->GetParam(0), nested, std::vector<uint64_t>{1, 0}, entry);
+    auto ref = CreateAndAppendExpression<GetElementRef>(
+        builder, builder.GetType<RefType>(int64Ty), nested, std::vector<uint64_t>{1, 0}, entry);
+    Return(CreateAndAppendExpression<Load>(builder, int64Ty, ref->GetResult(), entry)->GetResult());
+
+    // The outer tuple, then the inner one, element 0 of the outer one is never used.
+    EXPECT_EQ(Run(), 2);
+    EXPECT_EQ(CountExprs(*func, ExprKind::GET_ELEMENT_REF), 0);
+    EXPECT_EQ(CountExprs(*func, ExprKind::STORE_ELEMENT_REF), 0);
+    auto exprs = entry->GetExpressions();
+    ASSERT_EQ(exprs[1]->GetExprKind(), ExprKind::ALLOCATE);
+    EXPECT_EQ(Cangjie::StaticCast<Allocate*>(exprs[1])->GetType(), int64Ty);
+    EXPECT_EQ(CountExprs(*func, ExprKind::ALLOCATE), 2);
+}
+
+TEST_F(ScalarReplacementOfAggregatesTest, SplitsStruct)
+{
+    auto structDef = builder.CreateStruct(INVALID_LOCATION, "S", "S", package->GetName(), false);
+    MemberVarInfo member;
+    member.name = "x";
+    member.rawMangledName = "x";
+    member.type = int64Ty;
+    structDef->AddInstanceVar(member);
+    auto structTy = builder.GetType<StructType>(structDef);
+    structDef->SetType(*structTy);
+    auto obj = CreateAlloc(structTy, entry);
+    CreateAndAppendExpression<StoreElementRef>(
+        builder, unitTy, func->GetParam(0), obj, std::vector<uint64_t>{0}, entry);
+    auto ref = CreateAndAppendExpression<GetElementRef>(
+        builder, builder.GetType<RefType>(int64Ty), obj, std::vector<uint64_t>{0}, entry);
+    Return(CreateAndAppendExpression<Load>(builder, int64Ty, ref->GetResult(), entry)->GetResult());
+
+    EXPECT_EQ(Run(), 1);
+    EXPECT_EQ(CountExprs(*func, ExprKind::ALLOCATE), 2);
+}
+
+TEST_F(ScalarReplacementOfAggregatesTest, KeepsAggregateUsedInLambda)
+{
+    auto pair = CreateAlloc(pairTy, entry);
+    CreateAndAppendExpression<StoreElementRef>(
+        builder, unitTy, func->GetParam(0), pair, std::vector<uint64_t>{0}, entry);
+    // The lambda reads element 0, its uses would not be replaced.
+    auto lambdaTy = builder.GetType<FuncType>(std::vector<Type*>{}, int64Ty);
+    auto lambda = CreateAndAppendExpression<Lambda>(builder, lambdaTy, lambdaTy, entry, true, "g", "g");
+    auto lambdaBody = builder.CreateBlockGroup(*func);
+    lambda->InitBody(*lambdaBody);
+    auto lambdaEntry = builder.CreateBlock(lambdaBody);
+    lambdaBody->SetEntryBlock(lambdaEntry);
+    auto lambdaRet = CreateAlloc(int64Ty, lambdaEntry);
+    lambda->SetReturnValue(*Cangjie::StaticCast<LocalVar*>(lambdaRet));
+    auto ref = CreateAndAppendExpression<GetElementRef>(
+        builder, builder.GetType<RefType>(int64Ty), pair, std::vector<uint64_t>{0}, lambdaEntry);
+    auto value = CreateAndAppendExpression<Load>(builder, int64Ty, ref->GetResult(), lambdaEntry);
+    CreateAndAppendExpression<Store>(builder, unitTy, value->GetResult(), lambdaRet, lambdaEntry);
+    lambdaEntry->AppendExpression(builder.CreateTerminator<Exit>(lambdaEntry));
+    Return(func->GetParam(1));
+
+    EXPECT_EQ(Run(), 0);
+    EXPECT_EQ(ref->GetOperand(0), pair);
+}
+
+TEST_F(ScalarReplacementOfAggregatesTest, KeepsAggregateWhoseElementIsPassedToCall)
+{
+    auto refTy = builder.GetType<RefType>(int64Ty);
+    auto readFunc = CreateFunc("read", {refTy}, unitTy);
+    auto readEntry = readFunc->GetEntryBlock();
+    CreateAndAppendExpression<Load>(builder, int64Ty, readFunc->GetParam(0), readEntry);
+    readEntry->AppendExpression(builder.CreateTerminator<Exit>(readEntry));
+
+    auto pair = CreateAlloc(pairTy, entry);
+    auto ref = CreateAndAppendExpression<GetElementRef>(builder, refTy, pair, std::vector<uint64_t>{0}, entry);
+    CreateAndAppendExpression<Apply>(builder, unitTy, readFunc, FuncCallContext{.args = {ref->GetResult()}}, entry);
+    Return(func->GetParam(0));
+
+    EXPECT_EQ(Run(), 0);
+}
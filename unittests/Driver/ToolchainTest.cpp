@@ -6,8 +6,13 @@
 
 // The Cangjie API is in Beta. For details on its capabilities and limitations, please refer to the README file.
 
+#include <algorithm>
+
 #include "gtest/gtest.h"
 #include "cangjie/Driver/Backend/Backend.h"
+#ifdef CANGJIE_CODEGEN_CJNATIVE_BACKEND
+#include "cangjie/Driver/Backend/CJNATIVEBackend.h"
+#endif
 
 using namespace Cangjie;
 
@@ -21,3 +26,25 @@ protected:
 TEST_F(ToolchainTest, Init)
 {
 }
+
+#ifdef CANGJIE_CODEGEN_CJNATIVE_BACKEND
+TEST_F(ToolchainTest, PrepareInProcessBackend)
+{
+    DriverOptions options;
+    CJNATIVEBackend::PrepareInProcessBackend(options);
+    EXPECT_TRUE(options.inProcessBackendArgs.empty());
+
+    options.inProcessBackend = true;
+    CJNATIVEBackend::PrepareInProcessBackend(options);
+    auto& args = options.inProcessBackendArgs;
+    ASSERT_FALSE(args.empty());
+    EXPECT_EQ(args.front().rfind("-passes=", 0), 0);
+    // Options shared by 'opt' and 'llc' are given once.
+    EXPECT_EQ(std::count(args.begin(), args.end(), "--cangjie-pipeline"), 1);
+
+    // The intermediate files of 'opt' and 'llc' are requested, so they have to run.
+    options.saveTemps = true;
+    CJNATIVEBackend::PrepareInProcessBackend(options);
+    EXPECT_TRUE(options.inProcessBackendArgs.empty());
+}
+#endif
@@ -937,3 +937,35 @@ TEST_F(LexerTest, PrintAsciiControlCode)
     EXPECT_EQ(splits[3].substr(30, 8), "\\u{000D}");
     EXPECT_EQ(splits[3].substr(38, 4), "\x1b[0m");
 }
+
+TEST_F(LexerTest, LongCommentsAndStrings)
+{
+    // The runs of plain ASCII are longer than the blocks skipped at once, and stops are placed at block boundaries.
+    std::string str = "// a line comment which is longer than sixteen bytes, 中文 and more text\n"
+                      "/* block comment /* nested comment over sixteen bytes */\n still in the comment */ x\n"
+                      "\"a string literal longer than sixteen bytes \\n with ${y} and 中文 at the end\"\n"
+                      "\"\"\"\n    multi-line string over sixteen bytes\n    with ${z} inside\"\"\" w";
+    auto fileID = sm.AddSource("test", str);
+    Lexer lexer(fileID, str, diag, sm);
+    std::vector<Token> tokens;
+    for (Token tok = lexer.Next(); tok.kind != TokenKind::END; tok = lexer.Next()) {
+        if (tok.kind != TokenKind::NL) {
+            tokens.emplace_back(tok);
+        }
+    }
+    ASSERT_EQ(tokens.size(), 6);
+    EXPECT_EQ(tokens[0].kind, TokenKind::COMMENT);
+    EXPECT_EQ(tokens[0].Value(), "// a line comment which is longer than sixteen bytes, 中文 and more text");
+    EXPECT_EQ(tokens[1].kind, TokenKind::COMMENT);
+    EXPECT_EQ(tokens[1].End(), Position(fileID, 3, 25));
+    EXPECT_EQ(tokens[2].Value(), "x");
+    EXPECT_EQ(tokens[2].Begin(), Position(fileID, 3, 26));
+    EXPECT_EQ(tokens[3].kind, TokenKind::STRING_LITERAL);
+    EXPECT_EQ(tokens[3].Value(), "a string literal longer than sixteen bytes \\n with ${y} and 中文 at the end");
+    EXPECT_EQ(lexer.GetStrParts(tokens[3]).size(), 3);
+    EXPECT_EQ(tokens[4].kind, TokenKind::MULTILINE_STRING);
+    EXPECT_EQ(tokens[4].Value(), "    multi-line string over sixteen bytes\n    with ${z} inside");
+    EXPECT_EQ(tokens[5].Value(), "w");
+    EXPECT_EQ(tokens[5].Begin(), Position(fileID, 7, 25));
+    EXPECT_EQ(diag.GetErrorCount(), 0);
+}
@@ -26,6 +26,7 @@
 #include "cangjie/AST/Walker.h"
 #include "cangjie/IncrementalCompilation/IncrementalScopeAnalysis.h"
 #include "cangjie/Modules/ASTSerialization.h"
+#include "cangjie/Modules/SharedCjoCache.h"
 #include "cangjie/Utils/FileUtil.h"
 
 using namespace Cangjie;
@@ -1260,3 +1261,35 @@ TEST_F(PackageTest, ImportOptFlag)
         depPkgs.begin(), depPkgs.end(), [](Ptr<PackageDecl>& pkg) { return pkg->GetFullPackageName() == "b"; });
     EXPECT_EQ(found, depPkgs.end());
 }
+
+TEST_F(PackageTest, SharedCjoCacheReuseAndInvalidate)
+{
+    auto& cache = SharedCjoCache::Get();
+    std::string cjoFile = "testTempFiles/shared.cjo";
+    ASSERT_TRUE(FileUtil::WriteBufferToASTFile(cjoFile, {1, 2, 3}));
+    std::string failedReason;
+    auto first = cache.Load(cjoFile, failedReason);
+    ASSERT_NE(first, nullptr);
+    EXPECT_TRUE(failedReason.empty());
+    // An unchanged file is shared while it is in use.
+    auto second = cache.Load(cjoFile, failedReason);
+    EXPECT_EQ(first.get(), second.get());
+
+    // A rebuilt file is read again.
+    ASSERT_TRUE(FileUtil::WriteBufferToASTFile(cjoFile, {1, 2, 3, 4}));
+    auto third = cache.Load(cjoFile, failedReason);
+    ASSERT_NE(third, nullptr);
+    EXPECT_NE(third.get(), first.get());
+    EXPECT_EQ(third->Size(), 4);
+    EXPECT_EQ(first->Size(), 3);
+
+    // The contents are released with the last user.
+    std::weak_ptr<const Utils::ReadOnlyBuffer> weak = third;
+    first.reset();
+    second.reset();
+    third.reset();
+    EXPECT_TRUE(weak.expired());
+    auto reloaded = cache.Load(cjoFile, failedReason);
+    ASSERT_NE(reloaded, nullptr);
+    EXPECT_EQ(reloaded->Size(), 4);
+}
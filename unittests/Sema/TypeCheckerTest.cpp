@@ -362,3 +362,55 @@ TEST_F(TypeCheckerTest, DISABLED_SpawnTest)
     EXPECT_TRUE(ty1->typeArgs.size() == 1);
     EXPECT_TRUE(ty1->typeArgs[0]->kind == TypeKind::TYPE_INT64);
 }
+
+TEST_F(TypeCheckerTest, PathologicalMatchExhaustiveness)
+{
+    // Regression test for the usefulness checking on wide tuples, enums with many constructors and long or-patterns,
+    // which used to copy every pattern column at each specialization step. Only the diagnostics are checked here.
+    constexpr size_t numCtors = 64;
+    constexpr size_t numBools = 12;
+    std::string code = "enum E {\n";
+    for (size_t i = 0; i < numCtors; ++i) {
+        code += "    | C" + std::to_string(i) + "(Int64, Bool)\n";
+    }
+    code += "}\n\nfunc f(e: E, x: E) {\n    match ((e, x)) {\n";
+    for (size_t i = 0; i < numCtors; ++i) {
+        code += "        case (C" + std::to_string(i) + "(_, true), _) => 0\n";
+    }
+    code += "        case (_, C0(_, _)) | (_, C1(_, _)) | (_, C2(_, _)) => 1\n        case (_, _) => 2\n    }\n}\n\n";
+    // Every case covers the tuples whose first true element is at the index of the case, except all false.
+    code += "func g(";
+    for (size_t i = 0; i < numBools; ++i) {
+        code += std::string(i == 0 ? "" : ", ") + "b" + std::to_string(i) + ": Bool";
+    }
+    code += ") {\n    match ((";
+    for (size_t i = 0; i < numBools; ++i) {
+        code += std::string(i == 0 ? "" : ", ") + "b" + std::to_string(i);
+    }
+    code += ")) {\n";
+    for (size_t i = 0; i < numBools; ++i) {
+        code += "        case (";
+        for (size_t j = 0; j < numBools; ++j) {
+            code += std::string(j == 0 ? "" : ", ") + (j < i ? "false" : (j == i ? "true" : "_"));
+        }
+        code += ") => 0\n";
+    }
+    code += "    }\n}\n";
+
+    instance->code = code;
+    // The code only uses builtin types, so the result must not depend on whether std.core is available.
+    instance->invocation.globalOptions.implicitPrelude = false;
+    instance->Compile(CompileStage::SEMA);
+
+    // Only the match in `g` is non-exhaustive, (false, ..., false) is not covered.
+    EXPECT_EQ(diag.GetErrorCount(), 1);
+    size_t unreachableCases = 0;
+    Walker walker(instance->GetSourcePackages()[0]->files[0].get(), [&unreachableCases](Ptr<Node> node) {
+        if (node->astKind == ASTKind::MATCH_CASE && node->TestAttr(Attribute::UNREACHABLE)) {
+            ++unreachableCases;
+        }
+        return VisitAction::WALK_CHILDREN;
+    });
+    walker.Walk();
+    EXPECT_EQ(unreachableCases, 0);
+}
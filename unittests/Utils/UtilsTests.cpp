@@ -6,17 +6,23 @@
 
 // The Cangjie API is in Beta. For details on its capabilities and limitations, please refer to the README file.
 
+#include <algorithm>
 #include <fstream>
 #include <atomic>
 #include <chrono>
 #include <cstdlib>
+#include <ctime>
 #include <sstream>
 #include <string>
+#include <thread>
 #ifdef _WIN32
 #include <process.h>
+#include <sys/utime.h>
 #include <windows.h>
 #else
+#include <sys/stat.h>
 #include <unistd.h>
+#include <utime.h>
 #endif
 
 #include "gtest/gtest.h"
@@ -26,8 +32,11 @@
 #include "cangjie/Driver/Toolchains/GCCPathScanner.h"
 #include "cangjie/Utils/FileUtil.h"
 #include "cangjie/Utils/FloatFormat.h"
+#include "cangjie/Utils/PersistentCache.h"
 #include "cangjie/Utils/ProfileRecorder.h"
+#include "cangjie/Utils/ReadOnlyBuffer.h"
 #include "cangjie/Utils/SipHash.h"
+#include "cangjie/Utils/TaskQueue.h"
 #include "cangjie/Utils/Utils.h"
 
 using namespace Cangjie;
@@ -681,6 +690,146 @@ TEST(UtilsTest, ReadBinaryFileToBuffer)
     std::remove(filePath.c_str());
 }
 
+TEST(UtilsTest, ReadOnlyBufferFromFile)
+{
+    std::string failedReason;
+    EXPECT_EQ(ReadOnlyBuffer::FromFile("./no_such_file.txt", failedReason), nullptr);
+    EXPECT_EQ("open file failed", failedReason);
+
+    std::string filePath = MakeTempPath("read_only_buffer");
+    std::vector<uint8_t> content{0xCA, 0xFE, 0xBA, 0xBE, 0x00, 0x01};
+    ASSERT_TRUE(WriteBufferToASTFile(filePath, content));
+    auto buffer = ReadOnlyBuffer::FromFile(filePath, failedReason);
+    ASSERT_NE(buffer, nullptr);
+    EXPECT_TRUE(failedReason.empty());
+    ASSERT_EQ(buffer->Size(), content.size());
+    EXPECT_TRUE(std::equal(content.begin(), content.end(), buffer->Data()));
+
+    // Rewriting the file must not change what an existing reader sees.
+    ASSERT_TRUE(WriteBufferToASTFile(filePath, {1}));
+    EXPECT_TRUE(std::equal(content.begin(), content.end(), buffer->Data()));
+    std::remove(filePath.c_str());
+    EXPECT_TRUE(std::equal(content.begin(), content.end(), buffer->Data()));
+}
+
+TEST(UtilsTest, WriteBufferToASTFileConcurrently)
+{
+    // Threads of one process writing the same file must not share a temporary file.
+    constexpr size_t threadsNum = 8;
+    std::string filePath = MakeTempPath("concurrent_ast_file");
+    std::vector<std::thread> threads;
+    std::atomic<size_t> succeeded{0};
+    for (size_t i = 0; i < threadsNum; ++i) {
+        threads.emplace_back([&filePath, &succeeded, i]() {
+            std::vector<uint8_t> content(4096, static_cast<uint8_t>(i));
+            for (size_t round = 0; round < 16; ++round) {
+                succeeded += WriteBufferToASTFile(filePath, content) ? 1 : 0;
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(succeeded.load(), threadsNum * 16);
+    std::vector<uint8_t> result;
+    std::string failedReason;
+    ASSERT_TRUE(ReadBinaryFileToBuffer(filePath, result, failedReason));
+    ASSERT_EQ(result.size(), 4096);
+    EXPECT_TRUE(std::all_of(result.begin(), result.end(), [&result](uint8_t byte) { return byte == result[0]; }));
+    std::remove(filePath.c_str());
+}
+
+#ifndef _WIN32
+TEST(UtilsTest, WriteBufferToASTFileThroughSymlink)
+{
+    std::string targetPath = MakeTempPath("ast_file_link_target");
+    std::string linkPath = MakeTempPath("ast_file_link");
+    ASSERT_TRUE(WriteBufferToASTFile(targetPath, {1}));
+    ASSERT_EQ(symlink(targetPath.c_str(), linkPath.c_str()), 0);
+    ASSERT_TRUE(WriteBufferToASTFile(linkPath, {2, 3}));
+    struct stat st {};
+    ASSERT_EQ(lstat(linkPath.c_str(), &st), 0);
+    EXPECT_TRUE(S_ISLNK(st.st_mode));
+    std::vector<uint8_t> result;
+    std::string failedReason;
+    ASSERT_TRUE(ReadBinaryFileToBuffer(targetPath, result, failedReason));
+    EXPECT_EQ(result, (std::vector<uint8_t>{2, 3}));
+    std::remove(linkPath.c_str());
+    std::remove(targetPath.c_str());
+}
+
+TEST(UtilsTest, ReadOnlyBufferTruncatedWhileMapped)
+{
+    std::string filePath = MakeTempPath("truncated_mapping");
+    std::vector<uint8_t> content(1 << 16, 0x5A);
+    ASSERT_TRUE(WriteBufferToASTFile(filePath, content));
+    std::string failedReason;
+    auto buffer = ReadOnlyBuffer::FromFile(filePath, failedReason);
+    ASSERT_NE(buffer, nullptr);
+    if (!buffer->IsMapped()) {
+        GTEST_SKIP() << "the file is not mapped";
+    }
+    // Another program truncating the file turns reading the lost pages into a read error, not a crash.
+    EXPECT_EXIT(
+        {
+            (void)truncate(filePath.c_str(), 0);
+            volatile uint8_t last = buffer->Data()[buffer->Size() - 1];
+            (void)last;
+        },
+        ::testing::ExitedWithCode(EXIT_FAILURE), "file truncated while being read");
+    buffer.reset();
+    std::remove(filePath.c_str());
+}
+#endif
+
+TEST(UtilsTest, PersistentCache)
+{
+    std::string cacheDir = MakeTempPath("persistent_cache");
+    std::string filePath = MakeTempPath("persistent_cache_object");
+    std::vector<uint8_t> content(100, 0x5A);
+    ASSERT_TRUE(WriteBufferToASTFile(filePath, content));
+
+    EXPECT_EQ(PersistentCache::HashToKey(0x1234abcdULL), "000000001234abcd");
+    // Capacity for two entries.
+    PersistentCache cache(cacheDir, content.size() * 2 + 16);
+    std::vector<uint8_t> data;
+    std::string metadata;
+    EXPECT_FALSE(cache.Lookup("a", data, metadata));
+    ASSERT_TRUE(cache.Store("a", filePath, "sym1\nsym2"));
+    ASSERT_TRUE(cache.Store("b", filePath, ""));
+    ASSERT_TRUE(cache.Lookup("a", data, metadata));
+    EXPECT_EQ(data, content);
+    EXPECT_EQ(metadata, "sym1\nsym2");
+
+    // Another cache in the same directory, e.g. in another process, sees the entries.
+    PersistentCache other(cacheDir, content.size() * 2 + 16);
+    ASSERT_TRUE(other.Lookup("b", data, metadata));
+    EXPECT_TRUE(metadata.empty());
+
+    // Make "a" the least recently used entry, then exceed the capacity.
+    std::string oldEntry = JoinPath(cacheDir, "a.entry");
+#ifdef _WIN32
+    struct _utimbuf oldTime {1, 1};
+    ASSERT_EQ(_utime(oldEntry.c_str(), &oldTime), 0);
+#else
+    struct utimbuf oldTime {1, 1};
+    ASSERT_EQ(utime(oldEntry.c_str(), &oldTime), 0);
+#endif
+    ASSERT_TRUE(cache.Store("c", filePath, ""));
+    cache.Trim();
+    EXPECT_FALSE(cache.Lookup("a", data, metadata));
+    EXPECT_TRUE(cache.Lookup("b", data, metadata));
+    EXPECT_TRUE(cache.Lookup("c", data, metadata));
+
+    auto stats = cache.GetStats();
+    EXPECT_EQ(stats.hits, 3);
+    EXPECT_EQ(stats.misses, 2);
+    EXPECT_EQ(stats.stores, 3);
+    EXPECT_EQ(stats.evictions, 1);
+    std::remove(filePath.c_str());
+    RemoveDirectoryRecursively(cacheDir);
+}
+
 TEST(UtilsTest, ReadFileContent)
 {
     std::string filePath = "./no_such_file.txt";
@@ -981,3 +1130,155 @@ TEST(UtilsTest, IsUnderFlowFloat)
     // This should not occur in actual calls.
     EXPECT_EQ(underUse("1.0"), false);
 }
+
+TEST(UtilsTest, TaskQueuePriority)
+{
+    // With one runner, the calling thread executes the tasks strictly by priority.
+    TaskQueue taskQueue(1);
+    std::vector<uint64_t> order;
+    for (uint64_t priority : {3U, 9U, 1U, 5U}) {
+        taskQueue.AddTask<void>([&order, priority]() { order.emplace_back(priority); }, priority);
+    }
+    taskQueue.RunAndWaitForAllTasksCompleted();
+    EXPECT_EQ(order, (std::vector<uint64_t>{9U, 5U, 3U, 1U}));
+}
+
+TEST(UtilsTest, TaskQueueResultsAndConcurrencyLimit)
+{
+    constexpr size_t tasksNum = 1000;
+    constexpr size_t limit = 3;
+    TaskQueue taskQueue(limit);
+    std::atomic<size_t> running{0};
+    std::atomic<size_t> maxRunning{0};
+    std::vector<TaskResult<size_t>> results;
+    for (size_t i = 0; i < tasksNum; ++i) {
+        results.emplace_back(taskQueue.AddTask<size_t>([i, &running, &maxRunning]() {
+            auto cur = ++running;
+            auto seen = maxRunning.load();
+            while (cur > seen && !maxRunning.compare_exchange_weak(seen, cur)) {
+            }
+            --running;
+            return i * i;
+        }));
+    }
+    taskQueue.RunAndWaitForAllTasksCompleted();
+    for (size_t i = 0; i < tasksNum; ++i) {
+        EXPECT_EQ(results[i].get(), i * i);
+    }
+    EXPECT_LE(maxRunning.load(), limit);
+}
+
+TEST(UtilsTest, TaskQueueNestedAndDynamicTasks)
+{
+    // Tasks may wait for inner queues and add new tasks to their own queue without deadlocking the pool.
+    constexpr size_t outerNum = 64;
+    constexpr size_t innerNum = 16;
+    std::atomic<size_t> counter{0};
+    TaskQueue outer(ThreadPool::Get().GetWorkersNum());
+    for (size_t i = 0; i < outerNum; ++i) {
+        outer.AddTask<void>([&counter, &outer]() {
+            TaskQueue inner(innerNum);
+            for (size_t j = 0; j < innerNum; ++j) {
+                inner.AddTask<void>([&counter]() { ++counter; });
+            }
+            inner.RunAndWaitForAllTasksCompleted();
+            outer.AddTask<void>([&counter]() { ++counter; });
+        });
+    }
+    outer.RunAndWaitForAllTasksCompleted();
+    EXPECT_EQ(counter.load(), outerNum * innerNum + outerNum);
+}
+
+TEST(UtilsTest, TaskQueueRunInBackground)
+{
+    TaskQueue taskQueue(2);
+    std::atomic<size_t> counter{0};
+    for (size_t i = 0; i < 100; ++i) {
+        taskQueue.AddTask<void>([&counter]() { ++counter; });
+    }
+    taskQueue.RunInBackground();
+    taskQueue.WaitForAllTasksCompleted();
+    EXPECT_EQ(counter.load(), 100U);
+}
+
+namespace {
+/** CPU time consumed by the calling thread only, unlike `std::clock`, which sums over all threads of the process. */
+int64_t ThreadCpuMicroseconds()
+{
+#ifdef _WIN32
+    FILETIME creation;
+    FILETIME exit;
+    FILETIME kernel;
+    FILETIME user;
+    GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user);
+    auto toUs = [](const FILETIME& t) {
+        return static_cast<int64_t>((static_cast<uint64_t>(t.dwHighDateTime) << 32U) | t.dwLowDateTime) / 10;
+    };
+    return toUs(kernel) + toUs(user);
+#else
+    timespec ts{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+#endif
+}
+} // namespace
+
+TEST(UtilsTest, TaskQueueWaitingWorkerParks)
+{
+    if (ThreadPool::Get().GetWorkersNum() < 2) {
+        GTEST_SKIP() << "needs a second worker to wait on";
+    }
+    // The inner task is already running on a worker, so the outer task waiting for it has nothing to help with and
+    // must park instead of spinning.
+    std::atomic<bool> started{false};
+    TaskQueue inner(1);
+    inner.AddTask<void>([&started]() {
+        started = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    });
+    inner.RunInBackground();
+    while (!started) {
+        std::this_thread::yield();
+    }
+    TaskQueue outer(1);
+    int64_t cpuUs = 0;
+    outer.AddTask<void>([&inner, &cpuUs]() {
+        auto cpuStart = ThreadCpuMicroseconds();
+        inner.WaitForAllTasksCompleted();
+        cpuUs = ThreadCpuMicroseconds() - cpuStart;
+    });
+    outer.RunInBackground();
+    outer.WaitForAllTasksCompleted();
+    // Spinning would burn most of the 100ms the inner task sleeps on the waiting thread itself.
+    EXPECT_LT(cpuUs, 50000);
+}
+
+// Scaling benchmark of the work-stealing scheduler: a fixed amount of CPU-bound work is run with 1 to N concurrent
+// runners. The times are only recorded as test properties (see `--gtest_output=xml`): wall-clock speedups depend on
+// the load and core count of the host, so they are not asserted here.
+TEST(UtilsTest, TaskQueueScaling)
+{
+    constexpr size_t tasksNum = 1024;
+    constexpr size_t workPerTask = 20000;
+    std::atomic<size_t> done{0};
+    auto work = [&done]() {
+        volatile uint64_t acc = 0;
+        for (size_t i = 0; i < workPerTask; ++i) {
+            acc = acc * 31U + i;
+        }
+        ++done;
+    };
+    size_t maxThreads = ThreadPool::Get().GetWorkersNum() + 1;
+    for (size_t threadsNum = 1; threadsNum <= maxThreads; threadsNum *= 2) {
+        done = 0;
+        TaskQueue taskQueue(threadsNum);
+        for (size_t i = 0; i < tasksNum; ++i) {
+            taskQueue.AddTask<void>(work, i % 8U);
+        }
+        auto start = std::chrono::steady_clock::now();
+        taskQueue.RunAndWaitForAllTasksCompleted();
+        auto us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+        EXPECT_EQ(done.load(), tasksNum);
+        RecordProperty("us_with_" + std::to_string(threadsNum) + "_threads", std::to_string(us.count()));
+    }
+}